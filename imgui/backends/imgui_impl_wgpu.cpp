@@ -6,7 +6,10 @@
 //  [X] Renderer: User texture binding. Use 'WGPUTextureView' as ImTextureID. Read the FAQ about ImTextureID/ImTextureRef!
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
-//  [X] Renderer: Texture updates support for dynamic font system (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Texture updates support for dynamic font system (ImGuiBackendFlags_RendererHasTextures). ImTextureFormat_RGBA32 and ImTextureFormat_Alpha8 (R8Unorm) textures.
+//  [X] Renderer: Texture updates upload the individual ImTextureData::Updates[] regions with tightly packed rows, merging them only when cheaper.
+//  [X] Renderer: Paged textures grown without re-upload (ImGuiBackendFlags_RendererHasTexturePages with IMGUI_ENABLE_PAGED_ATLAS), stored as texture_2d_array.
+//  [X] Renderer: Distance field glyphs (ImGuiBackendFlags_RendererHasDistanceFields with IMGUI_ENABLE_SDF_FONTS), vertices with U >= 2 are shaded from the distance in the texel alpha.
 
 // Read imgui_impl_wgpu.h about how to use the IMGUI_IMPL_WEBGPU_BACKEND_WGPU or IMGUI_IMPL_WEBGPU_BACKEND_DAWN flags.
 
@@ -53,6 +56,8 @@
 #include "imgui_impl_wgpu.h"
 #include <limits.h>
 #include <stdio.h>
+#include <stdlib.h>     // qsort
+#include <string.h>     // memcpy
 
 // One of IMGUI_IMPL_WEBGPU_BACKEND_DAWN or IMGUI_IMPL_WEBGPU_BACKEND_WGPU must be provided. See imgui_impl_wgpu.h for more details.
 #if defined(IMGUI_IMPL_WEBGPU_BACKEND_DAWN) == defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU)
@@ -75,11 +80,18 @@ using WGPUProgrammableStageDescriptor = WGPUComputeState;
 extern ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed);
 #define MEMALIGN(_SIZE,_ALIGN)        (((_SIZE) + ((_ALIGN) - 1)) & ~((_ALIGN) - 1))    // Memory align (copied from IM_ALIGN() macro).
 
+// What a wgpuQueueWriteTexture() call is worth in bytes: two texture update regions are uploaded as their bounding box when the pixels
+// in between cost less than the extra call.
+#ifndef IMGUI_IMPL_WEBGPU_TEXTURE_WRITE_COST
+#define IMGUI_IMPL_WEBGPU_TEXTURE_WRITE_COST    4096
+#endif
+
 // WebGPU data
 struct ImGui_ImplWGPU_Texture
 {
     WGPUTexture         Texture = nullptr;
     WGPUTextureView     TextureView = nullptr;
+    uint32_t            Layers = 1;                     // Array layers, one per page of a paged texture
 };
 
 struct RenderResources
@@ -89,6 +101,36 @@ struct RenderResources
     WGPUBindGroup       CommonBindGroup = nullptr;      // Resources bind-group to bind the common resources to pipeline
     ImGuiStorage        ImageBindGroups;                // Resources bind-group to bind the font/image resources to pipeline (this is a key->value map)
     WGPUBindGroupLayout ImageBindGroupLayout = nullptr; // Cache layout used for the image bind group. Avoids allocating unnecessary JS objects when working with WebASM
+    WGPUBindGroupLayout ImagePagedBindGroupLayout = nullptr; // Same for paged textures (texture_2d_array)
+};
+
+// Compact vertices: 16-bit fixed point positions relative to the clip origin (draw_data->DisplayPos), 16-bit normalized UVs and the same RGBA8 color.
+// U uses 15 bits, the top bit tells distance field glyphs (U in [2,3], see ImGuiBackendFlags_RendererHasDistanceFields) apart.
+// A draw list falls back to ImDrawVert when one of its positions is out of the fixed point range or one of its UVs is outside of [0,1] (or [2,3] for U).
+#define IMGUI_IMPL_WGPU_COMPACT_POS_SCALE   8.0f    // 1/8 pixel steps, [-4096,+4096) pixels around the clip origin
+struct ImGui_ImplWGPU_CompactVert
+{
+    ImS16       pos[2];
+    ImU16       uv[2];
+    ImU32       col;
+};
+static_assert(sizeof(ImGui_ImplWGPU_CompactVert) == 12, "");
+
+// Pipeline variants, ImGui_ImplWGPU_Data::pipelineStates[] is indexed by a combination of these
+enum ImGui_ImplWGPU_PipelineFlags_
+{
+    ImGui_ImplWGPU_PipelineFlags_CompactVertices    = 1 << 0,   // ImGui_ImplWGPU_CompactVert vertices
+    ImGui_ImplWGPU_PipelineFlags_Alpha8             = 1 << 1,   // Single channel texture (ImTextureFormat_Alpha8), sampled as white with alpha
+    ImGui_ImplWGPU_PipelineFlags_Paged              = 1 << 2,   // Paged texture (ImTextureData::PageHeight), texture_2d_array with the page index in the integer part of V
+    ImGui_ImplWGPU_PipelineFlags_COUNT              = 1 << 3,
+};
+
+// Where the vertices of a draw list are in the vertex buffer, and in which format
+struct VertexRange
+{
+    uint64_t    Offset;
+    uint64_t    Size;
+    bool        Compact;
 };
 
 struct FrameResources
@@ -105,6 +147,8 @@ struct Uniforms
 {
     float MVP[4][4];
     float Gamma;
+    float CompactPosScale;
+    float CompactPosOrigin[2];
 };
 
 struct ImGui_ImplWGPU_Data
@@ -114,12 +158,20 @@ struct ImGui_ImplWGPU_Data
     WGPUQueue               defaultQueue = nullptr;
     WGPUTextureFormat       renderTargetFormat = WGPUTextureFormat_Undefined;
     WGPUTextureFormat       depthStencilFormat = WGPUTextureFormat_Undefined;
-    WGPURenderPipeline      pipelineState = nullptr;
+    WGPURenderPipeline      pipelineStates[ImGui_ImplWGPU_PipelineFlags_COUNT] = {};   // Same state for each ImGui_ImplWGPU_PipelineFlags_ combination
 
     RenderResources         renderResources;
     FrameResources*         pFrameResources = nullptr;
     unsigned int            numFramesInFlight = 0;
     unsigned int            frameIndex = UINT_MAX;
+    uint64_t                uploadBytes = 0;    // running total of the bytes written with wgpuQueueWrite*, for stats
+    uint64_t                textureUploadBytes = 0;     // running total of the texture bytes written, for stats
+    uint64_t                textureUpdateBytes = 0;     // running total of the texture bytes requested by ImTextureData::Updates[] (or created), for stats
+    uint64_t                textureWriteCount = 0;      // running total of wgpuQueueWriteTexture() calls, for stats
+    ImVector<ImTextureRect> textureRegions;             // regions of the texture being updated, one page each
+    ImVector<unsigned char> textureStaging;             // tightly packed rows of the region being written, when initInfo.TransientAllocFunc doesn't provide them
+    int                     compactVtxCount = 0;    // vertices of the last frame uploaded as ImGui_ImplWGPU_CompactVert, for stats
+    ImVector<VertexRange>   vertexRanges;           // per draw list of the current frame, with CompactVertices
 };
 
 // Backend data stored in io.BackendRendererUserData to allow support for multiple Dear ImGui contexts
@@ -133,6 +185,8 @@ static ImGui_ImplWGPU_Data* ImGui_ImplWGPU_GetBackendData()
 // SHADERS
 //-----------------------------------------------------------------------------
 
+// Distance field glyphs have U offset by 2.0 (ImGuiBackendFlags_RendererHasDistanceFields). The vertex shaders remove the offset and pass
+// it to the fragment shader as the flat 'sdf' flag, where the sampled alpha is a distance (0.5 on the edge) turned into coverage.
 static const char __shader_vert_wgsl[] = R"(
 struct VertexInput {
     @location(0) position: vec2<f32>,
@@ -144,6 +198,7 @@ struct VertexOutput {
     @builtin(position) position: vec4<f32>,
     @location(0) color: vec4<f32>,
     @location(1) uv: vec2<f32>,
+    @location(2) @interpolate(flat) sdf: u32,
 };
 
 struct Uniforms {
@@ -158,16 +213,57 @@ fn main(in: VertexInput) -> VertexOutput {
     var out: VertexOutput;
     out.position = uniforms.mvp * vec4<f32>(in.position, 0.0, 1.0);
     out.color = in.color;
-    out.uv = in.uv;
+    let sdf = in.uv.x >= 2.0;
+    out.uv = vec2<f32>(select(in.uv.x, in.uv.x - 2.0, sdf), in.uv.y);
+    out.sdf = select(0u, 1u, sdf);
     return out;
 }
 )";
 
-static const char __shader_frag_wgsl[] = R"(
+static const char __shader_vert_compact_wgsl[] = R"(
+struct VertexInput {
+    @location(0) position: vec2<i32>,
+    @location(1) uv: vec2<u32>,
+    @location(2) color: vec4<f32>,
+};
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) color: vec4<f32>,
+    @location(1) uv: vec2<f32>,
+    @location(2) @interpolate(flat) sdf: u32,
+};
+
+struct Uniforms {
+    mvp: mat4x4<f32>,
+    gamma: f32,
+    compact_pos_scale: f32,
+    compact_pos_origin: vec2<f32>,
+};
+
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+
+@vertex
+fn main(in: VertexInput) -> VertexOutput {
+    var out: VertexOutput;
+    let position = vec2<f32>(in.position) * uniforms.compact_pos_scale + uniforms.compact_pos_origin;
+    out.position = uniforms.mvp * vec4<f32>(position, 0.0, 1.0);
+    out.color = in.color;
+    out.uv = vec2<f32>(f32(in.uv.x & 0x7FFFu) / 32767.0, f32(in.uv.y) / 65535.0);
+    out.sdf = in.uv.x >> 15u;
+    return out;
+}
+)";
+
+// Fragment shaders: one of the texture bindings below with its sample_texel() (white with alpha for single channel textures), followed by
+// this common part (see ImGui_ImplWGPU_CreateFragmentShaderModule()).
+// (textureSample() and fwidth() need uniform control flow: both coverages are evaluated and select()-ed.)
+static const char __shader_frag_common_wgsl[] = R"(
 struct VertexOutput {
     @builtin(position) position: vec4<f32>,
     @location(0) color: vec4<f32>,
     @location(1) uv: vec2<f32>,
+    @location(2) @interpolate(flat) sdf: u32,
 };
 
 struct Uniforms {
@@ -177,16 +273,55 @@ struct Uniforms {
 
 @group(0) @binding(0) var<uniform> uniforms: Uniforms;
 @group(0) @binding(1) var s: sampler;
-@group(1) @binding(0) var t: texture_2d<f32>;
+
+fn sdf_coverage(d: f32) -> f32 {
+    return clamp((d - 0.5) / max(fwidth(d), 1e-4) + 0.5, 0.0, 1.0);
+}
 
 @fragment
 fn main(in: VertexOutput) -> @location(0) vec4<f32> {
-    let color = in.color * textureSample(t, s, in.uv);
+    let texel = sample_texel(in.uv);
+    let color = in.color * vec4<f32>(texel.rgb, select(texel.a, sdf_coverage(texel.a), in.sdf != 0u));
     let corrected_color = pow(color.rgb, vec3<f32>(uniforms.gamma));
     return vec4<f32>(corrected_color, color.a);
 }
 )";
 
+static const char __shader_frag_wgsl[] = R"(
+@group(1) @binding(0) var t: texture_2d<f32>;
+
+fn sample_texel(uv: vec2<f32>) -> vec4<f32> {
+    return textureSample(t, s, uv);
+}
+)";
+
+static const char __shader_frag_alpha8_wgsl[] = R"(
+@group(1) @binding(0) var t: texture_2d<f32>;
+
+fn sample_texel(uv: vec2<f32>) -> vec4<f32> {
+    return vec4<f32>(1.0, 1.0, 1.0, textureSample(t, s, uv).r);
+}
+)";
+
+// Paged textures: V is in page units, its integer part selects the array layer
+static const char __shader_frag_paged_wgsl[] = R"(
+@group(1) @binding(0) var t: texture_2d_array<f32>;
+
+fn sample_texel(uv: vec2<f32>) -> vec4<f32> {
+    let page = clamp(floor(uv.y), 0.0, f32(textureNumLayers(t)) - 1.0);
+    return textureSample(t, s, vec2<f32>(uv.x, uv.y - page), i32(page));
+}
+)";
+
+static const char __shader_frag_paged_alpha8_wgsl[] = R"(
+@group(1) @binding(0) var t: texture_2d_array<f32>;
+
+fn sample_texel(uv: vec2<f32>) -> vec4<f32> {
+    let page = clamp(floor(uv.y), 0.0, f32(textureNumLayers(t)) - 1.0);
+    return vec4<f32>(1.0, 1.0, 1.0, textureSample(t, s, vec2<f32>(uv.x, uv.y - page), i32(page)).r);
+}
+)";
+
 static void SafeRelease(ImDrawIdx*& res)
 {
     if (res)
@@ -247,6 +382,7 @@ static void SafeRelease(RenderResources& res)
     SafeRelease(res.Uniforms);
     SafeRelease(res.CommonBindGroup);
     SafeRelease(res.ImageBindGroupLayout);
+    SafeRelease(res.ImagePagedBindGroupLayout);
 };
 
 static void SafeRelease(FrameResources& res)
@@ -285,6 +421,14 @@ static WGPUProgrammableStageDescriptor ImGui_ImplWGPU_CreateShaderModule(const c
     return stage_desc;
 }
 
+static WGPUProgrammableStageDescriptor ImGui_ImplWGPU_CreateFragmentShaderModule(const char* texture_wgsl_source)
+{
+    ImGuiTextBuffer wgsl_source;
+    wgsl_source.append(texture_wgsl_source);
+    wgsl_source.append(__shader_frag_common_wgsl);
+    return ImGui_ImplWGPU_CreateShaderModule(wgsl_source.c_str());
+}
+
 static WGPUBindGroup ImGui_ImplWGPU_CreateImageBindGroup(WGPUBindGroupLayout layout, WGPUTextureView texture)
 {
     ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
@@ -347,6 +491,13 @@ static void ImGui_ImplWGPU_SetupRenderState(ImDrawData* draw_data, WGPURenderPas
             gamma = 1.0f;
         }
         wgpuQueueWriteBuffer(bd->defaultQueue, bd->renderResources.Uniforms, offsetof(Uniforms, Gamma), &gamma, sizeof(Uniforms::Gamma));
+        bd->uploadBytes += sizeof(Uniforms::MVP) + sizeof(Uniforms::Gamma);
+        if (bd->initInfo.CompactVertices)
+        {
+            float compact_pos[3] = { 1.0f / IMGUI_IMPL_WGPU_COMPACT_POS_SCALE, draw_data->DisplayPos.x, draw_data->DisplayPos.y };
+            wgpuQueueWriteBuffer(bd->defaultQueue, bd->renderResources.Uniforms, offsetof(Uniforms, CompactPosScale), compact_pos, sizeof(compact_pos));
+            bd->uploadBytes += sizeof(compact_pos);
+        }
     }
 
     // Setup viewport
@@ -355,7 +506,7 @@ static void ImGui_ImplWGPU_SetupRenderState(ImDrawData* draw_data, WGPURenderPas
     // Bind shader and vertex buffers
     wgpuRenderPassEncoderSetVertexBuffer(ctx, 0, fr->VertexBuffer, 0, fr->VertexBufferSize * sizeof(ImDrawVert));
     wgpuRenderPassEncoderSetIndexBuffer(ctx, fr->IndexBuffer, sizeof(ImDrawIdx) == 2 ? WGPUIndexFormat_Uint16 : WGPUIndexFormat_Uint32, 0, fr->IndexBufferSize * sizeof(ImDrawIdx));
-    wgpuRenderPassEncoderSetPipeline(ctx, bd->pipelineState);
+    wgpuRenderPassEncoderSetPipeline(ctx, bd->pipelineStates[0]);
     wgpuRenderPassEncoderSetBindGroup(ctx, 0, bd->renderResources.CommonBindGroup, 0, nullptr);
 
     // Setup blend factor
@@ -363,6 +514,43 @@ static void ImGui_ImplWGPU_SetupRenderState(ImDrawData* draw_data, WGPURenderPas
     wgpuRenderPassEncoderSetBlendConstant(ctx, &blend_color);
 }
 
+// With CompactVertices each draw list binds its own range of the vertex buffer (the pipeline is chosen per command)
+static void ImGui_ImplWGPU_SetupVertexRange(WGPURenderPassEncoder ctx, FrameResources* fr, const VertexRange& range)
+{
+    if (range.Size == 0)
+        return;
+    wgpuRenderPassEncoderSetVertexBuffer(ctx, 0, fr->VertexBuffer, range.Offset, range.Size);
+}
+
+// Convert the vertices of a draw list to ImGui_ImplWGPU_CompactVert, fails (leaving 'dst' partially written) if one of them doesn't fit
+static bool ImGui_ImplWGPU_WriteCompactVertices(ImGui_ImplWGPU_CompactVert* dst, const ImDrawVert* src, int count, ImVec2 origin)
+{
+    const float pos_min = -32768.0f / IMGUI_IMPL_WGPU_COMPACT_POS_SCALE;
+    const float pos_max = 32767.0f / IMGUI_IMPL_WGPU_COMPACT_POS_SCALE;
+    for (const ImDrawVert* src_end = src + count; src < src_end; src++, dst++)
+    {
+        const float x = src->pos.x - origin.x;
+        const float y = src->pos.y - origin.y;
+        float u = src->uv.x;
+        int u_flag = 0;
+        if (u >= 2.0f)
+        {
+            u -= 2.0f;
+            u_flag = 0x8000;
+        }
+        // Written so NaN fails too
+        if (!(x >= pos_min && x <= pos_max && y >= pos_min && y <= pos_max && u >= 0.0f && u <= 1.0f && src->uv.y >= 0.0f && src->uv.y <= 1.0f))
+            return false;
+        // Round to nearest, biased to stay positive so the truncation is a floor
+        dst->pos[0] = (ImS16)((int)(x * IMGUI_IMPL_WGPU_COMPACT_POS_SCALE + 32768.5f) - 32768);
+        dst->pos[1] = (ImS16)((int)(y * IMGUI_IMPL_WGPU_COMPACT_POS_SCALE + 32768.5f) - 32768);
+        dst->uv[0] = (ImU16)(u_flag | (int)(u * 32767.0f + 0.5f));
+        dst->uv[1] = (ImU16)(src->uv.y * 65535.0f + 0.5f);
+        dst->col = src->col;
+    }
+    return true;
+}
+
 // Render function
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
 void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder pass_encoder)
@@ -445,19 +633,32 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
     }
 
     // Upload vertex/index data into a single contiguous GPU buffer
-    ImDrawVert* vtx_dst = (ImDrawVert*)fr->VertexBufferHost;
+    // (With CompactVertices the draw lists that fit are converted to ImGui_ImplWGPU_CompactVert, the others are copied as they are. Both strides are multiple of 4, as required for the vertex buffer offsets.)
+    const bool compact_vertices = bd->initInfo.CompactVertices;
+    char* vtx_dst = (char*)fr->VertexBufferHost;
     ImDrawIdx* idx_dst = (ImDrawIdx*)fr->IndexBufferHost;
-    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    bd->vertexRanges.resize(compact_vertices ? draw_data->CmdLists.Size : 0);
+    bd->compactVtxCount = 0;
+    for (int list_i = 0; list_i < draw_data->CmdLists.Size; list_i++)
     {
-        memcpy(vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        const ImDrawList* draw_list = draw_data->CmdLists[list_i];
+        const bool compact = compact_vertices && ImGui_ImplWGPU_WriteCompactVertices((ImGui_ImplWGPU_CompactVert*)vtx_dst, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size, draw_data->DisplayPos);
+        const size_t vtx_size = draw_list->VtxBuffer.Size * (compact ? sizeof(ImGui_ImplWGPU_CompactVert) : sizeof(ImDrawVert));
+        if (compact)
+            bd->compactVtxCount += draw_list->VtxBuffer.Size;
+        else
+            memcpy(vtx_dst, draw_list->VtxBuffer.Data, vtx_size);
+        if (compact_vertices)
+            bd->vertexRanges[list_i] = { (uint64_t)(vtx_dst - (char*)fr->VertexBufferHost), vtx_size, compact };
         memcpy(idx_dst, draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
-        vtx_dst += draw_list->VtxBuffer.Size;
+        vtx_dst += vtx_size;
         idx_dst += draw_list->IdxBuffer.Size;
     }
     int64_t vb_write_size = MEMALIGN((char*)vtx_dst - (char*)fr->VertexBufferHost, 4);
     int64_t ib_write_size = MEMALIGN((char*)idx_dst - (char*)fr->IndexBufferHost, 4);
     wgpuQueueWriteBuffer(bd->defaultQueue, fr->VertexBuffer, 0, fr->VertexBufferHost, vb_write_size);
     wgpuQueueWriteBuffer(bd->defaultQueue, fr->IndexBuffer,  0, fr->IndexBufferHost,  ib_write_size);
+    bd->uploadBytes += vb_write_size + ib_write_size;
 
     // Setup desired render state
     ImGui_ImplWGPU_SetupRenderState(draw_data, pass_encoder, fr);
@@ -470,13 +671,18 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
     platform_io.Renderer_RenderState = &render_state;
 
     // Render command lists
-    // (Because we merged all buffers into a single one, we maintain our own offset into them)
+    // (Because we merged all buffers into a single one, we maintain our own offset into them. With CompactVertices the vertex offset stays 0 as each draw list binds its own range.)
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
     ImVec2 clip_scale = draw_data->FramebufferScale;
     ImVec2 clip_off = draw_data->DisplayPos;
-    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    int bound_pipeline = 0; // SetupRenderState() binds pipelineStates[0], -1 after user callbacks
+    for (int list_i = 0; list_i < draw_data->CmdLists.Size; list_i++)
     {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_i];
+        if (compact_vertices)
+            ImGui_ImplWGPU_SetupVertexRange(pass_encoder, fr, bd->vertexRanges[list_i]);
+        const int list_pipeline = (compact_vertices && bd->vertexRanges[list_i].Compact) ? ImGui_ImplWGPU_PipelineFlags_CompactVertices : 0;
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
@@ -485,19 +691,41 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplWGPU_SetupRenderState(draw_data, pass_encoder, fr);
+                    if (compact_vertices)
+                        ImGui_ImplWGPU_SetupVertexRange(pass_encoder, fr, bd->vertexRanges[list_i]);
+                    bound_pipeline = 0;
+                }
                 else
+                {
                     pcmd->UserCallback(draw_list, pcmd);
+                    bound_pipeline = -1;
+                }
             }
             else
             {
+                // Bind the pipeline for the vertex format and the texture format (atlas textures may be ImTextureFormat_Alpha8)
+                const ImTextureData* tex_data = pcmd->TexRef._TexData;
+                int pipeline = list_pipeline | ((tex_data && tex_data->Format == ImTextureFormat_Alpha8) ? ImGui_ImplWGPU_PipelineFlags_Alpha8 : 0);
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+                if (tex_data && tex_data->PageHeight > 0)
+                    pipeline |= ImGui_ImplWGPU_PipelineFlags_Paged;
+#endif
+                if (pipeline != bound_pipeline)
+                {
+                    wgpuRenderPassEncoderSetPipeline(pass_encoder, bd->pipelineStates[pipeline]);
+                    bound_pipeline = pipeline;
+                }
+
                 // Bind custom texture
                 ImTextureID tex_id = pcmd->GetTexID();
                 ImGuiID tex_id_hash = ImHashData(&tex_id, sizeof(tex_id), 0);
                 WGPUBindGroup bind_group = (WGPUBindGroup)bd->renderResources.ImageBindGroups.GetVoidPtr(tex_id_hash);
                 if (!bind_group)
                 {
-                    bind_group = ImGui_ImplWGPU_CreateImageBindGroup(bd->renderResources.ImageBindGroupLayout, (WGPUTextureView)tex_id);
+                    WGPUBindGroupLayout layout = (pipeline & ImGui_ImplWGPU_PipelineFlags_Paged) ? bd->renderResources.ImagePagedBindGroupLayout : bd->renderResources.ImageBindGroupLayout;
+                    bind_group = ImGui_ImplWGPU_CreateImageBindGroup(layout, (WGPUTextureView)tex_id);
                     bd->renderResources.ImageBindGroups.SetVoidPtr(tex_id_hash, bind_group);
                 }
                 wgpuRenderPassEncoderSetBindGroup(pass_encoder, 1, (WGPUBindGroup)bind_group, 0, nullptr);
@@ -520,7 +748,8 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
             }
         }
         global_idx_offset += draw_list->IdxBuffer.Size;
-        global_vtx_offset += draw_list->VtxBuffer.Size;
+        if (!compact_vertices)
+            global_vtx_offset += draw_list->VtxBuffer.Size;
     }
 
     // Remove all ImageBindGroups
@@ -530,7 +759,10 @@ void ImGui_ImplWGPU_RenderDrawData(ImDrawData* draw_data, WGPURenderPassEncoder
         WGPUBindGroup bind_group = (WGPUBindGroup)image_bind_groups.Data[i].val_p;
         SafeRelease(bind_group);
     }
-    image_bind_groups.Data.resize(0);
+    image_bind_groups.Data.resize(0); // keep the capacity, this runs every frame
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    image_bind_groups.BuildIndex();
+#endif
 
     platform_io.Renderer_RenderState = nullptr;
 }
@@ -551,6 +783,217 @@ static void ImGui_ImplWGPU_DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+// Paged textures (ImTextureData::PageHeight, font atlas with IMGUI_ENABLE_PAGED_ATLAS) are stored as one array layer per page
+static int ImGui_ImplWGPU_GetTexturePageHeight(const ImTextureData* tex)
+{
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    if (tex->PageHeight > 0)
+        return tex->PageHeight;
+#endif
+    return tex->Height;
+}
+
+static void ImGui_ImplWGPU_CreateTextureResources(ImTextureData* tex, ImGui_ImplWGPU_Texture* backend_tex)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    const WGPUTextureFormat format = (tex->Format == ImTextureFormat_Alpha8) ? WGPUTextureFormat_R8Unorm : WGPUTextureFormat_RGBA8Unorm;
+    const int page_height = ImGui_ImplWGPU_GetTexturePageHeight(tex);
+    backend_tex->Layers = (uint32_t)(tex->Height / page_height);
+
+    // Create texture
+    WGPUTextureDescriptor tex_desc = {};
+#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
+    tex_desc.label = { "Dear ImGui Texture", WGPU_STRLEN };
+#else
+    tex_desc.label = "Dear ImGui Texture";
+#endif
+    tex_desc.dimension = WGPUTextureDimension_2D;
+    tex_desc.size.width = tex->Width;
+    tex_desc.size.height = page_height;
+    tex_desc.size.depthOrArrayLayers = backend_tex->Layers;
+    tex_desc.sampleCount = 1;
+    tex_desc.format = format;
+    tex_desc.mipLevelCount = 1;
+    tex_desc.usage = WGPUTextureUsage_CopyDst | WGPUTextureUsage_TextureBinding;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    tex_desc.usage |= WGPUTextureUsage_CopySrc; // Copied into a bigger texture when pages are appended
+#endif
+    backend_tex->Texture = wgpuDeviceCreateTexture(bd->wgpuDevice, &tex_desc);
+
+    // Create texture view
+    WGPUTextureViewDescriptor tex_view_desc = {};
+    tex_view_desc.format = format;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    tex_view_desc.dimension = (tex->PageHeight > 0) ? WGPUTextureViewDimension_2DArray : WGPUTextureViewDimension_2D;
+#else
+    tex_view_desc.dimension = WGPUTextureViewDimension_2D;
+#endif
+    tex_view_desc.baseMipLevel = 0;
+    tex_view_desc.mipLevelCount = 1;
+    tex_view_desc.baseArrayLayer = 0;
+    tex_view_desc.arrayLayerCount = backend_tex->Layers;
+    tex_view_desc.aspect = WGPUTextureAspect_All;
+    backend_tex->TextureView = wgpuTextureCreateView(backend_tex->Texture, &tex_view_desc);
+
+    // Store identifiers
+    tex->SetTexID((ImTextureID)(intptr_t)backend_tex->TextureView);
+    tex->BackendUserData = backend_tex;
+}
+
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+// Pages were appended to the texture: recreate it with more layers, the existing ones are copied on the GPU instead of uploaded again
+static void ImGui_ImplWGPU_GrowTexturePages(ImTextureData* tex, ImGui_ImplWGPU_Texture* backend_tex)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    ImGui_ImplWGPU_Texture old_tex = *backend_tex;
+    ImGui_ImplWGPU_CreateTextureResources(tex, backend_tex);
+
+#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
+    WGPUTexelCopyTextureInfo src_view = {}, dst_view = {};
+#else
+    WGPUImageCopyTexture src_view = {}, dst_view = {};
+#endif
+    src_view.texture = old_tex.Texture;
+    src_view.aspect = WGPUTextureAspect_All;
+    dst_view.texture = backend_tex->Texture;
+    dst_view.aspect = WGPUTextureAspect_All;
+    WGPUExtent3D copy_size = { (uint32_t)tex->Width, (uint32_t)tex->PageHeight, old_tex.Layers };
+
+    // Submitted right away: ordered before the uploads of the new pages and the frame using them
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(bd->wgpuDevice, nullptr);
+    wgpuCommandEncoderCopyTextureToTexture(encoder, &src_view, &dst_view, &copy_size);
+    WGPUCommandBuffer cmd_buffer = wgpuCommandEncoderFinish(encoder, nullptr);
+    wgpuQueueSubmit(bd->defaultQueue, 1, &cmd_buffer);
+    wgpuCommandBufferRelease(cmd_buffer);
+    wgpuCommandEncoderRelease(encoder);
+
+    wgpuTextureViewRelease(old_tex.TextureView);
+    wgpuTextureRelease(old_tex.Texture);
+}
+#endif
+
+// Write a region of one page, its rows are tightly packed (copied to the staging buffer unless the region spans whole rows)
+static void ImGui_ImplWGPU_WriteTextureRegion(ImTextureData* tex, ImGui_ImplWGPU_Texture* backend_tex, const ImTextureRect& r)
+{
+    ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
+    const int page_height = ImGui_ImplWGPU_GetTexturePageHeight(tex);
+    const int page = r.y / page_height;
+    const int row_bytes = r.w * tex->BytesPerPixel;
+    const unsigned char* data = (const unsigned char*)tex->GetPixelsAt(r.x, r.y);
+    if (r.w != tex->Width)
+    {
+        // wgpuQueueWriteTexture() copies the data before returning, so the rows only have to live for this frame
+        unsigned char* staging = bd->initInfo.TransientAllocFunc ? (unsigned char*)bd->initInfo.TransientAllocFunc((size_t)row_bytes * r.h, bd->initInfo.TransientAllocUserData) : nullptr;
+        if (staging == nullptr)
+        {
+            bd->textureStaging.resize(row_bytes * r.h);
+            staging = bd->textureStaging.Data;
+        }
+        for (int y = 0; y < r.h; y++)
+            memcpy(staging + y * row_bytes, tex->GetPixelsAt(r.x, r.y + y), row_bytes);
+        data = staging;
+    }
+
+#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
+    WGPUTexelCopyTextureInfo dst_view = {};
+#else
+    WGPUImageCopyTexture dst_view = {};
+#endif
+    dst_view.texture = backend_tex->Texture;
+    dst_view.mipLevel = 0;
+    dst_view.origin = { (uint32_t)r.x, (uint32_t)(r.y - page * page_height), (uint32_t)page };
+    dst_view.aspect = WGPUTextureAspect_All;
+#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
+    WGPUTexelCopyBufferLayout layout = {};
+#else
+    WGPUTextureDataLayout layout = {};
+#endif
+    layout.offset = 0;
+    layout.bytesPerRow = row_bytes;
+    layout.rowsPerImage = r.h;
+    WGPUExtent3D write_size = { (uint32_t)r.w, (uint32_t)r.h, 1 };
+    wgpuQueueWriteTexture(bd->defaultQueue, &dst_view, data, (size_t)row_bytes * r.h, &layout, &write_size);
+    bd->uploadBytes += (uint64_t)row_bytes * r.h;
+    bd->textureUploadBytes += (uint64_t)row_bytes * r.h;
+    bd->textureWriteCount++;
+}
+
+static int ImGui_ImplWGPU_TextureRegionCompare(const void* lhs, const void* rhs)
+{
+    const ImTextureRect* a = (const ImTextureRect*)lhs;
+    const ImTextureRect* b = (const ImTextureRect*)rhs;
+    if (a->y != b->y)
+        return (int)a->y - (int)b->y;
+    return (int)a->x - (int)b->x;
+}
+
+// Merge regions of the same page into their bounding box while that costs less than writing them separately.
+// Sorted by position, each region is only compared with the next few ones: neighbors in the texture, and always the duplicates
+// (e.g. a rectangle cleared then written the same frame).
+static void ImGui_ImplWGPU_CoalesceTextureRegions(ImVector<ImTextureRect>& regions, int bytes_per_pixel, int page_height)
+{
+    const int window = 16;
+    qsort(regions.Data, (size_t)regions.Size, sizeof(ImTextureRect), ImGui_ImplWGPU_TextureRegionCompare);
+    for (bool merged = true; merged; )
+    {
+        merged = false;
+        for (int i = 0; i < regions.Size; i++)
+            for (int j = i + 1; j < regions.Size && j <= i + window; j++)
+            {
+                const ImTextureRect& a = regions[i];
+                const ImTextureRect& b = regions[j];
+                if (a.y / page_height != b.y / page_height)
+                    continue;
+                const int x0 = ImMin(a.x, b.x), y0 = ImMin(a.y, b.y);
+                const int x1 = ImMax(a.x + a.w, b.x + b.w), y1 = ImMax(a.y + a.h, b.y + b.h);
+                const int64_t merged_cost = (int64_t)(x1 - x0) * (y1 - y0) * bytes_per_pixel;
+                const int64_t separate_cost = ((int64_t)a.w * a.h + (int64_t)b.w * b.h) * bytes_per_pixel + IMGUI_IMPL_WEBGPU_TEXTURE_WRITE_COST;
+                if (merged_cost > separate_cost)
+                    continue;
+                regions[i] = { (unsigned short)x0, (unsigned short)y0, (unsigned short)(x1 - x0), (unsigned short)(y1 - y0) };
+                regions.erase(regions.Data + j);
+                j = i;
+                merged = true;
+            }
+    }
+}
+
+// Regions written by ImGui_ImplWGPU_UpdateTexture(). We could use the smaller rect on _WantCreate but using the full rect allows us to clear the texture.
+// Updates only ever write to texture regions which have never been used before, or were cleared: the pixels between the regions
+// are valid too, so regions can be merged. Paged textures get separate regions per page (pages are array layers).
+void ImGui_ImplWGPU_GetTextureUploadRegions(const ImTextureData* tex, bool coalesce, ImVector<ImTextureRect>* out_regions)
+{
+    ImVector<ImTextureRect>& regions = *out_regions;
+    regions.resize(0);
+    if (tex->Status == ImTextureStatus_WantCreate)
+    {
+        regions.push_back({ 0, 0, (unsigned short)tex->Width, (unsigned short)tex->Height });
+    }
+    else if (coalesce)
+    {
+        regions.resize(tex->Updates.Size);
+        memcpy(regions.Data, tex->Updates.Data, tex->Updates.size_in_bytes());
+    }
+    else if (tex->UpdateRect.w > 0 && tex->UpdateRect.h > 0)
+    {
+        regions.push_back(tex->UpdateRect);
+    }
+    const int page_height = ImGui_ImplWGPU_GetTexturePageHeight(tex);
+    for (int n = 0; n < regions.Size; n++)
+    {
+        const int page_y1 = (regions[n].y / page_height + 1) * page_height;
+        if (regions[n].y + regions[n].h <= page_y1)
+            continue;
+        ImTextureRect next_page = regions[n];
+        next_page.y = (unsigned short)page_y1;
+        next_page.h = (unsigned short)(regions[n].y + regions[n].h - page_y1);
+        regions[n].h = (unsigned short)(page_y1 - regions[n].y);
+        regions.push_back(next_page);
+    }
+    if (tex->Status == ImTextureStatus_WantUpdates && coalesce)
+        ImGui_ImplWGPU_CoalesceTextureRegions(regions, tex->BytesPerPixel, page_height);
+}
+
 void ImGui_ImplWGPU_UpdateTexture(ImTextureData* tex)
 {
     ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
@@ -559,75 +1002,31 @@ void ImGui_ImplWGPU_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
         ImGui_ImplWGPU_Texture* backend_tex = IM_NEW(ImGui_ImplWGPU_Texture)();
-
-        // Create texture
-        WGPUTextureDescriptor tex_desc = {};
-#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
-        tex_desc.label = { "Dear ImGui Texture", WGPU_STRLEN };
-#else
-        tex_desc.label = "Dear ImGui Texture";
-#endif
-        tex_desc.dimension = WGPUTextureDimension_2D;
-        tex_desc.size.width = tex->Width;
-        tex_desc.size.height = tex->Height;
-        tex_desc.size.depthOrArrayLayers = 1;
-        tex_desc.sampleCount = 1;
-        tex_desc.format = WGPUTextureFormat_RGBA8Unorm;
-        tex_desc.mipLevelCount = 1;
-        tex_desc.usage = WGPUTextureUsage_CopyDst | WGPUTextureUsage_TextureBinding;
-        backend_tex->Texture = wgpuDeviceCreateTexture(bd->wgpuDevice, &tex_desc);
-
-        // Create texture view
-        WGPUTextureViewDescriptor tex_view_desc = {};
-        tex_view_desc.format = WGPUTextureFormat_RGBA8Unorm;
-        tex_view_desc.dimension = WGPUTextureViewDimension_2D;
-        tex_view_desc.baseMipLevel = 0;
-        tex_view_desc.mipLevelCount = 1;
-        tex_view_desc.baseArrayLayer = 0;
-        tex_view_desc.arrayLayerCount = 1;
-        tex_view_desc.aspect = WGPUTextureAspect_All;
-        backend_tex->TextureView = wgpuTextureCreateView(backend_tex->Texture, &tex_view_desc);
-
-        // Store identifiers
-        tex->SetTexID((ImTextureID)(intptr_t)backend_tex->TextureView);
-        tex->BackendUserData = backend_tex;
+        ImGui_ImplWGPU_CreateTextureResources(tex, backend_tex);
         // We don't set tex->Status to ImTextureStatus_OK to let the code fallthrough below.
     }
 
     if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
     {
         ImGui_ImplWGPU_Texture* backend_tex = (ImGui_ImplWGPU_Texture*)tex->BackendUserData;
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
-
-        // We could use the smaller rect on _WantCreate but using the full rect allows us to clear the texture.
-        const int upload_x = (tex->Status == ImTextureStatus_WantCreate) ? 0 : tex->UpdateRect.x;
-        const int upload_y = (tex->Status == ImTextureStatus_WantCreate) ? 0 : tex->UpdateRect.y;
-        const int upload_w = (tex->Status == ImTextureStatus_WantCreate) ? tex->Width : tex->UpdateRect.w;
-        const int upload_h = (tex->Status == ImTextureStatus_WantCreate) ? tex->Height : tex->UpdateRect.h;
-
-        // Update full texture or selected blocks. We only ever write to textures regions which have never been used before!
-        // This backend choose to use tex->UpdateRect but you can use tex->Updates[] to upload individual regions.
-#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
-        WGPUTexelCopyTextureInfo dst_view = {};
-#else
-        WGPUImageCopyTexture dst_view = {};
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+        if (tex->PageHeight > 0 && (uint32_t)(tex->Height / tex->PageHeight) != backend_tex->Layers)
+            ImGui_ImplWGPU_GrowTexturePages(tex, backend_tex);
 #endif
-        dst_view.texture = backend_tex->Texture;
-        dst_view.mipLevel = 0;
-        dst_view.origin = { (uint32_t)upload_x, (uint32_t)upload_y, 0 };
-        dst_view.aspect = WGPUTextureAspect_All;
-#if !defined(IMGUI_IMPL_WEBGPU_BACKEND_WGPU_EMSCRIPTEN)
-        WGPUTexelCopyBufferLayout layout = {};
-#else
-        WGPUTextureDataLayout layout = {};
-#endif
-        layout.offset = 0;
-        layout.bytesPerRow = tex->Width * tex->BytesPerPixel;
-        layout.rowsPerImage = upload_h;
-        WGPUExtent3D write_size = { (uint32_t)upload_w, (uint32_t)upload_h, 1 };
-        wgpuQueueWriteTexture(bd->defaultQueue, &dst_view, tex->GetPixelsAt(upload_x, upload_y), (uint32_t)(tex->Width * upload_h * tex->BytesPerPixel), &layout, &write_size);
+
+        ImVector<ImTextureRect>& regions = bd->textureRegions;
+        if (tex->Status == ImTextureStatus_WantCreate)
+            bd->textureUpdateBytes += (uint64_t)tex->GetSizeInBytes();
+        else
+            for (const ImTextureRect& r : tex->Updates)
+                bd->textureUpdateBytes += (uint64_t)r.w * r.h * tex->BytesPerPixel;
+        ImGui_ImplWGPU_GetTextureUploadRegions(tex, bd->initInfo.CoalesceTextureUploads, &regions);
+        for (const ImTextureRect& r : regions)
+            if (r.w > 0 && r.h > 0)
+                ImGui_ImplWGPU_WriteTextureRegion(tex, backend_tex, r);
         tex->SetStatus(ImTextureStatus_OK);
     }
     if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
@@ -657,7 +1056,7 @@ bool ImGui_ImplWGPU_CreateDeviceObjects()
     ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
     if (!bd->wgpuDevice)
         return false;
-    if (bd->pipelineState)
+    if (bd->pipelineStates[0])
         ImGui_ImplWGPU_InvalidateDeviceObjects();
 
     // Create render pipeline
@@ -698,7 +1097,16 @@ bool ImGui_ImplWGPU_CreateDeviceObjects()
     WGPUPipelineLayoutDescriptor layout_desc = {};
     layout_desc.bindGroupLayoutCount = 2;
     layout_desc.bindGroupLayouts = bg_layouts;
-    graphics_pipeline_desc.layout = wgpuDeviceCreatePipelineLayout(bd->wgpuDevice, &layout_desc);
+    WGPUPipelineLayout pipeline_layout = wgpuDeviceCreatePipelineLayout(bd->wgpuDevice, &layout_desc);
+    graphics_pipeline_desc.layout = pipeline_layout;
+
+    // Same layouts with a texture_2d_array, for paged textures
+    image_bg_layout_entries[0].texture.viewDimension = WGPUTextureViewDimension_2DArray;
+    WGPUBindGroupLayout paged_bg_layouts[2];
+    paged_bg_layouts[0] = bg_layouts[0];
+    paged_bg_layouts[1] = wgpuDeviceCreateBindGroupLayout(bd->wgpuDevice, &image_bg_layout_desc);
+    layout_desc.bindGroupLayouts = paged_bg_layouts;
+    WGPUPipelineLayout paged_pipeline_layout = wgpuDeviceCreatePipelineLayout(bd->wgpuDevice, &layout_desc);
 
     // Create the vertex shader
     WGPUProgrammableStageDescriptor vertex_shader_desc = ImGui_ImplWGPU_CreateShaderModule(__shader_vert_wgsl);
@@ -729,7 +1137,7 @@ bool ImGui_ImplWGPU_CreateDeviceObjects()
     graphics_pipeline_desc.vertex.buffers = buffer_layouts;
 
     // Create the pixel shader
-    WGPUProgrammableStageDescriptor pixel_shader_desc = ImGui_ImplWGPU_CreateShaderModule(__shader_frag_wgsl);
+    WGPUProgrammableStageDescriptor pixel_shader_desc = ImGui_ImplWGPU_CreateFragmentShaderModule(__shader_frag_wgsl);
 
     // Create the blending setup
     WGPUBlendState blend_state = {};
@@ -774,7 +1182,37 @@ bool ImGui_ImplWGPU_CreateDeviceObjects()
     // Configure disabled depth-stencil state
     graphics_pipeline_desc.depthStencil = (bd->depthStencilFormat == WGPUTextureFormat_Undefined) ? nullptr :  &depth_stencil_state;
 
-    bd->pipelineState = wgpuDeviceCreateRenderPipeline(bd->wgpuDevice, &graphics_pipeline_desc);
+    // Variants for ImGui_ImplWGPU_CompactVert (created even when CompactVertices is off so it can be toggled at runtime) and single channel textures
+    WGPUProgrammableStageDescriptor vertex_compact_shader_desc = ImGui_ImplWGPU_CreateShaderModule(__shader_vert_compact_wgsl);
+    WGPUProgrammableStageDescriptor pixel_alpha8_shader_desc = ImGui_ImplWGPU_CreateFragmentShaderModule(__shader_frag_alpha8_wgsl);
+    WGPUProgrammableStageDescriptor pixel_paged_shader_desc = ImGui_ImplWGPU_CreateFragmentShaderModule(__shader_frag_paged_wgsl);
+    WGPUProgrammableStageDescriptor pixel_paged_alpha8_shader_desc = ImGui_ImplWGPU_CreateFragmentShaderModule(__shader_frag_paged_alpha8_wgsl);
+    const WGPUProgrammableStageDescriptor* pixel_shader_descs[] = { &pixel_shader_desc, &pixel_alpha8_shader_desc, &pixel_paged_shader_desc, &pixel_paged_alpha8_shader_desc }; // Indexed by (flags >> 1)
+    WGPUVertexAttribute attribute_compact_desc[] =
+    {
+#ifdef IMGUI_IMPL_WEBGPU_BACKEND_DAWN
+        { nullptr, WGPUVertexFormat_Sint16x2,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, pos), 0 },
+        { nullptr, WGPUVertexFormat_Uint16x2,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, uv),  1 },
+        { nullptr, WGPUVertexFormat_Unorm8x4,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, col), 2 },
+#else
+        { WGPUVertexFormat_Sint16x2,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, pos), 0 },
+        { WGPUVertexFormat_Uint16x2,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, uv),  1 },
+        { WGPUVertexFormat_Unorm8x4,  (uint64_t)offsetof(ImGui_ImplWGPU_CompactVert, col), 2 },
+#endif
+    };
+    for (int flags = 0; flags < ImGui_ImplWGPU_PipelineFlags_COUNT; flags++)
+    {
+        const WGPUProgrammableStageDescriptor& vs_desc = (flags & ImGui_ImplWGPU_PipelineFlags_CompactVertices) ? vertex_compact_shader_desc : vertex_shader_desc;
+        const WGPUProgrammableStageDescriptor& ps_desc = *pixel_shader_descs[flags >> 1];
+        graphics_pipeline_desc.layout = (flags & ImGui_ImplWGPU_PipelineFlags_Paged) ? paged_pipeline_layout : pipeline_layout;
+        graphics_pipeline_desc.vertex.module = vs_desc.module;
+        graphics_pipeline_desc.vertex.entryPoint = vs_desc.entryPoint;
+        buffer_layouts[0].arrayStride = (flags & ImGui_ImplWGPU_PipelineFlags_CompactVertices) ? sizeof(ImGui_ImplWGPU_CompactVert) : sizeof(ImDrawVert);
+        buffer_layouts[0].attributes = (flags & ImGui_ImplWGPU_PipelineFlags_CompactVertices) ? attribute_compact_desc : attribute_desc;
+        fragment_state.module = ps_desc.module;
+        fragment_state.entryPoint = ps_desc.entryPoint;
+        bd->pipelineStates[flags] = wgpuDeviceCreateRenderPipeline(bd->wgpuDevice, &graphics_pipeline_desc);
+    }
 
     ImGui_ImplWGPU_CreateUniformBuffer();
 
@@ -802,10 +1240,16 @@ bool ImGui_ImplWGPU_CreateDeviceObjects()
     common_bg_descriptor.entries = common_bg_entries;
     bd->renderResources.CommonBindGroup = wgpuDeviceCreateBindGroup(bd->wgpuDevice, &common_bg_descriptor);
     bd->renderResources.ImageBindGroupLayout = bg_layouts[1];
+    bd->renderResources.ImagePagedBindGroupLayout = paged_bg_layouts[1];
 
     SafeRelease(vertex_shader_desc.module);
+    SafeRelease(vertex_compact_shader_desc.module);
     SafeRelease(pixel_shader_desc.module);
-    SafeRelease(graphics_pipeline_desc.layout);
+    SafeRelease(pixel_alpha8_shader_desc.module);
+    SafeRelease(pixel_paged_shader_desc.module);
+    SafeRelease(pixel_paged_alpha8_shader_desc.module);
+    SafeRelease(pipeline_layout);
+    SafeRelease(paged_pipeline_layout);
     SafeRelease(bg_layouts[0]);
 
     return true;
@@ -817,7 +1261,8 @@ void ImGui_ImplWGPU_InvalidateDeviceObjects()
     if (!bd->wgpuDevice)
         return;
 
-    SafeRelease(bd->pipelineState);
+    for (WGPURenderPipeline& pipeline_state : bd->pipelineStates)
+        SafeRelease(pipeline_state);
     SafeRelease(bd->renderResources);
 
     // Destroy all textures
@@ -853,6 +1298,12 @@ bool ImGui_ImplWGPU_Init(ImGui_ImplWGPU_InitInfo* init_info)
 #endif
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;   // We can honor ImGuiPlatformIO::Textures[] requests during render.
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexturePages; // We can grow paged textures (array layers) without uploading them again.
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasDistanceFields; // Our fragment shaders turn distance field glyphs into coverage.
+#endif
 
     bd->initInfo = *init_info;
     bd->wgpuDevice = init_info->Device;
@@ -902,6 +1353,12 @@ void ImGui_ImplWGPU_Shutdown()
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
     io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures);
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasTexturePages;
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    io.BackendFlags &= ~ImGuiBackendFlags_RendererHasDistanceFields;
+#endif
     platform_io.ClearRendererHandlers();
     IM_DELETE(bd);
 }
@@ -909,7 +1366,7 @@ void ImGui_ImplWGPU_Shutdown()
 void ImGui_ImplWGPU_NewFrame()
 {
     ImGui_ImplWGPU_Data* bd = ImGui_ImplWGPU_GetBackendData();
-    if (!bd->pipelineState)
+    if (!bd->pipelineStates[0])
         if (!ImGui_ImplWGPU_CreateDeviceObjects())
             IM_ASSERT(0 && "ImGui_ImplWGPU_CreateDeviceObjects() failed!");
 }
@@ -16,7 +16,8 @@
 //  [X] Renderer: User texture binding. Use 'WGPUTextureView' as ImTextureID. Read the FAQ about ImTextureID/ImTextureRef!
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
-//  [X] Renderer: Texture updates support for dynamic font system (ImGuiBackendFlags_RendererHasTextures).
+//  [X] Renderer: Texture updates support for dynamic font system (ImGuiBackendFlags_RendererHasTextures). ImTextureFormat_RGBA32 and ImTextureFormat_Alpha8 (R8Unorm) textures.
+//  [X] Renderer: Paged textures grown without re-upload (ImGuiBackendFlags_RendererHasTexturePages with IMGUI_ENABLE_PAGED_ATLAS), stored as texture_2d_array.
 
 // You can use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // Prefer including the entire imgui/ repository into your project (either as a copy or as a submodule), and only build the backends you need.
@@ -53,6 +54,10 @@ struct ImGui_ImplWGPU_InitInfo
     WGPUTextureFormat       RenderTargetFormat = WGPUTextureFormat_Undefined;
     WGPUTextureFormat       DepthStencilFormat = WGPUTextureFormat_Undefined;
     WGPUMultisampleState    PipelineMultisampleState = {};
+    bool                    CompactVertices = false;    // Upload 12 bytes vertices (16-bit fixed point positions and UVs) for the draw lists that fit, can be toggled at runtime.
+    bool                    CoalesceTextureUploads = true; // Upload the ImTextureData::Updates[] regions (merged when cheaper) instead of their bounding box, can be toggled at runtime.
+    ImGuiMemAllocFunc       TransientAllocFunc = nullptr;  // Optional, scratch memory that only needs to live until the next ImGui_ImplWGPU_NewFrame() and is never freed by the backend (e.g. a per-frame arena). When unset or when it returns nullptr the backend uses its own buffers.
+    void*                   TransientAllocUserData = nullptr;
 
     ImGui_ImplWGPU_InitInfo()
     {
@@ -93,6 +98,9 @@ struct ImGui_ImplWGPU_RenderState
 bool        ImGui_ImplWGPU_IsSurfaceStatusError(WGPUSurfaceGetCurrentTextureStatus status);
 bool        ImGui_ImplWGPU_IsSurfaceStatusSubOptimal(WGPUSurfaceGetCurrentTextureStatus status);    // Return whether the texture is suboptimal and may need to be recreated.
 
+// (Optional) Helper for testing: the regions ImGui_ImplWGPU_UpdateTexture() writes for 'tex' in its current status (one page each)
+void        ImGui_ImplWGPU_GetTextureUploadRegions(const ImTextureData* tex, bool coalesce, ImVector<ImTextureRect>* out_regions);
+
 // (Optional) Helper for debugging/logging
 void        ImGui_ImplWGPU_DebugPrintAdapterInfo(const WGPUAdapter& adapter);
 const char* ImGui_ImplWGPU_GetBackendTypeName(WGPUBackendType type);
@@ -51,6 +51,7 @@
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics on AArch64
 
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
@@ -66,6 +67,39 @@
 //---- Use legacy CRC32-adler tables (used before 1.91.6), in order to preserve old .ini data that you cannot afford to invalidate.
 //#define IMGUI_USE_LEGACY_CRC32_ADLER
 
+//---- Select the hash used for IDs (default: hardware CRC32 when available, otherwise the CRC32 table). See imgui_internal.h for the list.
+//#define IMGUI_HASH_BACKEND            IMGUI_HASH_BACKEND_WYHASH
+
+//---- Use an open-addressing hash table for ImGuiStorage lookups instead of binary search in a sorted vector (faster insertion and lookup in big storages, costs an extra index table).
+//#define IMGUI_STORAGE_OPEN_ADDRESSING
+
+//---- Cache the vertices of rendered texts and blit them on the next frames instead of decoding/laying out/emitting glyphs again (see ImFontGlyphRunCache in imgui_internal.h).
+//#define IMGUI_ENABLE_GLYPH_RUN_CACHE
+
+//---- Memoize ImGui::CalcTextSize()/ImFont::CalcTextSizeA() results for texts measured on previous frames (see ImFontTextSizeCache in imgui_internal.h).
+//#define IMGUI_ENABLE_TEXT_SIZE_CACHE
+
+//---- Rasterize new glyphs on worker threads: metrics are available right away, the glyph stays blank until its bitmap is applied by a later NewFrame (see ImFontAsyncGlyphs in imgui_internal.h). Also spreads ImFontAtlas::Build() over the same threads. stb_truetype loader only.
+//#define IMGUI_ENABLE_ASYNC_GLYPHS
+
+//---- Grow the font atlas texture by appending pages (e.g. array layers) instead of creating a bigger texture and repacking/uploading everything (see ImFontAtlasPages in imgui_internal.h). Needs a backend setting ImGuiBackendFlags_RendererHasTexturePages.
+//#define IMGUI_ENABLE_PAGED_ATLAS
+
+//---- Keep the font atlas texture under a byte budget by evicting least recently used bakes and glyphs, instead of growing it up to TexMaxWidth/TexMaxHeight (see ImFontAtlasBudget in imgui_internal.h).
+//#define IMGUI_ENABLE_ATLAS_BUDGET
+
+//---- Keep rasterized glyphs in a file (ImFontAtlas::GlyphCacheFilename) so that later runs copy them instead of rasterizing them again (see ImFontGlyphCache in imgui_internal.h).
+//#define IMGUI_ENABLE_GLYPH_DISK_CACHE
+
+//---- Bake fonts flagged with ImFontFlags_DistanceField once as signed distance fields, serving every size from that bake. Needs a backend setting ImGuiBackendFlags_RendererHasDistanceFields (see ImFontAtlasSdf in imgui_internal.h). stb_truetype loader only.
+//#define IMGUI_ENABLE_SDF_FONTS
+
+//---- Pack font atlas rectangles into shelves of similar heights, with O(log n) inserts and discarded space reused right away, instead of stb_rectpack's skyline (see ImFontAtlasShelfPacker in imgui_internal.h).
+//#define IMGUI_ENABLE_SHELF_PACKER
+
+//---- Vectorize the per-pixel passes of the stb_truetype rasterizer: scanline accumulation (SSE2/AVX2/NEON) and oversampling box filters (SSE2/NEON). Glyph pixels may differ by 1 from stb_truetype (see ImFontRasterizeScanlineSIMD in imgui_internal.h).
+//#define IMGUI_ENABLE_STB_TRUETYPE_SIMD
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support Unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
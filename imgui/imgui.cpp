@@ -1163,6 +1163,9 @@ IMPLEMENTING SUPPORT for ImGuiBackendFlags_RendererHasTextures:
 // System includes
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // _BitScanForward
+#endif
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -2288,7 +2291,6 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -2332,75 +2334,175 @@ static const ImU32 GCrc32LookupTable[256] =
     0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351
 #endif
 };
-#endif
 
-// Known size hash
-// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+ImGuiID ImHashDataCrc32Table(const void* data_p, size_t data_size, ImGuiID seed)
 {
     ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
-    const unsigned char *data_end = (const unsigned char*)data_p + data_size;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
+    const unsigned char* data_end = data + data_size;
     const ImU32* crc32_lut = GCrc32LookupTable;
     while (data < data_end)
         crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
     return ~crc;
-#else
-    while (data + 4 <= data_end)
+}
+
+// Hardware CRC32c: the same values as the table, one instruction per 8 bytes
+#ifdef IMGUI_ENABLE_SSE4_2_CRC
+ImGuiID ImHashDataCrc32SSE42(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    ImU32 crc = ~seed;
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end = data + data_size;
+#if defined(__x86_64__) || defined(_M_X64)
+    ImU64 crc64 = crc;
+    for (ImU64 v; data + 8 <= data_end; data += 8)
+    {
+        memcpy(&v, data, 8);
+        crc64 = _mm_crc32_u64(crc64, v);
+    }
+    crc = (ImU32)crc64;
+#endif
+    for (ImU32 v; data + 4 <= data_end; data += 4)
     {
-        crc = _mm_crc32_u32(crc, *(ImU32*)data);
-        data += 4;
+        memcpy(&v, data, 4);
+        crc = _mm_crc32_u32(crc, v);
     }
     while (data < data_end)
         crc = _mm_crc32_u8(crc, *data++);
     return ~crc;
-#endif
 }
+#endif
 
-// Zero-terminated string hash, with support for ### to reset back to seed value
-// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-// Because this syntax is rarely used we are optimizing for the common case.
-// - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
-ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+#ifdef IMGUI_ENABLE_ARM_CRC32
+ImGuiID ImHashDataCrc32Arm(const void* data_p, size_t data_size, ImGuiID seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
+    ImU32 crc = ~seed;
     const unsigned char* data = (const unsigned char*)data_p;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-    const ImU32* crc32_lut = GCrc32LookupTable;
-#endif
-    if (data_size != 0)
+    const unsigned char* data_end = data + data_size;
+    for (ImU64 v; data + 8 <= data_end; data += 8)
     {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+        memcpy(&v, data, 8);
+        crc = __crc32cd(crc, v);
+    }
+    while (data < data_end)
+        crc = __crc32cb(crc, *data++);
+    return ~crc;
+}
+#endif
+
+// wyhash (final version 4, public domain, https://github.com/wangyi-fudan/wyhash) folded to 32-bit
+static inline void ImWyMum(ImU64* a, ImU64* b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (ImU64)r;
+    *b = (ImU64)(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
 #else
-            crc = _mm_crc32_u8(crc, c);
+    ImU64 ha = *a >> 32, hb = *b >> 32, la = (ImU32)*a, lb = (ImU32)*b;
+    ImU64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+    ImU64 lo = t + (rm1 << 32);
+    c += lo < t;
+    ImU64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
 #endif
+}
+static inline ImU64 ImWyMix(ImU64 a, ImU64 b) { ImWyMum(&a, &b); return a ^ b; }
+static inline ImU64 ImWyRead8(const unsigned char* p) { ImU64 v; memcpy(&v, p, 8); return v; }
+static inline ImU64 ImWyRead4(const unsigned char* p) { ImU32 v; memcpy(&v, p, 4); return v; }
+static inline ImU64 ImWyRead3(const unsigned char* p, size_t k) { return ((ImU64)p[0] << 16) | ((ImU64)p[k >> 1] << 8) | p[k - 1]; }
+
+ImGuiID ImHashDataWyhash(const void* data_p, size_t data_size, ImGuiID seed_32)
+{
+    static const ImU64 wyp[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+    const unsigned char* p = (const unsigned char*)data_p;
+    ImU64 seed = seed_32;
+    seed ^= ImWyMix(seed ^ wyp[0], wyp[1]);
+    ImU64 a, b;
+    if (data_size <= 16)
+    {
+        if (data_size >= 4)
+        {
+            a = (ImWyRead4(p) << 32) | ImWyRead4(p + ((data_size >> 3) << 2));
+            b = (ImWyRead4(p + data_size - 4) << 32) | ImWyRead4(p + data_size - 4 - ((data_size >> 3) << 2));
+        }
+        else if (data_size > 0)
+        {
+            a = ImWyRead3(p, data_size);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
         }
     }
     else
     {
-        while (unsigned char c = *data++)
+        size_t i = data_size;
+        if (i > 48)
         {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-#ifndef IMGUI_ENABLE_SSE4_2_CRC
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
+            ImU64 see1 = seed, see2 = seed;
+            do
+            {
+                seed = ImWyMix(ImWyRead8(p) ^ wyp[1], ImWyRead8(p + 8) ^ seed);
+                see1 = ImWyMix(ImWyRead8(p + 16) ^ wyp[2], ImWyRead8(p + 24) ^ see1);
+                see2 = ImWyMix(ImWyRead8(p + 32) ^ wyp[3], ImWyRead8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16)
+        {
+            seed = ImWyMix(ImWyRead8(p) ^ wyp[1], ImWyRead8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = ImWyRead8(p + i - 16);
+        b = ImWyRead8(p + i - 8);
+    }
+    a ^= wyp[1];
+    b ^= seed;
+    ImWyMum(&a, &b);
+    const ImU64 h = ImWyMix(a ^ wyp[0] ^ data_size, b ^ wyp[1]);
+    return (ImGuiID)(h ^ (h >> 32));
+}
+
+#if IMGUI_HASH_BACKEND == IMGUI_HASH_BACKEND_CRC32_SSE4_2
+#define ImHashDataKernel ImHashDataCrc32SSE42
+#elif IMGUI_HASH_BACKEND == IMGUI_HASH_BACKEND_CRC32_ARM
+#define ImHashDataKernel ImHashDataCrc32Arm
+#elif IMGUI_HASH_BACKEND == IMGUI_HASH_BACKEND_WYHASH
+#define ImHashDataKernel ImHashDataWyhash
 #else
-            crc = _mm_crc32_u8(crc, c);
+#define ImHashDataKernel ImHashDataCrc32Table
 #endif
-        }
-    }
-    return ~crc;
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
+{
+    return ImHashDataKernel(data_p, data_size, seed);
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+// Because this syntax is rarely used we are optimizing for the common case.
+// - If we reach ### in the string we discard the hash so far and reset to the seed.
+// - Resetting at every ### is the same as hashing from the last ###, so we find it first (memchr is vectorized)
+//   and then hash the rest of the string in one go, which lets the kernels work on more than one byte at a time.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
+{
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_end = data_p + data_size;
+    const char* start = data_p;
+    for (const char* p = data_p; (p = (const char*)memchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (p + 3 <= data_end && p[1] == '#' && p[2] == '#')
+            start = p;
+    return ImHashDataKernel(start, (size_t)(data_end - start), seed);
 }
 
 // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
@@ -2505,6 +2607,14 @@ IM_MSVC_RUNTIME_CHECKS_OFF
 // We handle UTF-8 decoding error by skipping forward.
 int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
 {
+    // ASCII shortcut, same result as the decoder below (which reads 0 at or past in_text_end)
+    const unsigned int c0 = *(const unsigned char*)in_text;
+    if (c0 < 0x80)
+    {
+        *out_char = (in_text_end == NULL || in_text < in_text_end) ? c0 : 0;
+        return 1;
+    }
+
     static const char lengths[32] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0 };
     static const int masks[]  = { 0x00, 0x7f, 0x1f, 0x0f, 0x07 };
     static const uint32_t mins[] = { 0x400000, 0, 0x80, 0x800, 0x10000 };
@@ -2556,10 +2666,121 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+#if IMGUI_TEXT_UTF8_BLOCK
+
+static inline int ImTextUtf8CountBits(ImU32 v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (int)((((v + (v >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+}
+
+static inline int ImTextUtf8FirstBit(ImU32 v) // v != 0
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+#if defined(IMGUI_ENABLE_NEON) && !defined(IMGUI_ENABLE_SSE)
+// NEON has no movemask: weight the bytes of each half by their bit and add them pairwise down to 16 bits.
+static inline ImU32 ImTextUtf8NeonMovemask(uint8x16_t mask)
+{
+    static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t t = vandq_u8(mask, vld1q_u8(bits));
+    t = vpaddq_u8(t, t);
+    t = vpaddq_u8(t, t);
+    t = vpaddq_u8(t, t);
+    return vgetq_lane_u16(vreinterpretq_u16_u8(t), 0);
+}
+#endif
+
+// Scan IMGUI_TEXT_UTF8_BLOCK bytes and return the length of their prefix made of ASCII (but 0) and well-formed 2-byte sequences
+// (lead byte 0xC2..0xDF + one continuation byte). Those decode with no error case, to exactly what ImTextCharFromUtf8() returns,
+// so callers can take the whole prefix at once. A sequence is never split: a lead byte at the end of the block is left out.
+// Returns 0 when the first byte needs ImTextCharFromUtf8() (3/4-byte sequences, malformed input, 0 terminator).
+static inline int ImTextScanUtf8Block(const char* p, int* out_char_count)
+{
+    // Bit n of each mask is for byte n. Signed compares on x86: 0x80..0xBF = -128..-65, 0xC2..0xDF = -62..-33
+#if defined(IMGUI_ENABLE_AVX2)
+    const __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)p);
+    const ImU32 ascii = (ImU32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, _mm256_setzero_si256()));
+    const ImU32 cont  = (ImU32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(-64), v));
+    const ImU32 lead2 = (ImU32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(-63)), _mm256_cmpgt_epi8(_mm256_set1_epi8(-32), v)));
+    const ImU32 block_mask = 0xFFFFFFFF;
+#elif defined(IMGUI_ENABLE_SSE)
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)p);
+    const ImU32 ascii = (ImU32)_mm_movemask_epi8(_mm_cmpgt_epi8(v, _mm_setzero_si128()));
+    const ImU32 cont  = (ImU32)_mm_movemask_epi8(_mm_cmplt_epi8(v, _mm_set1_epi8(-64)));
+    const ImU32 lead2 = (ImU32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(-63)), _mm_cmplt_epi8(v, _mm_set1_epi8(-32))));
+    const ImU32 block_mask = 0xFFFF;
+#else
+    const uint8x16_t v = vld1q_u8((const uint8_t*)p);
+    const ImU32 ascii = ImTextUtf8NeonMovemask(vandq_u8(vcgtq_u8(v, vdupq_n_u8(0x00)), vcltq_u8(v, vdupq_n_u8(0x80))));
+    const ImU32 cont  = ImTextUtf8NeonMovemask(vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x80)), vcltq_u8(v, vdupq_n_u8(0xC0))));
+    const ImU32 lead2 = ImTextUtf8NeonMovemask(vandq_u8(vcgeq_u8(v, vdupq_n_u8(0xC2)), vcleq_u8(v, vdupq_n_u8(0xDF))));
+    const ImU32 block_mask = 0xFFFF;
+#endif
+    if (ascii == block_mask)
+    {
+        *out_char_count = IMGUI_TEXT_UTF8_BLOCK;
+        return IMGUI_TEXT_UTF8_BLOCK;
+    }
+
+    // Bad bytes: anything else, continuation bytes not following a lead byte, lead bytes not followed by a continuation byte.
+    const ImU32 bad = (~(ascii | lead2 | cont) | (cont & ~(lead2 << 1)) | (lead2 & ~(cont >> 1))) & block_mask;
+    const int len = bad ? ImTextUtf8FirstBit(bad) : IMGUI_TEXT_UTF8_BLOCK;
+    const ImU32 len_mask = (len == 32) ? 0xFFFFFFFF : ((1u << len) - 1);
+    *out_char_count = ImTextUtf8CountBits((ascii | lead2) & len_mask);
+    return len;
+}
+
+#endif // #if IMGUI_TEXT_UTF8_BLOCK
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
+#if IMGUI_TEXT_UTF8_BLOCK
+    // Whole blocks while there is room for them. Anything the block scan can't take goes through the regular decoder,
+    // called exactly like the loop below does so results are identical (including with a NULL in_text_end).
+    const char* text_end = in_text_end ? in_text_end : in_text + ImStrlen(in_text);
+    while (text_end - in_text >= IMGUI_TEXT_UTF8_BLOCK && buf_end - 1 - buf_out >= IMGUI_TEXT_UTF8_BLOCK)
+    {
+        int block_chars;
+        const int block_len = ImTextScanUtf8Block(in_text, &block_chars);
+        if (block_len == 0)
+        {
+            // Decode a block worth of bytes before scanning again, so 3/4-byte text doesn't pay a scan per code point
+            for (const char* scalar_end = in_text + IMGUI_TEXT_UTF8_BLOCK; in_text < scalar_end && *in_text; )
+            {
+                unsigned int c;
+                in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+                *buf_out++ = (ImWchar)c;
+            }
+            if (in_text < text_end && *in_text == 0)
+                break;
+            continue;
+        }
+        if (block_chars == block_len)
+        {
+            for (int n = 0; n < block_len; n++) // ASCII only, the compiler vectorizes this
+                buf_out[n] = (ImWchar)(unsigned char)in_text[n];
+            buf_out += block_len;
+            in_text += block_len;
+            continue;
+        }
+        for (const char* block_end = in_text + block_len; in_text < block_end; )
+        {
+            const unsigned int c = *(const unsigned char*)in_text++;
+            *buf_out++ = (ImWchar)(c < 0x80 ? c : ((c & 0x1F) << 6) | (*(const unsigned char*)in_text++ & 0x3F));
+        }
+    }
+#endif
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
         unsigned int c;
@@ -2575,6 +2796,28 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
 int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
 {
     int char_count = 0;
+#if IMGUI_TEXT_UTF8_BLOCK
+    const char* text_end = in_text_end ? in_text_end : in_text + ImStrlen(in_text);
+    while (text_end - in_text >= IMGUI_TEXT_UTF8_BLOCK)
+    {
+        int block_chars;
+        const int block_len = ImTextScanUtf8Block(in_text, &block_chars);
+        if (block_len == 0)
+        {
+            for (const char* scalar_end = in_text + IMGUI_TEXT_UTF8_BLOCK; in_text < scalar_end && *in_text; )
+            {
+                unsigned int c;
+                in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+                char_count++;
+            }
+            if (in_text < text_end && *in_text == 0)
+                return char_count;
+            continue;
+        }
+        in_text += block_len;
+        char_count += block_chars;
+    }
+#endif
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
         unsigned int c;
@@ -2832,6 +3075,173 @@ static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
     return (lhs_v > rhs_v ? +1 : lhs_v < rhs_v ? -1 : 0);
 }
 
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+
+// IDs are already hashes, but storages are also keyed by small integers (e.g. ImPool): mix so consecutive keys don't form clusters.
+static inline int ImGuiStorage_HomeSlot(ImGuiID key, int mask)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (int)((h ^ (h >> 15)) & (ImU32)mask);
+}
+
+// Slot holding 'key', or the empty slot ending its probe sequence. Index must not be empty.
+static int ImGuiStorage_FindSlot(const ImGuiStorage* storage, ImGuiID key)
+{
+    const int mask = storage->Index.Size - 1;
+    for (int slot = ImGuiStorage_HomeSlot(key, mask); ; slot = (slot + 1) & mask)
+    {
+        const int idx = storage->Index.Data[slot];
+        IM_ASSERT(idx <= storage->Data.Size && "ImGuiStorage::Data was modified directly, call BuildIndex()!");
+        if (idx == 0 || storage->Data.Data[idx - 1].key == key)
+            return slot;
+    }
+}
+
+static ImGuiStoragePair* ImGuiStorage_Find(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->Index.Size == 0)
+        return NULL;
+    const int idx = storage->Index.Data[ImGuiStorage_FindSlot(storage, key)];
+    return idx ? const_cast<ImGuiStoragePair*>(&storage->Data.Data[idx - 1]) : NULL;
+}
+
+// Find or append, keeping the load factor under 3/4 so probe sequences stay short and always end on an empty slot.
+static ImGuiStoragePair* ImGuiStorage_FindOrInsert(ImGuiStorage* storage, const ImGuiStoragePair& pair)
+{
+    if ((storage->Data.Size + 1) * 4 > storage->Index.Size * 3)
+    {
+        storage->Index.resize(ImMax(storage->Index.Size * 2, 16));
+        storage->BuildIndex();
+    }
+    const int slot = ImGuiStorage_FindSlot(storage, pair.key);
+    if (int idx = storage->Index.Data[slot])
+        return &storage->Data.Data[idx - 1];
+    storage->Data.push_back(pair);
+    storage->Index.Data[slot] = storage->Data.Size;
+    return &storage->Data.back();
+}
+
+// Rebuild Index from Data, e.g. after appending and sorting. Grows the table if needed, never shrinks it.
+// Duplicate keys in Data are not merged: queries will find the first one.
+void ImGuiStorage::BuildIndex()
+{
+    int size = ImMax(Index.Size, 16);
+    while (Data.Size * 4 > size * 3)
+        size *= 2;
+    Index.resize(size);
+    memset(Index.Data, 0, (size_t)Index.size_in_bytes());
+    for (int n = 0; n < Data.Size; n++)
+    {
+        const int slot = ImGuiStorage_FindSlot(this, Data.Data[n].key);
+        if (Index.Data[slot] == 0)
+            Index.Data[slot] = n + 1;
+    }
+}
+
+// For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+void ImGuiStorage::BuildSortByKey()
+{
+    ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), PairComparerByID);
+    BuildIndex();
+}
+
+int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
+{
+    const ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_i : default_val;
+}
+
+bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
+{
+    return GetInt(key, default_val ? 1 : 0) != 0;
+}
+
+float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
+{
+    const ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    const ImGuiStoragePair* it = ImGuiStorage_Find(this, key);
+    return it ? it->val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
+}
+
+bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
+{
+    return (bool*)GetIntRef(key, default_val ? 1 : 0);
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    return &ImGuiStorage_FindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
+}
+
+void ImGuiStorage::SetInt(ImGuiID key, int val)
+{
+    *GetIntRef(key, val) = val;
+}
+
+void ImGuiStorage::SetBool(ImGuiID key, bool val)
+{
+    SetInt(key, val ? 1 : 0);
+}
+
+void ImGuiStorage::SetFloat(ImGuiID key, float val)
+{
+    *GetFloatRef(key, val) = val;
+}
+
+void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
+{
+    *GetVoidPtrRef(key, val) = val;
+}
+
+// Backward shift deletion: the following pairs of the probe sequence are moved back into the hole, so there are no tombstones
+// and lookups never degrade after many insert/remove cycles. Data is kept dense by moving its last pair into the removed one.
+void ImGuiStorage::Remove(ImGuiID key)
+{
+    if (Index.Size == 0)
+        return;
+    int slot = ImGuiStorage_FindSlot(this, key);
+    const int idx = Index.Data[slot];
+    if (idx == 0)
+        return;
+    if (idx != Data.Size)
+    {
+        Index.Data[ImGuiStorage_FindSlot(this, Data.back().key)] = idx;
+        Data.Data[idx - 1] = Data.back();
+    }
+    Data.pop_back();
+
+    const int mask = Index.Size - 1;
+    for (int next = (slot + 1) & mask; Index.Data[next] != 0; next = (next + 1) & mask)
+    {
+        // The pair in 'next' may move to 'slot' if 'slot' is within [home, next) of its probe sequence
+        const int home = ImGuiStorage_HomeSlot(Data.Data[Index.Data[next] - 1].key, mask);
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            Index.Data[slot] = Index.Data[next];
+            slot = next;
+        }
+    }
+    Index.Data[slot] = 0;
+}
+
+#else
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -2930,6 +3340,15 @@ void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
         it->val_p = val;
 }
 
+void ImGuiStorage::Remove(ImGuiID key)
+{
+    ImGuiStoragePair* it = ImLowerBound(Data.Data, Data.Data + Data.Size, key);
+    if (it != Data.Data + Data.Size && it->key == key)
+        Data.erase(it);
+}
+
+#endif // #ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+
 void ImGuiStorage::SetAllInt(int v)
 {
     for (int i = 0; i < Data.Size; i++)
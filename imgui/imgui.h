@@ -1720,6 +1720,12 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
     ImGuiBackendFlags_RendererHasTextures   = 1 << 4,   // Backend Renderer supports ImTextureData requests to create/update/destroy textures. This enables incremental texture updates and texture reloads. See https://github.com/ocornut/imgui/blob/master/docs/BACKENDS.md for instructions on how to upgrade your custom backend.
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    ImGuiBackendFlags_RendererHasTexturePages = 1 << 5, // Backend Renderer supports ImTextureData::PageHeight: textures growing by whole pages in ImTextureStatus_WantUpdates state (e.g. stored as array layers). Lets the font atlas append pages instead of growing and repacking.
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    ImGuiBackendFlags_RendererHasDistanceFields = 1 << 6, // Backend Renderer supports distance field glyphs: vertices with U >= 2.0f sample the texture at U - 2.0f and turn the texel alpha (0.5 on the glyph edge) into coverage. Enables ImFontFlags_DistanceField.
+#endif
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -2772,11 +2778,20 @@ struct ImGuiStorage
 {
     // [Internal]
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    ImVector<int>                   Index;      // Open-addressing table (linear probing, power of two size) of Data indices + 1, 0 = empty slot.
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+    // - With IMGUI_STORAGE_OPEN_ADDRESSING: Data is kept dense but unsorted (insertion order), queries and insertions are O(1) through Index.
+    //   If you modify Data directly (push_back, sort, resize), call BuildIndex() before the next query.
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    void                Clear() { Data.clear(); Index.clear(); }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2795,8 +2810,14 @@ struct ImGuiStorage
     IMGUI_API float*    GetFloatRef(ImGuiID key, float default_val = 0.0f);
     IMGUI_API void**    GetVoidPtrRef(ImGuiID key, void* default_val = NULL);
 
+    // Remove a pair if present. With IMGUI_STORAGE_OPEN_ADDRESSING the last pair of Data is moved into its place.
+    IMGUI_API void      Remove(ImGuiID key);
+
     // Advanced: for quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
     IMGUI_API void      BuildSortByKey();
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    IMGUI_API void      BuildIndex();
+#endif
     // Obsolete: use on your own storage if you know only integer are being stored (open/close all tree nodes)
     IMGUI_API void      SetAllInt(int val);
 
@@ -3478,6 +3499,9 @@ struct ImTextureData
     ImTextureFormat     Format;                 // w    r   // ImTextureFormat_RGBA32 (default) or ImTextureFormat_Alpha8
     int                 Width;                  // w    r   // Texture width
     int                 Height;                 // w    r   // Texture height
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    int                 PageHeight;             // w    r   // Texture is a stack of Height/PageHeight pages (e.g. array layers). V coordinates are in page units: page index + y/PageHeight. With ImGuiBackendFlags_RendererHasTexturePages, Height may grow by whole pages in ImTextureStatus_WantUpdates state, existing pages keep their contents.
+#endif
     int                 BytesPerPixel;          // w    r   // 4 or 1
     unsigned char*      Pixels;                 // w    r   // Pointer to buffer holding 'Width*Height' pixels and 'Width*Height*BytesPerPixels' bytes.
     ImTextureRect       UsedRect;               // w    r   // Bounding box encompassing all past and queued Updates[].
@@ -3562,6 +3586,9 @@ struct ImFontGlyph
     float           X0, Y0, X1, Y1;     // Glyph corners. Offsets from current cursor/layout position.
     float           U0, V0, U1, V1;     // Texture coordinates for the current value of ImFontAtlas->TexRef. Cached equivalent of calling GetCustomRect() with PackId.
     int             PackId;             // [Internal] ImFontAtlasRectId value (FIXME: Cold data, could be moved elsewhere?)
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    int             LastUsedFrame;      // [Internal] Last frame this was rendered by ImFont::RenderText()/RenderChar(), used to evict glyphs (see ImFontAtlasBudget)
+#endif
 
     ImFontGlyph()   { memset(this, 0, sizeof(*this)); PackId = -1; }
 };
@@ -3724,6 +3751,9 @@ struct ImFontAtlas
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    const char*                 GlyphCacheFilename; // = NULL. Path of the rasterized glyphs cache file, loaded on first use and saved when the builder is destroyed (or by ImFontAtlasGlyphCacheSave()). NULL to disable.
+#endif
 
     // Output
     // - Because textures are dynamically created/resized, the current texture identifier may changed at *ANY TIME* during the frame.
@@ -3817,6 +3847,9 @@ enum ImFontFlags_
     ImFontFlags_NoLoadError             = 1 << 1,   // Disable throwing an error/assert when calling AddFontXXX() with missing file/data. Calling code is expected to check AddFontXXX() return value.
     ImFontFlags_NoLoadGlyphs            = 1 << 2,   // [Internal] Disable loading new glyphs.
     ImFontFlags_LockBakedSizes          = 1 << 3,   // [Internal] Disable loading new baked sizes, disable garbage collecting current ones. e.g. if you want to lock a font to a single size. Important: if you use this to preload given sizes, consider the possibility of multiple font density used on Retina display.
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    ImFontFlags_DistanceField           = 1 << 4,   // Rasterize the font once as a signed distance field and scale that bake to every size/density, instead of baking each size. Needs ImGuiBackendFlags_RendererHasDistanceFields, otherwise sizes are baked as usual. Set in ImFontConfig::Flags.
+#endif
 };
 
 // Font runtime data and rendering
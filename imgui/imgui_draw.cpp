@@ -41,6 +41,12 @@ Index of this file:
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -94,6 +100,12 @@ Index of this file:
 //#define IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 //#define IMGUI_DISABLE_STB_RECT_PACK_IMPLEMENTATION
 
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+// stb_truetype also allocates on the glyph worker threads
+static void*    ImFontAsyncGlyphsMemAlloc(size_t size);
+static void     ImFontAsyncGlyphsMemFree(void* ptr);
+#endif
+
 #ifdef IMGUI_STB_NAMESPACE
 namespace IMGUI_STB_NAMESPACE
 {
@@ -137,8 +149,13 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+#define STBTT_malloc(x,u)   ((void)(u), ImFontAsyncGlyphsMemAlloc(x))
+#define STBTT_free(x,u)     ((void)(u), ImFontAsyncGlyphsMemFree(x))
+#else
 #define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
 #define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#endif
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -147,6 +164,11 @@ namespace IMGUI_STB_NAMESPACE
 #define STBTT_ifloor(x)     ((int)ImFloor(x))
 #define STBTT_iceil(x)      ((int)ImCeil(x))
 #define STBTT_strlen(x)     ImStrlen(x)
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+static thread_local bool GImFontRasterizeScalarCurrent = false; // GImFontRasterizeScalar when the glyph rasterized by this thread was requested
+#define STBTT_accumulate_scanline(coverage, fill, len, out) (GImFontRasterizeScalarCurrent ? ImFontRasterizeScanlineScalar(coverage, fill, len, out) : ImFontRasterizeScanlineSIMD(coverage, fill, len, out))
+#define STBTT_prefilter(pixels, w, h, stride, kernel_width, vertical) (!GImFontRasterizeScalarCurrent && ImFontRasterizePrefilterSIMD(pixels, w, h, stride, kernel_width, vertical))
+#endif
 #define STBTT_STATIC
 #define STB_TRUETYPE_IMPLEMENTATION
 #else
@@ -798,6 +820,238 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Normal of the segment points[i1] -> points[i2]
+static inline void ImPolylineNormalAt(const ImVec2* points, int i1, int i2, ImVec2* out_normal)
+{
+    float dx = points[i2].x - points[i1].x;
+    float dy = points[i2].y - points[i1].y;
+    IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+    out_normal->x = dy;
+    out_normal->y = -dx;
+}
+
+// Edge points of points[i2], from the average of the normals of the segments around it
+static inline void ImPolylineEdgesAt(const ImVec2* points, const ImVec2* normals, int i1, int i2, const float* offsets, int offsets_count, ImVec2* out_edges)
+{
+    float dm_x = (normals[i1].x + normals[i2].x) * 0.5f;
+    float dm_y = (normals[i1].y + normals[i2].y) * 0.5f;
+    IM_FIXNORMAL2F(dm_x, dm_y);
+    for (int n = 0; n < offsets_count; n++)
+    {
+        out_edges[n].x = points[i2].x + dm_x * offsets[n];
+        out_edges[n].y = points[i2].y + dm_y * offsets[n];
+    }
+}
+
+void ImPolylineNormalsScalar(const ImVec2* points, int points_count, bool closed, ImVec2* out_normals)
+{
+    const int count = closed ? points_count : points_count - 1;
+    for (int i1 = 0; i1 < count; i1++)
+        ImPolylineNormalAt(points, i1, (i1 + 1) == points_count ? 0 : i1 + 1, &out_normals[i1]);
+    if (!closed)
+        out_normals[points_count - 1] = out_normals[points_count - 2];
+}
+
+void ImPolylineEdgesScalar(const ImVec2* points, const ImVec2* normals, int points_count, bool closed, const float* offsets, int offsets_count, ImVec2* out_edges)
+{
+    // If line is not closed, the first point needs to be generated differently as there are no normals to blend
+    const int count = closed ? points_count : points_count - 1;
+    if (!closed)
+        for (int n = 0; n < offsets_count; n++)
+        {
+            out_edges[n].x = points[0].x + normals[0].x * offsets[n];
+            out_edges[n].y = points[0].y + normals[0].y * offsets[n];
+        }
+
+    // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+    for (int i1 = 0; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        ImPolylineEdgesAt(points, normals, i1, i2, offsets, offsets_count, &out_edges[i2 * offsets_count]);
+    }
+}
+
+#ifdef IMGUI_ENABLE_POLYLINE_SIMD
+// Same operations in the same order as the scalar kernels, so the results match: SSE _mm_rsqrt_ps() is the instruction behind ImRsqrt(),
+// on NEON ImRsqrt() is 1.0f / sqrtf() so we use the IEEE vsqrtq_f32()/vdivq_f32() rather than the vrsqrteq_f32() estimate.
+// The blocks stop 4 points before the end so no lane wraps around, the scalar helpers do the rest.
+#if defined(IMGUI_ENABLE_SSE)
+typedef __m128 ImPolylineF4;
+#else
+typedef float32x4_t ImPolylineF4;
+#endif
+
+// Load points[i] .. points[i+3] as one register per coordinate
+static inline void ImPolylineLoad4(const ImVec2* points, int i, ImPolylineF4* out_x, ImPolylineF4* out_y)
+{
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128 p01 = _mm_loadu_ps(&points[i].x), p23 = _mm_loadu_ps(&points[i + 2].x);
+    *out_x = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+    *out_y = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+#else
+    const float32x4x2_t p = vld2q_f32(&points[i].x);
+    *out_x = p.val[0];
+    *out_y = p.val[1];
+#endif
+}
+
+// ImPolylineEdgesAt() averaged normals of points i1+1 .. i1+4, from normals[i1] .. normals[i1+4]
+static inline void ImPolylineAverageNormals4(const ImVec2* normals, int i1, ImPolylineF4* out_dm_x, ImPolylineF4* out_dm_y)
+{
+    ImPolylineF4 n1_x, n1_y, n2_x, n2_y;
+    ImPolylineLoad4(normals, i1, &n1_x, &n1_y);
+    ImPolylineLoad4(normals, i1 + 1, &n2_x, &n2_y);
+#if defined(IMGUI_ENABLE_SSE)
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128 dm_x = _mm_mul_ps(_mm_add_ps(n1_x, n2_x), half);
+    __m128 dm_y = _mm_mul_ps(_mm_add_ps(n1_y, n2_y), half);
+    const __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+    const __m128 mask = _mm_cmpgt_ps(d2, _mm_set1_ps(0.000001f));
+    const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(_mm_set1_ps(1.0f), d2), _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2));
+    *out_dm_x = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm_x, inv_len2)), _mm_andnot_ps(mask, dm_x));
+    *out_dm_y = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dm_y, inv_len2)), _mm_andnot_ps(mask, dm_y));
+#else
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    float32x4_t dm_x = vmulq_f32(vaddq_f32(n1_x, n2_x), half);
+    float32x4_t dm_y = vmulq_f32(vaddq_f32(n1_y, n2_y), half);
+    const float32x4_t d2 = vaddq_f32(vmulq_f32(dm_x, dm_x), vmulq_f32(dm_y, dm_y));
+    const uint32x4_t mask = vcgtq_f32(d2, vdupq_n_f32(0.000001f));
+    const float32x4_t inv_len2 = vminq_f32(vdivq_f32(vdupq_n_f32(1.0f), d2), vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2));
+    *out_dm_x = vbslq_f32(mask, vmulq_f32(dm_x, inv_len2), dm_x);
+    *out_dm_y = vbslq_f32(mask, vmulq_f32(dm_y, inv_len2), dm_y);
+#endif
+}
+
+void ImPolylineNormalsSIMD(const ImVec2* points, int points_count, bool closed, ImVec2* out_normals)
+{
+    const int count = closed ? points_count : points_count - 1;
+    int i1 = 0;
+    for (; i1 + 4 < points_count; i1 += 4)
+    {
+        ImPolylineF4 a_x, a_y, b_x, b_y;
+        ImPolylineLoad4(points, i1, &a_x, &a_y);
+        ImPolylineLoad4(points, i1 + 1, &b_x, &b_y);
+#if defined(IMGUI_ENABLE_SSE)
+        __m128 dx = _mm_sub_ps(b_x, a_x);
+        __m128 dy = _mm_sub_ps(b_y, a_y);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 mask = _mm_cmpgt_ps(d2, _mm_setzero_ps());
+        const __m128 inv_len = _mm_rsqrt_ps(d2);
+        dx = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dx, inv_len)), _mm_andnot_ps(mask, dx));
+        dy = _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(dy, inv_len)), _mm_andnot_ps(mask, dy));
+        const __m128 nx = dy;
+        const __m128 ny = _mm_xor_ps(dx, _mm_set1_ps(-0.0f));
+        _mm_storeu_ps(&out_normals[i1].x, _mm_unpacklo_ps(nx, ny));
+        _mm_storeu_ps(&out_normals[i1 + 2].x, _mm_unpackhi_ps(nx, ny));
+#else
+        float32x4_t dx = vsubq_f32(b_x, a_x);
+        float32x4_t dy = vsubq_f32(b_y, a_y);
+        const float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        const uint32x4_t mask = vcgtq_f32(d2, vdupq_n_f32(0.0f));
+        const float32x4_t inv_len = vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(d2));
+        dx = vbslq_f32(mask, vmulq_f32(dx, inv_len), dx);
+        dy = vbslq_f32(mask, vmulq_f32(dy, inv_len), dy);
+        float32x4x2_t n;
+        n.val[0] = dy;
+        n.val[1] = vnegq_f32(dx);
+        vst2q_f32(&out_normals[i1].x, n);
+#endif
+    }
+    for (; i1 < count; i1++)
+        ImPolylineNormalAt(points, i1, (i1 + 1) == points_count ? 0 : i1 + 1, &out_normals[i1]);
+    if (!closed)
+        out_normals[points_count - 1] = out_normals[points_count - 2];
+}
+
+void ImPolylineEdgesSIMD(const ImVec2* points, const ImVec2* normals, int points_count, bool closed, const float* offsets, int offsets_count, ImVec2* out_edges)
+{
+    if (offsets_count != 2 && offsets_count != 4)
+    {
+        ImPolylineEdgesScalar(points, normals, points_count, closed, offsets, offsets_count, out_edges);
+        return;
+    }
+    const int count = closed ? points_count : points_count - 1;
+    if (!closed)
+        for (int n = 0; n < offsets_count; n++)
+        {
+            out_edges[n].x = points[0].x + normals[0].x * offsets[n];
+            out_edges[n].y = points[0].y + normals[0].y * offsets[n];
+        }
+
+    // Writes the edges of points i1+1 .. i1+4
+    int i1 = 0;
+    for (; i1 + 4 < points_count; i1 += 4)
+    {
+        ImVec2* out = &out_edges[(i1 + 1) * offsets_count];
+        ImPolylineF4 dm_x, dm_y, p_x, p_y;
+        ImPolylineAverageNormals4(normals, i1, &dm_x, &dm_y);
+        ImPolylineLoad4(points, i1 + 1, &p_x, &p_y);
+#if defined(IMGUI_ENABLE_SSE)
+        __m128 e[8];
+        for (int n = 0; n < offsets_count; n++)
+        {
+            const __m128 offset = _mm_set1_ps(offsets[n]);
+            e[n * 2 + 0] = _mm_add_ps(p_x, _mm_mul_ps(dm_x, offset));
+            e[n * 2 + 1] = _mm_add_ps(p_y, _mm_mul_ps(dm_y, offset));
+        }
+        // Transpose from one register per coordinate to one (or two) per point
+        _MM_TRANSPOSE4_PS(e[0], e[1], e[2], e[3]);
+        if (offsets_count == 2)
+        {
+            _mm_storeu_ps(&out[0].x, e[0]); _mm_storeu_ps(&out[2].x, e[1]); _mm_storeu_ps(&out[4].x, e[2]); _mm_storeu_ps(&out[6].x, e[3]);
+        }
+        else
+        {
+            _MM_TRANSPOSE4_PS(e[4], e[5], e[6], e[7]);
+            for (int n = 0; n < 4; n++)
+            {
+                _mm_storeu_ps(&out[n * 4 + 0].x, e[n]);
+                _mm_storeu_ps(&out[n * 4 + 2].x, e[n + 4]);
+            }
+        }
+#else
+        float32x4_t e[8];
+        for (int n = 0; n < offsets_count; n++)
+        {
+            const float32x4_t offset = vdupq_n_f32(offsets[n]);
+            e[n * 2 + 0] = vaddq_f32(p_x, vmulq_f32(dm_x, offset));
+            e[n * 2 + 1] = vaddq_f32(p_y, vmulq_f32(dm_y, offset));
+        }
+        if (offsets_count == 2)
+        {
+            float32x4x4_t v;
+            v.val[0] = e[0]; v.val[1] = e[1]; v.val[2] = e[2]; v.val[3] = e[3];
+            vst4q_f32(&out[0].x, v);
+        }
+        else
+        {
+            // (x,y) pairs of each offset, then two pairs per register
+            float32x4x2_t xy[4];
+            for (int n = 0; n < 4; n++)
+                xy[n] = vzipq_f32(e[n * 2 + 0], e[n * 2 + 1]);
+            for (int n = 0; n < 4; n++)
+            {
+                const int half_n = n >> 1;
+                const bool high = (n & 1) != 0;
+                vst1q_f32(&out[n * 4 + 0].x, high ? vcombine_f32(vget_high_f32(xy[0].val[half_n]), vget_high_f32(xy[1].val[half_n])) : vcombine_f32(vget_low_f32(xy[0].val[half_n]), vget_low_f32(xy[1].val[half_n])));
+                vst1q_f32(&out[n * 4 + 2].x, high ? vcombine_f32(vget_high_f32(xy[2].val[half_n]), vget_high_f32(xy[3].val[half_n])) : vcombine_f32(vget_low_f32(xy[2].val[half_n]), vget_low_f32(xy[3].val[half_n])));
+            }
+        }
+#endif
+    }
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        ImPolylineEdgesAt(points, normals, i1, i2, offsets, offsets_count, &out_edges[i2 * offsets_count]);
+    }
+}
+#define ImPolylineNormals   ImPolylineNormalsSIMD
+#define ImPolylineEdges     ImPolylineEdgesSIMD
+#else
+#define ImPolylineNormals   ImPolylineNormalsScalar
+#define ImPolylineEdges     ImPolylineEdgesScalar
+#endif
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -840,17 +1094,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
-        if (!closed)
-            temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        ImPolylineNormals(points, points_count, closed, temp_normals);
 
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
         if (use_texture || !thick_line)
@@ -865,38 +1109,17 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
+            // Add temporary vertices for the outer edges, from the averaged normals (offset to the outer edge of the AA area)
+            const float edge_offsets[2] = { half_draw_size, -half_draw_size };
+            ImPolylineEdges(points, temp_normals, points_count, closed, edge_offsets, 2, temp_points);
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // Generate the indices to form a number of triangles for each line segment
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertices for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -956,49 +1179,17 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
+            // Add temporary vertices: outer AA edge, inner edges, outer AA edge
+            const float edge_offsets[4] = { half_inner_thickness + AA_SIZE, half_inner_thickness, -half_inner_thickness, -(half_inner_thickness + AA_SIZE) };
+            ImPolylineEdges(points, temp_normals, points_count, closed, edge_offsets, 4, temp_points);
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+            // Generate the indices to form a number of triangles for each line segment
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
@@ -1056,47 +1247,88 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     }
 }
 
-// - We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
-// - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
-void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+// Write up to 'count' repetitions of an index pattern, repetition r being pattern[n] + r * step[n]. Returns the number of repetitions
+// written, the caller writes the remaining ones with its scalar loop (all of them without SIMD, or when there are too few to bother).
+// The fill and fringe indices of polygons only depend on the point index: with SIMD, 3 registers hold a whole number of repetitions
+// of a 3 or 6 indices pattern (24 16-bit or 12 32-bit indices) and each block is 3 additions and 3 stores.
+static inline int ImDrawIdxWritePattern(ImDrawIdx* out, const unsigned int* pattern, const unsigned int* step, int pattern_len, int count)
 {
-    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
-        return;
-
-    const ImVec2 uv = _Data->TexUvWhitePixel;
-
-    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    int r = 0;
+#if defined(IMGUI_ENABLE_SSE2) || defined(IMGUI_ENABLE_NEON)
+    const int block_len = 3 * 16 / (int)sizeof(ImDrawIdx);
+    const int block_reps = block_len / pattern_len;
+    if ((block_len % pattern_len) == 0 && count >= block_reps * 4) // Not worth the setup for a few blocks
     {
-        // Anti-aliased Fill
-        const float AA_SIZE = _FringeScale;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-        const int idx_count = (points_count - 2)*3 + points_count * 6;
-        const int vtx_count = (points_count * 2);
-        PrimReserve(idx_count, vtx_count);
-
-        // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
-        for (int i = 2; i < points_count; i++)
+        ImDrawIdx values[3 * 16 / sizeof(ImDrawIdx)];
+        ImDrawIdx steps[3 * 16 / sizeof(ImDrawIdx)];
+        for (int n = 0, k = 0, rep = 0; n < block_len; n++)
         {
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
-            _IdxWritePtr += 3;
+            values[n] = (ImDrawIdx)(pattern[k] + rep * step[k]);
+            steps[n] = (ImDrawIdx)(block_reps * step[k]);
+            if (++k == pattern_len)
+                k = 0, rep++;
         }
-
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+#if defined(IMGUI_ENABLE_SSE2)
+        __m128i v0 = _mm_loadu_si128((const __m128i*)(const void*)values), v1 = _mm_loadu_si128((const __m128i*)(const void*)(values + block_len / 3)), v2 = _mm_loadu_si128((const __m128i*)(const void*)(values + block_len / 3 * 2));
+        const __m128i s0 = _mm_loadu_si128((const __m128i*)(const void*)steps), s1 = _mm_loadu_si128((const __m128i*)(const void*)(steps + block_len / 3)), s2 = _mm_loadu_si128((const __m128i*)(const void*)(steps + block_len / 3 * 2));
+        for (; r + block_reps <= count; r += block_reps, out += block_len)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            _mm_storeu_si128((__m128i*)(void*)out, v0);
+            _mm_storeu_si128((__m128i*)(void*)(out + block_len / 3), v1);
+            _mm_storeu_si128((__m128i*)(void*)(out + block_len / 3 * 2), v2);
+            if (sizeof(ImDrawIdx) == 2) { v0 = _mm_add_epi16(v0, s0); v1 = _mm_add_epi16(v1, s1); v2 = _mm_add_epi16(v2, s2); }
+            else                        { v0 = _mm_add_epi32(v0, s0); v1 = _mm_add_epi32(v1, s1); v2 = _mm_add_epi32(v2, s2); }
         }
+#else
+        uint8x16_t v0 = vld1q_u8((const uint8_t*)values), v1 = vld1q_u8((const uint8_t*)values + 16), v2 = vld1q_u8((const uint8_t*)values + 32);
+        const uint8x16_t s0 = vld1q_u8((const uint8_t*)steps), s1 = vld1q_u8((const uint8_t*)steps + 16), s2 = vld1q_u8((const uint8_t*)steps + 32);
+        for (; r + block_reps <= count; r += block_reps, out += block_len)
+        {
+            vst1q_u8((uint8_t*)out, v0);
+            vst1q_u8((uint8_t*)out + 16, v1);
+            vst1q_u8((uint8_t*)out + 32, v2);
+            if (sizeof(ImDrawIdx) == 2)
+            {
+                v0 = vreinterpretq_u8_u16(vaddq_u16(vreinterpretq_u16_u8(v0), vreinterpretq_u16_u8(s0)));
+                v1 = vreinterpretq_u8_u16(vaddq_u16(vreinterpretq_u16_u8(v1), vreinterpretq_u16_u8(s1)));
+                v2 = vreinterpretq_u8_u16(vaddq_u16(vreinterpretq_u16_u8(v2), vreinterpretq_u16_u8(s2)));
+            }
+            else
+            {
+                v0 = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(v0), vreinterpretq_u32_u8(s0)));
+                v1 = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(v1), vreinterpretq_u32_u8(s1)));
+                v2 = vreinterpretq_u8_u32(vaddq_u32(vreinterpretq_u32_u8(v2), vreinterpretq_u32_u8(s2)));
+            }
+        }
+#endif
+    }
+#else
+    IM_UNUSED(out); IM_UNUSED(pattern); IM_UNUSED(step); IM_UNUSED(pattern_len); IM_UNUSED(count);
+#endif
+    return r;
+}
+
+// Vertices and fringe indices of an anti-aliased polygon fill, after its fill indices: an inner (opaque) and an outer (transparent) vertex
+// for each point, offset along the averaged normals. Bigger polygons use the SIMD polyline kernels and write 4 points at a time.
+#define IM_DRAWLIST_FILL_SIMD_MIN_POINTS    24
+static void ImDrawListAddPolyFillFringe(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col)
+{
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    const float AA_SIZE = draw_list->_FringeScale;
+    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+    const unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+    const unsigned int vtx_outer_idx = draw_list->_VtxCurrentIdx + 1;
+
+    // Compute normals
+    draw_list->_Data->TempBuffer.reserve_discard(points_count);
+    ImVec2* temp_normals = draw_list->_Data->TempBuffer.Data;
 
+    // Small polygons (e.g. rounded rectangles) write vertices and fringe indices in a single loop
+    if (points_count < IM_DRAWLIST_FILL_SIMD_MIN_POINTS)
+    {
+        ImPolylineNormalsScalar(points, points_count, true, temp_normals);
+        ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+        ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
             // Average normals
@@ -1109,16 +1341,133 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
+            vtx_write[0].pos.x = (points[i1].x - dm_x); vtx_write[0].pos.y = (points[i1].y - dm_y); vtx_write[0].uv = uv; vtx_write[0].col = col;        // Inner
+            vtx_write[1].pos.x = (points[i1].x + dm_x); vtx_write[1].pos.y = (points[i1].y + dm_y); vtx_write[1].uv = uv; vtx_write[1].col = col_trans;  // Outer
+            vtx_write += 2;
 
             // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            idx_write += 6;
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        draw_list->_VtxWritePtr = vtx_write;
+        draw_list->_IdxWritePtr = idx_write;
+        draw_list->_VtxCurrentIdx += (ImDrawIdx)(points_count * 2);
+        return;
+    }
+    ImPolylineNormals(points, points_count, true, temp_normals);
+
+    // Add vertices, the first point averages the normals of the last and first segments
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_POLYLINE_SIMD
+    // Same operations as ImPolylineEdgesAt() with { -AA_SIZE * 0.5f, AA_SIZE * 0.5f } offsets
+    float dm0_x = (temp_normals[points_count - 1].x + temp_normals[0].x) * 0.5f;
+    float dm0_y = (temp_normals[points_count - 1].y + temp_normals[0].y) * 0.5f;
+    IM_FIXNORMAL2F(dm0_x, dm0_y);
+    dm0_x *= AA_SIZE * 0.5f;
+    dm0_y *= AA_SIZE * 0.5f;
+    vtx_write[0].pos.x = (points[0].x - dm0_x); vtx_write[0].pos.y = (points[0].y - dm0_y); vtx_write[0].uv = uv; vtx_write[0].col = col;        // Inner
+    vtx_write[1].pos.x = (points[0].x + dm0_x); vtx_write[1].pos.y = (points[0].y + dm0_y); vtx_write[1].uv = uv; vtx_write[1].col = col_trans;  // Outer
+    vtx_write += 2;
+    for (i1 = 1; i1 + 4 <= points_count; i1 += 4, vtx_write += 8)
+    {
+        ImPolylineF4 dm4_x, dm4_y, p_x, p_y;
+        ImPolylineAverageNormals4(temp_normals, i1 - 1, &dm4_x, &dm4_y);
+        ImPolylineLoad4(points, i1, &p_x, &p_y);
+#if defined(IMGUI_ENABLE_SSE)
+        const __m128 offset = _mm_set1_ps(AA_SIZE * 0.5f), neg_offset = _mm_set1_ps(-AA_SIZE * 0.5f);
+        const __m128 in_x = _mm_add_ps(p_x, _mm_mul_ps(dm4_x, neg_offset)), in_y = _mm_add_ps(p_y, _mm_mul_ps(dm4_y, neg_offset));
+        const __m128 out_x = _mm_add_ps(p_x, _mm_mul_ps(dm4_x, offset)), out_y = _mm_add_ps(p_y, _mm_mul_ps(dm4_y, offset));
+        const __m128 in01 = _mm_unpacklo_ps(in_x, in_y), in23 = _mm_unpackhi_ps(in_x, in_y);
+        const __m128 out01 = _mm_unpacklo_ps(out_x, out_y), out23 = _mm_unpackhi_ps(out_x, out_y);
+        _mm_storel_pi((__m64*)(void*)&vtx_write[0].pos, in01); _mm_storel_pi((__m64*)(void*)&vtx_write[1].pos, out01);
+        _mm_storeh_pi((__m64*)(void*)&vtx_write[2].pos, in01); _mm_storeh_pi((__m64*)(void*)&vtx_write[3].pos, out01);
+        _mm_storel_pi((__m64*)(void*)&vtx_write[4].pos, in23); _mm_storel_pi((__m64*)(void*)&vtx_write[5].pos, out23);
+        _mm_storeh_pi((__m64*)(void*)&vtx_write[6].pos, in23); _mm_storeh_pi((__m64*)(void*)&vtx_write[7].pos, out23);
+#else
+        const float32x4_t offset = vdupq_n_f32(AA_SIZE * 0.5f), neg_offset = vdupq_n_f32(-AA_SIZE * 0.5f);
+        const float32x4x2_t in = vzipq_f32(vaddq_f32(p_x, vmulq_f32(dm4_x, neg_offset)), vaddq_f32(p_y, vmulq_f32(dm4_y, neg_offset)));
+        const float32x4x2_t out = vzipq_f32(vaddq_f32(p_x, vmulq_f32(dm4_x, offset)), vaddq_f32(p_y, vmulq_f32(dm4_y, offset)));
+        vst1_f32(&vtx_write[0].pos.x, vget_low_f32(in.val[0])); vst1_f32(&vtx_write[1].pos.x, vget_low_f32(out.val[0]));
+        vst1_f32(&vtx_write[2].pos.x, vget_high_f32(in.val[0])); vst1_f32(&vtx_write[3].pos.x, vget_high_f32(out.val[0]));
+        vst1_f32(&vtx_write[4].pos.x, vget_low_f32(in.val[1])); vst1_f32(&vtx_write[5].pos.x, vget_low_f32(out.val[1]));
+        vst1_f32(&vtx_write[6].pos.x, vget_high_f32(in.val[1])); vst1_f32(&vtx_write[7].pos.x, vget_high_f32(out.val[1]));
+#endif
+        for (int n = 0; n < 8; n += 2)
+        {
+            vtx_write[n + 0].uv = uv; vtx_write[n + 0].col = col;
+            vtx_write[n + 1].uv = uv; vtx_write[n + 1].col = col_trans;
+        }
+    }
+#endif
+    for (int i0 = (i1 == 0) ? points_count - 1 : i1 - 1; i1 < points_count; i0 = i1++)
+    {
+        // Average normals
+        const ImVec2& n0 = temp_normals[i0];
+        const ImVec2& n1 = temp_normals[i1];
+        float dm_x = (n0.x + n1.x) * 0.5f;
+        float dm_y = (n0.y + n1.y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        dm_x *= AA_SIZE * 0.5f;
+        dm_y *= AA_SIZE * 0.5f;
+
+        vtx_write[0].pos.x = (points[i1].x - dm_x); vtx_write[0].pos.y = (points[i1].y - dm_y); vtx_write[0].uv = uv; vtx_write[0].col = col;        // Inner
+        vtx_write[1].pos.x = (points[i1].x + dm_x); vtx_write[1].pos.y = (points[i1].y + dm_y); vtx_write[1].uv = uv; vtx_write[1].col = col_trans;  // Outer
+        vtx_write += 2;
+    }
+    draw_list->_VtxWritePtr = vtx_write;
+
+    // Add indexes for fringes, two triangles for each segment i0 -> i1, starting with the segment that wraps around
+    const unsigned int last = (points_count - 1) << 1;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + last); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + last);
+    idx_write[3] = (ImDrawIdx)(vtx_outer_idx + last); idx_write[4] = (ImDrawIdx)(vtx_outer_idx); idx_write[5] = (ImDrawIdx)(vtx_inner_idx);
+    idx_write += 6;
+    const unsigned int fringe_idx[6] = { vtx_inner_idx + 2, vtx_inner_idx, vtx_outer_idx, vtx_outer_idx, vtx_outer_idx + 2, vtx_inner_idx + 2 };
+    const unsigned int fringe_step[6] = { 2, 2, 2, 2, 2, 2 };
+    i1 = 1 + ImDrawIdxWritePattern(idx_write, fringe_idx, fringe_step, 6, points_count - 1);
+    idx_write += (i1 - 1) * 6;
+    for (int i0 = i1 - 1; i1 < points_count; i0 = i1++)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+        idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+        idx_write += 6;
+    }
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)(points_count * 2);
+}
+
+// - We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
+// - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
+void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+{
+    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
+        return;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill
+        const int idx_count = (points_count - 2)*3 + points_count * 6;
+        const int vtx_count = (points_count * 2);
+        PrimReserve(idx_count, vtx_count);
+
+        // Add indexes for fill
+        const unsigned int vtx_inner_idx = _VtxCurrentIdx;
+        const unsigned int fill_idx[3] = { vtx_inner_idx, vtx_inner_idx + 2, vtx_inner_idx + 4 };
+        const unsigned int fill_step[3] = { 0, 2, 2 };
+        int i = 2 + ImDrawIdxWritePattern(_IdxWritePtr, fill_idx, fill_step, 3, points_count - 2);
+        _IdxWritePtr += (i - 2) * 3;
+        for (; i < points_count; i++)
+        {
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+            _IdxWritePtr += 3;
+        }
+
+        // Add vertices and indexes for fringes
+        ImDrawListAddPolyFillFringe(this, points, points_count, col);
     }
     else
     {
@@ -1131,7 +1480,11 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
             _VtxWritePtr++;
         }
-        for (int i = 2; i < points_count; i++)
+        const unsigned int fill_idx[3] = { _VtxCurrentIdx, _VtxCurrentIdx + 1, _VtxCurrentIdx + 2 };
+        const unsigned int fill_step[3] = { 0, 1, 1 };
+        int i = 2 + ImDrawIdxWritePattern(_IdxWritePtr, fill_idx, fill_step, 3, points_count - 2);
+        _IdxWritePtr += (i - 2) * 3;
+        for (; i < points_count; i++)
         {
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + i - 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + i);
             _IdxWritePtr += 3;
@@ -1795,6 +2148,8 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 //-----------------------------------------------------------------------------
 // Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
+// Large polygons keep their reflex vertices in a uniform grid, which makes the ear tests local and the whole thing close to linear
+// for typical shapes (the worst case, e.g. all reflexes in a few cells, stays quadratic). The triangles are the same either way.
 // Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
 // Provided as a convenience for user but not used by main library.
 //-----------------------------------------------------------------------------
@@ -1802,6 +2157,10 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
 // - AddConcavePolyFilled()
 //-----------------------------------------------------------------------------
 
+// Polygons with at least this many points bucket their reflex vertices in a grid, so IsEar() only tests the reflexes around the triangle
+#define IM_TRIANGULATOR_GRID_MIN_POINTS     64
+#define IM_TRIANGULATOR_GRID_MIN_REFLEXES   16      // Below this a linear scan of the reflexes is cheaper than walking the cells
+
 enum ImTriangulatorNodeType
 {
     ImTriangulatorNodeType_Convex,
@@ -1820,39 +2179,69 @@ struct ImTriangulatorNode
     void    Unlink()        { Next->Prev = Prev; Prev->Next = Next; }
 };
 
+// Large polygons also track the position of each reflex (Positions[] is indexed by node index) so removing one doesn't search the list.
+// Nodes with a stale type may not be in the span they are removed from.
 struct ImTriangulatorNodeSpan
 {
     ImTriangulatorNode**    Data = NULL;
     int                     Size = 0;
+    int*                    Positions = NULL;
 
-    void    push_back(ImTriangulatorNode* node) { Data[Size++] = node; }
-    void    find_erase_unsorted(int idx)        { for (int i = Size - 1; i >= 0; i--) if (Data[i]->Index == idx) { Data[i] = Data[Size - 1]; Size--; return; } }
+    void    push_back(ImTriangulatorNode* node)         { if (Positions) Positions[node->Index] = Size; Data[Size++] = node; }
+    bool    erase_unsorted(ImTriangulatorNode* node)
+    {
+        int i = Size - 1;
+        if (Positions)
+            i = (Positions[node->Index] < Size) ? Positions[node->Index] : -1;
+        else
+            while (i >= 0 && Data[i] != node)
+                i--;
+        if (i < 0 || Data[i] != node)
+            return false;
+        Data[i] = Data[--Size];
+        if (Positions)
+            Positions[Data[i]->Index] = i;
+        return true;
+    }
 };
 
 struct ImTriangulator
 {
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateScratchBufferSize(int points_count)  { const int grid_side = GetGridSide(points_count); return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2 + (grid_side > 0 ? sizeof(ImTriangulatorNode*) * (grid_side * grid_side + points_count * 2) + sizeof(int) * points_count : 0); }
+    static int GetGridSide(int points_count)                { return (points_count < IM_TRIANGULATOR_GRID_MIN_POINTS) ? 0 : (int)ImSqrt((float)points_count * 0.5f); } // About 2 points per cell
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
 
     // Internal functions
     void    BuildNodes(const ImVec2* points, int points_count);
+    void    BuildGrid(const ImVec2* points, int points_count);
     void    BuildReflexes();
     void    BuildEars();
     void    FlipNodeList();
     bool    IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
+    bool    IsEarInGrid(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
     void    ReclassifyNode(ImTriangulatorNode* node);
+    void    AddReflex(ImTriangulatorNode* node);
+    void    RemoveReflex(ImTriangulatorNode* node);
+    void    ClearReflexes();
+    int     GetGridCell(float v, float min, float inv_cell_size) const { const float f = (v - min) * inv_cell_size; return (f > 0.0f) ? (f < (float)(_GridSide - 1) ? (int)f : _GridSide - 1) : 0; } // NaN goes to cell 0
 
     // Internal members
     int                     _TrianglesLeft = 0;
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
+    ImTriangulatorNode**    _GridCells = NULL;  // _GridSide * _GridSide lists of reflexes, NULL for small polygons
+    ImTriangulatorNode**    _GridNext = NULL;   // Links of the cell lists, by node index
+    ImTriangulatorNode**    _GridPrev = NULL;
+    int                     _GridSide = 0;
+    ImVec2                  _GridMin;
+    ImVec2                  _GridInvCellSize;
 };
 
-// Distribute storage for nodes, ears and reflexes.
+// Distribute storage for nodes, ears, reflexes, and the grid of large polygons.
 // FIXME-OPT: if everything is convex, we could report it to caller and let it switch to an convex renderer
 // (this would require first building reflexes to bail to convex if empty, without even building nodes)
 void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_buffer)
@@ -1862,7 +2251,14 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
     _Nodes         = (ImTriangulatorNode*)scratch_buffer;                          // points_count x Node
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
+    _GridSide      = GetGridSide(points_count);
+    _GridCells     = _GridSide > 0 ? _Reflexes.Data + points_count : NULL;         // GetGridSide()^2 x Node*
+    _GridNext      = _GridSide > 0 ? _GridCells + _GridSide * _GridSide : NULL;    // points_count x Node*
+    _GridPrev      = _GridSide > 0 ? _GridNext + points_count : NULL;              // points_count x Node*
+    _Reflexes.Positions = _GridSide > 0 ? (int*)(_GridPrev + points_count) : NULL;   // points_count x int
     BuildNodes(points, points_count);
+    if (_GridCells != NULL)
+        BuildGrid(points, points_count);
     BuildReflexes();
     BuildEars();
 }
@@ -1881,6 +2277,21 @@ void ImTriangulator::BuildNodes(const ImVec2* points, int points_count)
     _Nodes[points_count - 1].Next = _Nodes;
 }
 
+void ImTriangulator::BuildGrid(const ImVec2* points, int points_count)
+{
+    ImVec2 bb_min = points[0], bb_max = points[0];
+    for (int i = 1; i < points_count; i++)
+    {
+        bb_min = ImMin(bb_min, points[i]);
+        bb_max = ImMax(bb_max, points[i]);
+    }
+    _GridMin = bb_min;
+    _GridInvCellSize.x = (bb_max.x > bb_min.x) ? _GridSide / (bb_max.x - bb_min.x) : 0.0f;
+    _GridInvCellSize.y = (bb_max.y > bb_min.y) ? _GridSide / (bb_max.y - bb_min.y) : 0.0f;
+    memset(_GridCells, 0, sizeof(ImTriangulatorNode*) * _GridSide * _GridSide);
+    memset(_Reflexes.Positions, 0xFF, sizeof(int) * points_count); // -1
+}
+
 void ImTriangulator::BuildReflexes()
 {
     ImTriangulatorNode* n1 = _Nodes;
@@ -1889,7 +2300,7 @@ void ImTriangulator::BuildReflexes()
         if (ImTriangleIsClockwise(n1->Prev->Pos, n1->Pos, n1->Next->Pos))
             continue;
         n1->Type = ImTriangulatorNodeType_Reflex;
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     }
 }
 
@@ -1907,6 +2318,40 @@ void ImTriangulator::BuildEars()
     }
 }
 
+void ImTriangulator::AddReflex(ImTriangulatorNode* node)
+{
+    _Reflexes.push_back(node);
+    if (_GridCells == NULL)
+        return;
+    ImTriangulatorNode** cell = &_GridCells[GetGridCell(node->Pos.y, _GridMin.y, _GridInvCellSize.y) * _GridSide + GetGridCell(node->Pos.x, _GridMin.x, _GridInvCellSize.x)];
+    _GridPrev[node->Index] = NULL;
+    _GridNext[node->Index] = *cell;
+    if (*cell)
+        _GridPrev[(*cell)->Index] = node;
+    *cell = node;
+}
+
+void ImTriangulator::RemoveReflex(ImTriangulatorNode* node)
+{
+    if (!_Reflexes.erase_unsorted(node) || _GridCells == NULL)
+        return;
+    ImTriangulatorNode* next = _GridNext[node->Index];
+    ImTriangulatorNode* prev = _GridPrev[node->Index];
+    if (next)
+        _GridPrev[next->Index] = prev;
+    if (prev)
+        _GridNext[prev->Index] = next;
+    else
+        _GridCells[GetGridCell(node->Pos.y, _GridMin.y, _GridInvCellSize.y) * _GridSide + GetGridCell(node->Pos.x, _GridMin.x, _GridInvCellSize.x)] = next;
+}
+
+void ImTriangulator::ClearReflexes()
+{
+    _Reflexes.Size = 0;
+    if (_GridCells != NULL)
+        memset(_GridCells, 0, sizeof(ImTriangulatorNode*) * _GridSide * _GridSide);
+}
+
 void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
 {
     if (_Ears.Size == 0)
@@ -1916,7 +2361,7 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
         ImTriangulatorNode* node = _Nodes;
         for (int i = _TrianglesLeft; i >= 0; i--, node = node->Next)
             node->Type = ImTriangulatorNodeType_Convex;
-        _Reflexes.Size = 0;
+        ClearReflexes();
         BuildReflexes();
         BuildEars();
 
@@ -1925,8 +2370,7 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
         {
             // Return first triangle available, mimicking the behavior of convex fill.
             IM_ASSERT(_TrianglesLeft > 0); // Geometry is degenerated
-            _Ears.Data[0] = _Nodes;
-            _Ears.Size    = 1;
+            _Ears.push_back(_Nodes);
         }
     }
 
@@ -1969,6 +2413,8 @@ void ImTriangulator::FlipNodeList()
 // A triangle is an ear is no other vertex is inside it. We can test reflexes vertices only (see reference algorithm)
 bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
 {
+    if (_GridCells != NULL && _Reflexes.Size >= IM_TRIANGULATOR_GRID_MIN_REFLEXES)
+        return IsEarInGrid(i0, i1, i2, v0, v1, v2);
     ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
     for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
     {
@@ -1980,6 +2426,66 @@ bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec
     return true;
 }
 
+// Same test for large polygons, only visiting the grid cells overlapping the triangle.
+bool ImTriangulator::IsEarInGrid(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
+{
+    if (_Reflexes.Size == 0)
+        return true;
+    const int cx0 = GetGridCell(ImMin(ImMin(v0.x, v1.x), v2.x), _GridMin.x, _GridInvCellSize.x);
+    const int cx1 = GetGridCell(ImMax(ImMax(v0.x, v1.x), v2.x), _GridMin.x, _GridInvCellSize.x);
+    const int cy0 = GetGridCell(ImMin(ImMin(v0.y, v1.y), v2.y), _GridMin.y, _GridInvCellSize.y);
+    const int cy1 = GetGridCell(ImMax(ImMax(v0.y, v1.y), v2.y), _GridMin.y, _GridInvCellSize.y);
+    // Only visit the columns the triangle crosses in each row, from its edges clipped to the row (with some margin for rounding).
+    // Long thin triangles are common (the ears are clipped from a stack, so they fan out from a vertex), their bounding box is mostly empty.
+    const bool clip_rows = (cy0 != cy1 && _GridInvCellSize.y > 0.0f);
+    ImVec2 edge_a[3], edge_b[3];
+    float edge_slope[3];
+    if (clip_rows)
+    {
+        const ImVec2* v[3] = { &v0, &v1, &v2 };
+        for (int n = 0; n < 3; n++)
+        {
+            edge_a[n] = *v[n];
+            edge_b[n] = *v[n == 2 ? 0 : n + 1];
+            if (edge_a[n].y > edge_b[n].y)
+                ImSwap(edge_a[n], edge_b[n]);
+            edge_slope[n] = (edge_b[n].y > edge_a[n].y) ? (edge_b[n].x - edge_a[n].x) / (edge_b[n].y - edge_a[n].y) : 0.0f;
+        }
+    }
+    const float cell_h = clip_rows ? 1.0f / _GridInvCellSize.y : 0.0f;
+    for (int cy = cy0; cy <= cy1; cy++)
+    {
+        int row_cx0 = cx0, row_cx1 = cx1;
+        if (clip_rows)
+        {
+            const float row_y0 = _GridMin.y + (cy - 0.05f) * cell_h;
+            const float row_y1 = _GridMin.y + (cy + 1.05f) * cell_h;
+            float row_x0 = FLT_MAX, row_x1 = -FLT_MAX;
+            for (int n = 0; n < 3; n++)
+            {
+                const ImVec2& a = edge_a[n];
+                const ImVec2& b = edge_b[n];
+                if (b.y < row_y0 || a.y > row_y1)
+                    continue;
+                const float x0 = (a.y < row_y0) ? a.x + edge_slope[n] * (row_y0 - a.y) : a.x;
+                const float x1 = (b.y > row_y1) ? a.x + edge_slope[n] * (row_y1 - a.y) : b.x;
+                row_x0 = ImMin(row_x0, ImMin(x0, x1));
+                row_x1 = ImMax(row_x1, ImMax(x0, x1));
+            }
+            if (row_x0 > row_x1)
+                continue;
+            row_cx0 = ImMax(GetGridCell(row_x0, _GridMin.x, _GridInvCellSize.x) - 1, cx0);
+            row_cx1 = ImMin(GetGridCell(row_x1, _GridMin.x, _GridInvCellSize.x) + 1, cx1);
+        }
+        for (int cx = row_cx0; cx <= row_cx1; cx++)
+            for (ImTriangulatorNode* reflex = _GridCells[cy * _GridSide + cx]; reflex != NULL; reflex = _GridNext[reflex->Index])
+                if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+                    if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                        return false;
+    }
+    return true;
+}
+
 void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
 {
     // Classify node
@@ -1997,11 +2503,11 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     if (type == n1->Type)
         return;
     if (n1->Type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.find_erase_unsorted(n1->Index);
+        RemoveReflex(n1);
     else if (n1->Type == ImTriangulatorNodeType_Ear)
-        _Ears.find_erase_unsorted(n1->Index);
+        _Ears.erase_unsorted(n1);
     if (type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     else if (type == ImTriangulatorNodeType_Ear)
         _Ears.push_back(n1);
     n1->Type = type;
@@ -2023,16 +2529,12 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
     if (Flags & ImDrawListFlags_AntiAliasedFill)
     {
         // Anti-aliased Fill
-        const float AA_SIZE = _FringeScale;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
         const int idx_count = (points_count - 2) * 3 + points_count * 6;
         const int vtx_count = (points_count * 2);
         PrimReserve(idx_count, vtx_count);
 
         // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
-
+        const unsigned int vtx_inner_idx = _VtxCurrentIdx;
         _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
         triangulator.Init(points, points_count, _Data->TempBuffer.Data);
         while (triangulator._TrianglesLeft > 0)
@@ -2042,42 +2544,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
-
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
-        }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        // Add vertices and indexes for fringes (reusing the triangulator scratch buffer)
+        ImDrawListAddPolyFillFringe(this, points, points_count, col);
     }
     else
     {
@@ -2764,6 +3232,26 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
     builder->FrameCount = frame_count;
     for (ImFont* font : atlas->Fonts)
         font->LastBaked = NULL;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    // Like ImFontAtlasPagesEnabled(), the first context using the atlas decides
+    builder->Sdf.Enabled = false;
+    if (!builder->Sdf.Disabled)
+        for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+            if (ImGuiContext* imgui_ctx = shared_data->Context)
+            {
+                builder->Sdf.Enabled = (imgui_ctx->IO.BackendFlags & ImGuiBackendFlags_RendererHasDistanceFields) != 0;
+                break;
+            }
+#endif
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontAtlasGlyphRunsNewFrame(atlas);
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    ImFontAtlasTextSizesNewFrame(atlas);
+#endif
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    ImFontAtlasBudgetNewFrame(atlas); // Before the garbage collection: evicted bakes are removed right away
+#endif
 
     // Garbage collect BakedPool
     if (builder->BakedDiscardedCount > 0)
@@ -2784,6 +3272,9 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
         builder->BakedPool.Size -= builder->BakedDiscardedCount;
         builder->BakedDiscardedCount = 0;
     }
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAtlasAsyncGlyphsNewFrame(atlas); // After the garbage collection: jobs find their baked by id
+#endif
 
     // Update texture status
     for (int tex_n = 0; tex_n < atlas->TexList.Size; tex_n++)
@@ -3433,6 +3924,9 @@ void ImFontAtlasBuildSetupFontLoader(ImFontAtlas* atlas, const ImFontLoader* fon
 void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
 {
     atlas->Builder->PreloadedAllGlyphsRanges = true;
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAtlasAsyncGlyphsBuildBegin(atlas); // Pack here, rasterize on the glyph workers
+#endif
     for (ImFont* font : atlas->Fonts)
     {
         ImFontBaked* baked = font->GetFontBaked(font->LegacySize);
@@ -3448,6 +3942,9 @@ void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
                     baked->FindGlyph((ImWchar)c);
         }
     }
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAtlasAsyncGlyphsBuildEnd(atlas);
+#endif
 }
 
 // FIXME: May make ImFont::Sources a ImSpan<> and move ownership to ImFontAtlas
@@ -3778,6 +4275,12 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     }
     ImWchar c = (ImWchar)glyph->Codepoint;
     IM_ASSERT(font->FallbackChar != c && font->EllipsisChar != c); // Unsupported for simplicity
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontAtlasGlyphRunsClear(atlas);
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    ImFontAtlasTextSizesClear(atlas);
+#endif
     IM_ASSERT(glyph >= baked->Glyphs.Data && glyph < baked->Glyphs.Data + baked->Glyphs.Size);
     IM_UNUSED(font);
     baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
@@ -3828,6 +4331,10 @@ ImFontBaked* ImFontAtlasBakedGetClosestMatch(ImFontAtlas* atlas, ImFont* font, f
             ImFontBaked* baked = &builder->BakedPool[baked_n];
             if (baked->OwnerFont != font || baked->WantDestroy)
                 continue;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+            if (ImFontBakedIsDistanceField(baked) && font_rasterizer_density != 0.0f) // Left over from when distance fields were enabled, needs the backend's SDF path
+                continue;
+#endif
             if (step_n == 0 && baked->RasterizerDensity != font_rasterizer_density) // First try with same density
                 continue;
             if (baked->Size > font_size && (closest_larger_match == NULL || baked->Size < closest_larger_match->Size))
@@ -3871,6 +4378,12 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontAtlasGlyphRunsClear(atlas);
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    ImFontAtlasTextSizesClear(atlas);
+#endif
 }
 
 // use unused_frames==0 to discard everything.
@@ -3903,11 +4416,642 @@ void ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames)
     }
 }
 
-// Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
-void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+int ImFontAtlasBudgetGetMaxBytes(ImFontAtlas* atlas)
 {
-    IM_ASSERT(!atlas->DrawListSharedDatas.contains(data));
-    atlas->DrawListSharedDatas.push_back(data);
+    const int max_bytes = atlas->Builder->Budget.MaxBytes;
+    return (max_bytes > 0) ? max_bytes : IM_FONTATLASBUDGET_DEFAULT_BYTES;
+}
+
+int ImFontAtlasBudgetGetLiveBytes(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    return (builder->RectsPackedSurface - builder->RectsDiscardedSurface) * atlas->TexData->BytesPerPixel;
+}
+
+static ImGuiID ImFontAtlasBudgetGetGlyphKey(ImFontBaked* baked, unsigned int codepoint)
+{
+    return ImHashData(&codepoint, sizeof(codepoint), baked->BakedId);
+}
+
+// Remember an evicted glyph, to count it in Rerasterized if it gets loaded again
+static void ImFontAtlasBudgetAddEvicted(ImFontAtlasBudget* budget, ImFontBaked* baked, const ImFontGlyph& glyph)
+{
+    if (budget->Evicted.Data.Size >= IM_FONTATLASBUDGET_MAX_EVICTED_KEYS)
+        budget->Evicted.Clear();
+    budget->Evicted.SetInt(ImFontAtlasBudgetGetGlyphKey(baked, glyph.Codepoint), 1);
+}
+
+// Discard the least recently used bakes, last used before 'max_frame', until the live surface fits 'target_bytes'
+static void ImFontAtlasBudgetEvictBakes(ImFontAtlas* atlas, int max_frame, int target_bytes)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasBudget* budget = &builder->Budget;
+    while (ImFontAtlasBudgetGetLiveBytes(atlas) > target_bytes)
+    {
+        ImFontBaked* oldest = NULL;
+        for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        {
+            ImFontBaked* baked = &builder->BakedPool[baked_n];
+            if (baked->WantDestroy || baked->LastUsedFrame >= max_frame || (baked->OwnerFont->Flags & ImFontFlags_LockBakedSizes))
+                continue;
+            if (oldest == NULL || baked->LastUsedFrame < oldest->LastUsedFrame)
+                oldest = baked;
+        }
+        if (oldest == NULL)
+            return;
+        for (const ImFontGlyph& glyph : oldest->Glyphs)
+            if (glyph.PackId != ImFontAtlasRectId_Invalid)
+                ImFontAtlasBudgetAddEvicted(budget, oldest, glyph);
+        ImFontAtlasBakedDiscard(atlas, oldest->OwnerFont, oldest);
+        budget->EvictedBakes++;
+    }
+}
+
+// Remove evicted (and replaced) glyphs from baked->Glyphs[], reloading glyphs appends new entries and IndexLookup[] values are 16-bit.
+static void ImFontAtlasBudgetCompactGlyphs(ImFontBaked* baked)
+{
+    int dst_n = 0;
+    for (int src_n = 0; src_n < baked->Glyphs.Size; src_n++)
+    {
+        const ImFontGlyph glyph = baked->Glyphs[src_n];
+        const bool is_indexed = (baked->IndexLookup[glyph.Codepoint] == src_n);
+        const bool is_fallback = (baked->FallbackGlyphIndex == src_n);
+        if (!is_indexed && !is_fallback)
+            continue;
+        if (is_indexed)
+            baked->IndexLookup[glyph.Codepoint] = (ImU16)dst_n;
+        if (is_fallback)
+            baked->FallbackGlyphIndex = dst_n;
+        baked->Glyphs[dst_n++] = glyph;
+    }
+    baked->Glyphs.resize(dst_n);
+}
+
+struct ImFontAtlasBudgetGlyphRef
+{
+    int     LastUsedFrame;
+    int     BakedIdx;
+    int     GlyphIdx;
+};
+
+static int IMGUI_CDECL ImFontAtlasBudgetGlyphRefComparer(const void* lhs, const void* rhs)
+{
+    const ImFontAtlasBudgetGlyphRef* a = (const ImFontAtlasBudgetGlyphRef*)lhs;
+    const ImFontAtlasBudgetGlyphRef* b = (const ImFontAtlasBudgetGlyphRef*)rhs;
+    if (a->LastUsedFrame != b->LastUsedFrame)
+        return (a->LastUsedFrame < b->LastUsedFrame) ? -1 : +1;
+    if (a->BakedIdx != b->BakedIdx)
+        return (a->BakedIdx < b->BakedIdx) ? -1 : +1;
+    return (a->GlyphIdx < b->GlyphIdx) ? -1 : (a->GlyphIdx > b->GlyphIdx) ? +1 : 0;
+}
+
+// Evict the least recently rendered glyphs, last rendered before 'max_frame', until the live surface fits 'target_bytes'.
+// Only called between frames: glyph pointers and UVs don't cross frames.
+static void ImFontAtlasBudgetEvictGlyphs(ImFontAtlas* atlas, int max_frame, int target_bytes)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasBudget* budget = &builder->Budget;
+    ImVector<ImFontAtlasBudgetGlyphRef> refs;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        ImFont* font = baked->OwnerFont;
+        if (baked->WantDestroy || (font->Flags & ImFontFlags_LockBakedSizes))
+            continue;
+        for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
+        {
+            const ImFontGlyph& glyph = baked->Glyphs[glyph_n];
+            if (glyph.PackId == ImFontAtlasRectId_Invalid || glyph.LastUsedFrame >= max_frame)
+                continue;
+            if (glyph_n == baked->FallbackGlyphIndex || glyph.Codepoint == font->EllipsisChar || baked->IndexLookup[glyph.Codepoint] != glyph_n)
+                continue;
+            refs.push_back({ glyph.LastUsedFrame, baked_n, glyph_n });
+        }
+    }
+    if (refs.Size == 0)
+        return;
+    ImQsort(refs.Data, (size_t)refs.Size, sizeof(refs[0]), ImFontAtlasBudgetGlyphRefComparer);
+
+    for (const ImFontAtlasBudgetGlyphRef& ref : refs)
+    {
+        if (ImFontAtlasBudgetGetLiveBytes(atlas) <= target_bytes)
+            break;
+        ImFontBaked* baked = &builder->BakedPool[ref.BakedIdx];
+        ImFontGlyph* glyph = &baked->Glyphs[ref.GlyphIdx];
+        ImFontAtlasBudgetAddEvicted(budget, baked, *glyph);
+        ImFontAtlasPackDiscardRect(atlas, glyph->PackId);
+        glyph->PackId = ImFontAtlasRectId_Invalid;
+        baked->IndexLookup[glyph->Codepoint] = IM_FONTGLYPH_INDEX_UNUSED; // Keep IndexAdvanceX[], the advance doesn't change when loading it again
+        budget->EvictedGlyphs++;
+        budget->GlyphCompactPending = true;
+    }
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontAtlasGlyphRunsClear(atlas);
+#endif
+}
+
+// Called by ImFontAtlasUpdateNewFrame(), before the garbage collection of BakedPool
+void ImFontAtlasBudgetNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasBudget* budget = &builder->Budget;
+    ImTextureData* tex = atlas->TexData;
+    if (budget->Disabled || !atlas->RendererHasTextures || tex == NULL)
+    {
+        budget->GlyphSweepPending = false;
+        return;
+    }
+    const int max_bytes = ImFontAtlasBudgetGetMaxBytes(atlas);
+    const int frame_count = builder->FrameCount;
+
+    // Asynchronous results refer to glyphs by index, wait for them to be applied before compacting
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    if (budget->GlyphCompactPending && builder->AsyncGlyphs.PendingCount == 0)
+#else
+    if (budget->GlyphCompactPending)
+#endif
+    {
+        for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+            if (!builder->BakedPool[baked_n].WantDestroy)
+                ImFontAtlasBudgetCompactGlyphs(&builder->BakedPool[baked_n]);
+        budget->GlyphCompactPending = false;
+    }
+
+    // Evict down to 1/2 of the budget when 3/4 are used
+    if (budget->GlyphSweepPending)
+    {
+        budget->GlyphSweepPending = false;
+        ImFontAtlasBudgetEvictGlyphs(atlas, budget->GlyphSweepFrame, max_bytes / 2);
+    }
+    else if (ImFontAtlasBudgetGetLiveBytes(atlas) > max_bytes / 4 * 3)
+    {
+        ImFontAtlasBudgetEvictBakes(atlas, frame_count - 1, max_bytes / 2);
+        if (ImFontAtlasBudgetGetLiveBytes(atlas) > max_bytes / 2 && frame_count - budget->GlyphSweepFrame >= IM_FONTATLASBUDGET_INTERVAL_FRAMES)
+        {
+            budget->GlyphSweepFrame = frame_count;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+            if (!builder->GlyphRuns.Disabled)
+            {
+                // Glyphs replayed from the run cache don't update their timestamp: render one frame without it first
+                ImFontAtlasGlyphRunsClear(atlas);
+                budget->GlyphSweepPending = true;
+            }
+            else
+#endif
+            {
+                ImFontAtlasBudgetEvictGlyphs(atlas, frame_count - 1, max_bytes / 2);
+            }
+        }
+    }
+
+    // Reclaim the evicted space of a texture over the budget
+    if (tex->GetSizeInBytes() > max_bytes && frame_count - budget->LastDefragFrame >= IM_FONTATLASBUDGET_INTERVAL_FRAMES && !builder->LockDisableResize)
+    {
+        ImVec2i new_tex_size = ImFontAtlasTextureGetSizeEstimate(atlas);
+        if (new_tex_size.x * new_tex_size.y * tex->BytesPerPixel < tex->GetSizeInBytes())
+        {
+            ImFontAtlasTextureRepack(atlas, new_tex_size.x, new_tex_size.y);
+            budget->LastDefragFrame = frame_count;
+            budget->DefragCount++;
+        }
+    }
+}
+
+// Called by ImFontAtlasTextureMakeSpace() before the texture grows: evict bakes not used by the current frame instead of growing past the budget.
+// Glyphs can't be evicted in the middle of a frame.
+bool ImFontAtlasBudgetMakeSpace(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontAtlasBudget* budget = &builder->Budget;
+    ImTextureData* tex = atlas->TexData;
+    if (budget->Disabled || !atlas->RendererHasTextures)
+        return false;
+    const int max_bytes = ImFontAtlasBudgetGetMaxBytes(atlas);
+    int grown_bytes = tex->GetSizeInBytes() * 2;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    if (ImFontAtlasPagesCanAppend(atlas))
+        grown_bytes = tex->GetSizeInBytes() + tex->Width * tex->PageHeight * tex->BytesPerPixel;
+#endif
+    if (grown_bytes <= max_bytes)
+        return false;
+
+    ImFontAtlasBudgetEvictBakes(atlas, builder->FrameCount, max_bytes / 2);
+    const int live_surface = builder->RectsPackedSurface - builder->RectsDiscardedSurface;
+    if (builder->RectsDiscardedSurface == 0 || live_surface > tex->Width * tex->Height / 4 * 3)
+    {
+        budget->OverBudgetCount++;
+        return false;
+    }
+    ImFontAtlasTextureRepack(atlas, tex->Width, tex->Height);
+    budget->LastDefragFrame = builder->FrameCount;
+    budget->DefragCount++;
+    return true;
+}
+#endif
+
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+struct ImFontGlyphCacheFileHeader
+{
+    char                Magic[4];           // "IGDC"
+    ImU32               Version;            // IM_FONTGLYPHCACHE_VERSION
+    ImU32               EntrySize;          // sizeof(ImFontGlyphCacheEntry), catches layout differences
+    ImU32               EntryCount;
+};
+
+// Entries are padded to 4 bytes so the next one is aligned
+static size_t ImFontGlyphCacheEntryGetSize(const ImFontGlyphCacheEntry* entry)
+{
+    return sizeof(ImFontGlyphCacheEntry) + (((size_t)entry->Width * entry->Height + 3) & ~(size_t)3);
+}
+
+// A glyph that couldn't fit in the atlas texture is garbage (also keeps the Width * Height bytes far from any overflow)
+static bool ImFontGlyphCacheEntryIsValid(ImFontAtlas* atlas, const ImFontGlyphCacheEntry* entry, size_t remaining_size)
+{
+    if ((entry->Width == 0) != (entry->Height == 0) || entry->Width > atlas->TexMaxWidth || entry->Height > atlas->TexMaxHeight)
+        return false;
+    if (ImAbs((int)entry->X0) > atlas->TexMaxWidth || ImAbs((int)entry->Y0) > atlas->TexMaxHeight)
+        return false;
+    return ImFontGlyphCacheEntryGetSize(entry) <= remaining_size;
+}
+
+// Keep the entries that are complete and valid, up to the first one that isn't (the tail is dropped)
+static void ImFontAtlasGlyphCacheLoad(ImFontAtlas* atlas)
+{
+    ImFontGlyphCache* cache = &atlas->Builder->GlyphCache;
+    cache->Loaded = true;
+    ImFileHandle f = ImFileOpen(atlas->GlyphCacheFilename, "rb");
+    if (f == NULL)
+        return;
+    ImFontGlyphCacheFileHeader header;
+    const ImU64 file_size = ImFileGetSize(f);
+    if (file_size == (ImU64)-1 || file_size < sizeof(header) || ImFileRead(&header, 1, sizeof(header), f) != sizeof(header) ||
+        memcmp(header.Magic, "IGDC", 4) != 0 || header.Version != IM_FONTGLYPHCACHE_VERSION || header.EntrySize != sizeof(ImFontGlyphCacheEntry))
+    {
+        ImFileClose(f);
+        return;
+    }
+    cache->Data.resize((int)ImMin(file_size - sizeof(header), (ImU64)IM_FONTGLYPHCACHE_MAX_BYTES));
+    const int data_size = (int)ImFileRead(cache->Data.Data, 1, (ImU64)cache->Data.Size, f);
+    ImFileClose(f);
+
+    int offset = 0;
+    while ((ImU32)cache->EntryCount < header.EntryCount && offset + (int)sizeof(ImFontGlyphCacheEntry) <= data_size)
+    {
+        const ImFontGlyphCacheEntry* entry = (const ImFontGlyphCacheEntry*)(const void*)(cache->Data.Data + offset);
+        if (!ImFontGlyphCacheEntryIsValid(atlas, entry, (size_t)(data_size - offset)))
+            break;
+        cache->Map.SetInt(entry->KeyLo, offset);
+        cache->EntryCount++;
+        offset += (int)ImFontGlyphCacheEntryGetSize(entry);
+    }
+    cache->Data.resize(offset);
+    cache->LoadedCount = cache->EntryCount;
+    cache->Dirty = ((ImU32)cache->EntryCount != header.EntryCount || offset != (int)(file_size - sizeof(header))); // Rewrite it without the bad tail
+}
+
+// The returned entry is valid until the next ImFontAtlasGlyphCacheAdd()
+const ImFontGlyphCacheEntry* ImFontAtlasGlyphCacheFind(ImFontAtlas* atlas, ImU32 key_lo, ImU32 key_hi)
+{
+    ImFontGlyphCache* cache = &atlas->Builder->GlyphCache;
+    if (cache->Disabled || atlas->GlyphCacheFilename == NULL)
+        return NULL;
+    if (!cache->Loaded)
+        ImFontAtlasGlyphCacheLoad(atlas);
+    const int offset = cache->Map.GetInt(key_lo, -1);
+    const ImFontGlyphCacheEntry* entry = (offset != -1) ? (const ImFontGlyphCacheEntry*)(const void*)(cache->Data.Data + offset) : NULL;
+    if (entry == NULL || entry->KeyHi != key_hi)
+    {
+        cache->Misses++;
+        return NULL;
+    }
+    cache->Hits++;
+    return entry;
+}
+
+void ImFontAtlasGlyphCacheAdd(ImFontAtlas* atlas, const ImFontGlyphCacheEntry& entry, const unsigned char* pixels)
+{
+    ImFontGlyphCache* cache = &atlas->Builder->GlyphCache;
+    if (cache->Disabled || atlas->GlyphCacheFilename == NULL || !cache->Loaded)
+        return;
+    if (cache->Map.GetInt(entry.KeyLo, -1) != -1) // Already there, or a KeyLo collision: keep the first one
+        return;
+    const size_t entry_size = ImFontGlyphCacheEntryGetSize(&entry);
+    if ((size_t)cache->Data.Size + entry_size > IM_FONTGLYPHCACHE_MAX_BYTES)
+        return;
+    const int offset = cache->Data.Size;
+    cache->Data.resize(offset + (int)entry_size);
+    memset(cache->Data.Data + offset, 0, entry_size);
+    memcpy(cache->Data.Data + offset, &entry, sizeof(entry));
+    if (entry.Width != 0)
+        memcpy(cache->Data.Data + offset + sizeof(entry), pixels, (size_t)entry.Width * entry.Height);
+    cache->Map.SetInt(entry.KeyLo, offset);
+    cache->EntryCount++;
+    cache->Dirty = true;
+}
+
+bool ImFontAtlasGlyphCacheSave(ImFontAtlas* atlas)
+{
+    ImFontGlyphCache* cache = atlas->Builder ? &atlas->Builder->GlyphCache : NULL;
+    if (cache == NULL || !cache->Dirty || atlas->GlyphCacheFilename == NULL)
+        return false;
+    ImFileHandle f = ImFileOpen(atlas->GlyphCacheFilename, "wb");
+    if (f == NULL)
+        return false;
+    ImFontGlyphCacheFileHeader header = { { 'I', 'G', 'D', 'C' }, IM_FONTGLYPHCACHE_VERSION, (ImU32)sizeof(ImFontGlyphCacheEntry), (ImU32)cache->EntryCount };
+    const bool ok = ImFileWrite(&header, 1, sizeof(header), f) == sizeof(header) && ImFileWrite(cache->Data.Data, 1, (ImU64)cache->Data.Size, f) == (ImU64)cache->Data.Size;
+    ImFileClose(f);
+    if (!ok)
+        return false;
+    cache->Dirty = false;
+    cache->SaveCount++;
+    return true;
+}
+#endif
+
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+// Drop the runs last used before 'min_frame', moving the others down in place so the buffers keep their capacity.
+static void ImFontGlyphRunCacheCompact(ImFontGlyphRunCache* cache, int min_frame)
+{
+    int dst_n = 0, vtx_n = 0, idx_n = 0, text_n = 0;
+    cache->Map.Data.resize(0);
+    for (int src_n = 0; src_n < cache->Runs.Size; src_n++)
+    {
+        ImFontGlyphRun run = cache->Runs[src_n];
+        if (run.LastUsedFrame < min_frame)
+            continue;
+        memmove(cache->Vtx.Data + vtx_n, cache->Vtx.Data + run.VtxOffset, (size_t)run.VtxCount * sizeof(ImDrawVert));
+        memmove(cache->Idx.Data + idx_n, cache->Idx.Data + run.IdxOffset, (size_t)run.IdxCount * sizeof(ImDrawIdx));
+        memmove(cache->Text.Data + text_n, cache->Text.Data + run.TextOffset, (size_t)run.TextLength);
+        run.VtxOffset = vtx_n;
+        run.IdxOffset = idx_n;
+        run.TextOffset = text_n;
+        vtx_n += run.VtxCount;
+        idx_n += run.IdxCount;
+        text_n += run.TextLength;
+        cache->Map.Data.push_back(ImGuiStoragePair(run.Key, dst_n));
+        cache->Runs[dst_n++] = run;
+    }
+    cache->Runs.resize(dst_n);
+    cache->Vtx.resize(vtx_n);
+    cache->Idx.resize(idx_n);
+    cache->Text.resize(text_n);
+    cache->Map.BuildSortByKey();
+}
+
+static int ImFontGlyphRunCacheGetBudget(const ImFontGlyphRunCache* cache)
+{
+    return cache->BudgetBytes > 0 ? cache->BudgetBytes : IM_FONTGLYPHRUN_DEFAULT_BUDGET;
+}
+
+// Called when glyph UVs may have changed (repack, discarded bakes or glyphs).
+void ImFontAtlasGlyphRunsClear(ImFontAtlas* atlas)
+{
+    if (atlas->Builder == NULL)
+        return;
+    ImFontGlyphRunCache* cache = &atlas->Builder->GlyphRuns;
+    ImFontGlyphRunCacheCompact(cache, INT_MAX);
+    cache->Generation++;
+    cache->ClearCount++;
+}
+
+void ImFontAtlasGlyphRunsNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontGlyphRunCache* cache = &builder->GlyphRuns;
+    cache->LastFrameHits = cache->FrameHits;
+    cache->LastFrameMisses = cache->FrameMisses;
+    cache->FrameHits = cache->FrameMisses = 0;
+
+    // Candidates are only useful if they come back soon, texts changing every frame would grow this forever
+    if (cache->Seen.Data.Size > 4096)
+    {
+        cache->Seen.Data.resize(0);
+        cache->Seen.BuildSortByKey();
+    }
+
+    // Discard unused runs from time to time, or right away when close to the budget (then only keep the runs of the last frame)
+    int min_frame = builder->FrameCount - IM_FONTGLYPHRUN_UNUSED_FRAMES;
+    if (cache->GetResidentBytes() >= ImFontGlyphRunCacheGetBudget(cache) / 4 * 3)
+        min_frame = builder->FrameCount - 1;
+    else if ((builder->FrameCount % IM_FONTGLYPHRUN_UNUSED_FRAMES) != 0)
+        return;
+    for (const ImFontGlyphRun& run : cache->Runs)
+        if (run.LastUsedFrame < min_frame)
+        {
+            ImFontGlyphRunCacheCompact(cache, min_frame);
+            break;
+        }
+}
+
+static ImGuiID ImFontGlyphRunCacheGetKey(ImFontBaked* baked, float size, float wrap_width, ImDrawTextFlags flags, const char* text_begin, const char* text_end)
+{
+    struct { ImGuiID BakedId; float Size; float WrapWidth; int Flags; } header = { baked->BakedId, size, ImMax(wrap_width, 0.0f), flags & ~ImDrawTextFlags_CpuFineClip };
+    return ImHashData(text_begin, (size_t)(text_end - text_begin), ImHashData(&header, sizeof(header)));
+}
+
+static ImFontGlyphRun* ImFontGlyphRunCacheFind(ImFontGlyphRunCache* cache, ImGuiID key, const char* text_begin, const char* text_end)
+{
+    const int run_n = cache->Map.GetInt(key, -1);
+    if (run_n < 0)
+        return NULL;
+    ImFontGlyphRun* run = &cache->Runs[run_n];
+    if (run->TextLength != (int)(text_end - text_begin) || memcmp(cache->Text.Data + run->TextOffset, text_begin, (size_t)run->TextLength) != 0)
+        return NULL; // Hash collision
+    return run;
+}
+
+// Store the vertices/indices RenderText() just emitted, relative to 'origin' and to their first vertex.
+// 'colored_col' is the color of colored (untinted) glyphs, 0 if there were none.
+static void ImFontGlyphRunCacheAdd(ImFontGlyphRunCache* cache, ImGuiID key, int frame_count, const char* text_begin, const char* text_end, const ImVec2& origin, const ImDrawVert* vtx, int vtx_count, const ImDrawIdx* idx, int idx_count, unsigned int vtx_index, ImU32 colored_col)
+{
+    if (cache->Map.GetInt(key, -1) >= 0)
+        return; // Already cached, or a hash collision with a different text: keep the first one
+    if (cache->GetResidentBytes() + (int)(sizeof(ImFontGlyphRun) + vtx_count * sizeof(ImDrawVert) + idx_count * sizeof(ImDrawIdx)) + (int)(text_end - text_begin) > ImFontGlyphRunCacheGetBudget(cache))
+        return; // Full, wait for ImFontAtlasGlyphRunsNewFrame() to discard unused runs
+    ImFontGlyphRun run;
+    run.Key = key;
+    run.TextOffset = cache->Text.Size;
+    run.TextLength = (int)(text_end - text_begin);
+    run.VtxOffset = cache->Vtx.Size;
+    run.VtxCount = vtx_count;
+    run.IdxOffset = cache->Idx.Size;
+    run.IdxCount = idx_count;
+    run.Min = run.Max = ImVec2(0.0f, 0.0f);
+    run.LastUsedFrame = frame_count;
+
+    cache->Text.resize(cache->Text.Size + run.TextLength);
+    memcpy(cache->Text.Data + run.TextOffset, text_begin, (size_t)run.TextLength);
+    cache->Vtx.resize(cache->Vtx.Size + vtx_count);
+    ImDrawVert* vtx_dst = cache->Vtx.Data + run.VtxOffset;
+    if (vtx_count > 0)
+        run.Min = run.Max = ImVec2(vtx[0].pos.x - origin.x, vtx[0].pos.y - origin.y);
+    for (int n = 0; n < vtx_count; n++)
+    {
+        vtx_dst[n].pos = ImVec2(vtx[n].pos.x - origin.x, vtx[n].pos.y - origin.y);
+        vtx_dst[n].uv = vtx[n].uv;
+        vtx_dst[n].col = (colored_col != 0 && vtx[n].col == colored_col) ? 1 : 0;
+        run.Min = ImMin(run.Min, vtx_dst[n].pos);
+        run.Max = ImMax(run.Max, vtx_dst[n].pos);
+    }
+    cache->Idx.resize(cache->Idx.Size + idx_count);
+    ImDrawIdx* idx_dst = cache->Idx.Data + run.IdxOffset;
+    for (int n = 0; n < idx_count; n++)
+        idx_dst[n] = (ImDrawIdx)(idx[n] - vtx_index);
+
+    cache->Map.SetInt(key, cache->Runs.Size);
+    cache->Runs.push_back(run);
+}
+
+static void ImFontGlyphRunCacheBlit(const ImFontGlyphRunCache* cache, const ImFontGlyphRun* run, ImDrawList* draw_list, float x, float y, ImU32 col)
+{
+    if (run->VtxCount == 0)
+        return;
+    draw_list->PrimReserve(run->IdxCount, run->VtxCount);
+    const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
+    const ImDrawVert* vtx_src = cache->Vtx.Data + run->VtxOffset;
+    ImDrawVert* vtx_write = draw_list->_VtxWritePtr;
+    for (int n = 0; n < run->VtxCount; n++)
+    {
+        vtx_write[n].pos.x = vtx_src[n].pos.x + x;
+        vtx_write[n].pos.y = vtx_src[n].pos.y + y;
+        vtx_write[n].uv = vtx_src[n].uv;
+        vtx_write[n].col = vtx_src[n].col ? col_untinted : col;
+    }
+    const ImDrawIdx* idx_src = cache->Idx.Data + run->IdxOffset;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    const unsigned int vtx_index = draw_list->_VtxCurrentIdx;
+    for (int n = 0; n < run->IdxCount; n++)
+        idx_write[n] = (ImDrawIdx)(idx_src[n] + vtx_index);
+    draw_list->_VtxWritePtr += run->VtxCount;
+    draw_list->_IdxWritePtr += run->IdxCount;
+    draw_list->_VtxCurrentIdx += run->VtxCount;
+}
+#endif // #ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+// Drop the entries last used before 'min_frame', moving the others down in place.
+static void ImFontTextSizeCacheCompact(ImFontTextSizeCache* cache, int min_frame)
+{
+    int dst_n = 0, text_n = 0;
+    cache->Map.Data.resize(0);
+    for (int src_n = 0; src_n < cache->Entries.Size; src_n++)
+    {
+        ImFontTextSizeEntry entry = cache->Entries[src_n];
+        if (entry.LastUsedFrame < min_frame)
+            continue;
+        memmove(cache->Text.Data + text_n, cache->Text.Data + entry.TextOffset, (size_t)entry.TextLength);
+        entry.TextOffset = text_n;
+        text_n += entry.TextLength;
+        cache->Map.Data.push_back(ImGuiStoragePair(entry.Key, dst_n));
+        cache->Entries[dst_n++] = entry;
+    }
+    if (min_frame != INT_MAX)
+        cache->EvictedCount += cache->Entries.Size - dst_n;
+    cache->Entries.resize(dst_n);
+    cache->Text.resize(text_n);
+    cache->Map.BuildSortByKey();
+}
+
+static int ImFontTextSizeCacheGetBudget(const ImFontTextSizeCache* cache)
+{
+    return cache->BudgetBytes > 0 ? cache->BudgetBytes : IM_FONTTEXTSIZE_DEFAULT_BUDGET;
+}
+
+// Called when glyph advances may have changed (discarded bakes or glyphs).
+void ImFontAtlasTextSizesClear(ImFontAtlas* atlas)
+{
+    if (atlas->Builder == NULL)
+        return;
+    ImFontTextSizeCache* cache = &atlas->Builder->TextSizes;
+    ImFontTextSizeCacheCompact(cache, INT_MAX);
+    cache->ClearCount++;
+}
+
+static int IMGUI_CDECL ImFontTextSizeCacheAgeComparer(const void* lhs, const void* rhs)
+{
+    // Most recently used first
+    const int lhs_frame = ((const ImVec2i*)lhs)->x;
+    const int rhs_frame = ((const ImVec2i*)rhs)->x;
+    return (lhs_frame > rhs_frame) ? -1 : (lhs_frame < rhs_frame) ? +1 : 0;
+}
+
+void ImFontAtlasTextSizesNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImFontTextSizeCache* cache = &builder->TextSizes;
+    cache->LastFrameHits = cache->FrameHits;
+    cache->LastFrameMisses = cache->FrameMisses;
+    cache->FrameHits = cache->FrameMisses = 0;
+
+    // Evict least recently used frames until we are back to half of the budget, always keeping the last frame
+    const int budget = ImFontTextSizeCacheGetBudget(cache);
+    if (cache->GetResidentBytes() < budget / 4 * 3)
+        return;
+    ImVector<ImVec2i> ages; // (frame, bytes)
+    ages.resize(cache->Entries.Size);
+    const int entry_bytes = (int)(sizeof(ImFontTextSizeEntry) + sizeof(ImGuiStoragePair));
+    for (int n = 0; n < cache->Entries.Size; n++)
+        ages[n] = ImVec2i(cache->Entries[n].LastUsedFrame, entry_bytes + cache->Entries[n].TextLength);
+    ImQsort(ages.Data, (size_t)ages.Size, sizeof(ImVec2i), ImFontTextSizeCacheAgeComparer);
+    int min_frame = builder->FrameCount - 1;
+    int kept_bytes = 0;
+    for (const ImVec2i& age : ages)
+    {
+        if (age.x < min_frame && kept_bytes + age.y > budget / 2)
+            break;
+        min_frame = ImMin(min_frame, age.x);
+        kept_bytes += age.y;
+    }
+    ImFontTextSizeCacheCompact(cache, min_frame);
+}
+
+// Returns false when 'text' is not cacheable or not in the cache, 'out_key' is then what to pass to ImFontTextSizeCacheAdd() (0: not cacheable).
+static bool ImFontTextSizeCacheFind(ImFontTextSizeCache* cache, int frame_count, ImFontBaked* baked, float size, float wrap_width, const char* text_begin, const char* text_end, ImGuiID* out_key, ImVec2* out_size)
+{
+    *out_key = 0;
+    if (cache->Disabled || text_end - text_begin > IM_FONTTEXTSIZE_MAX_TEXT_LENGTH)
+        return false;
+    struct { ImGuiID BakedId; float Size; float WrapWidth; } header = { baked->BakedId, size, ImMax(wrap_width, 0.0f) };
+    const ImGuiID key = ImHashData(text_begin, (size_t)(text_end - text_begin), ImHashData(&header, sizeof(header)));
+    *out_key = key;
+    const int entry_n = cache->Map.GetInt(key, -1);
+    if (entry_n < 0)
+        return false;
+    ImFontTextSizeEntry* entry = &cache->Entries[entry_n];
+    if (entry->TextLength != (int)(text_end - text_begin) || memcmp(cache->Text.Data + entry->TextOffset, text_begin, (size_t)entry->TextLength) != 0)
+    {
+        *out_key = 0; // Hash collision, keep the first one
+        return false;
+    }
+    entry->LastUsedFrame = frame_count;
+    *out_size = entry->Size;
+    return true;
+}
+
+static void ImFontTextSizeCacheAdd(ImFontTextSizeCache* cache, ImGuiID key, int frame_count, const char* text_begin, const char* text_end, const ImVec2& text_size)
+{
+    const int text_length = (int)(text_end - text_begin);
+    if (cache->GetResidentBytes() + (int)(sizeof(ImFontTextSizeEntry) + sizeof(ImGuiStoragePair)) + text_length > ImFontTextSizeCacheGetBudget(cache))
+        return; // Full, wait for ImFontAtlasTextSizesNewFrame() to evict old entries
+    ImFontTextSizeEntry entry;
+    entry.Key = key;
+    entry.TextOffset = cache->Text.Size;
+    entry.TextLength = text_length;
+    entry.Size = text_size;
+    entry.LastUsedFrame = frame_count;
+    cache->Text.resize(cache->Text.Size + text_length);
+    memcpy(cache->Text.Data + entry.TextOffset, text_begin, (size_t)text_length);
+    cache->Map.SetInt(key, cache->Entries.Size);
+    cache->Entries.push_back(entry);
+}
+#endif // #ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+
+// Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
+void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+{
+    IM_ASSERT(!atlas->DrawListSharedDatas.contains(data));
+    atlas->DrawListSharedDatas.push_back(data);
 }
 
 void ImFontAtlasRemoveDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
@@ -3953,12 +5097,36 @@ void ImFontAtlasUpdateDrawListsSharedData(ImFontAtlas* atlas)
         }
 }
 
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+static int ImFontAtlasPagesGetPageSize(ImFontAtlas* atlas)
+{
+    const int page_size = atlas->Builder->Pages.PageSize > 0 ? atlas->Builder->Pages.PageSize : IM_FONTATLASPAGES_DEFAULT_PAGE_SIZE;
+    IM_ASSERT(ImIsPowerOfTwo(page_size));
+    return page_size;
+}
+
+// Like ImFontAtlasBuildUpdateRendererHasTexturesFromContext(), this is only checked when the texture needs space
+static bool ImFontAtlasPagesEnabled(ImFontAtlas* atlas)
+{
+    if (atlas->Builder == NULL || atlas->Builder->Pages.Disabled)
+        return false;
+    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+        if (ImGuiContext* imgui_ctx = shared_data->Context)
+            return (imgui_ctx->IO.BackendFlags & ImGuiBackendFlags_RendererHasTexturePages) != 0;
+    return false;
+}
+#endif
+
 // Set current texture. This is mostly called from AddTexture() + to handle a failed resize.
 static void ImFontAtlasBuildSetTexture(ImFontAtlas* atlas, ImTextureData* tex)
 {
     ImTextureRef old_tex_ref = atlas->TexRef;
     atlas->TexData = tex;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    atlas->TexUvScale = ImVec2(1.0f / tex->Width, 1.0f / tex->PageHeight); // V in page units, doesn't change when pages are appended
+#else
     atlas->TexUvScale = ImVec2(1.0f / tex->Width, 1.0f / tex->Height);
+#endif
     atlas->TexRef._TexData = tex;
     //atlas->TexRef._TexID = tex->TexID; // <-- We intentionally don't do that. It would be misleading and betray promise that both fields aren't set.
     ImFontAtlasUpdateDrawListsTextures(atlas, old_tex_ref, atlas->TexRef);
@@ -3996,6 +5164,11 @@ ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
 
     new_tex->Create(atlas->TexDesiredFormat, w, h);
     atlas->TexIsBuilt = false;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    // Textures taller than a page (repack of a paged texture, compact) are split in pages
+    const int page_size = ImFontAtlasPagesEnabled(atlas) ? ImFontAtlasPagesGetPageSize(atlas) : h;
+    new_tex->PageHeight = (h > page_size && (h % page_size) == 0) ? page_size : h;
+#endif
 
     ImFontAtlasBuildSetTexture(atlas, new_tex);
 
@@ -4018,10 +5191,16 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
     builder->LockDisableResize = true;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontAtlasGlyphRunsClear(atlas);
+#endif
 
     ImTextureData* old_tex = atlas->TexData;
     ImTextureData* new_tex = ImFontAtlasTextureAdd(atlas, w, h);
     new_tex->UseColors = old_tex->UseColors;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    builder->Pages.RepackCount++;
+#endif
     IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: resize+repack %dx%d => Texture #%03d: %dx%d\n", old_tex->UniqueID, old_tex->Width, old_tex->Height, new_tex->UniqueID, new_tex->Width, new_tex->Height);
     //for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
     //    IMGUI_DEBUG_LOG_FONT("[font] - Baked %.2fpx, %d glyphs, want_destroy=%d\n", builder->BakedPool[baked_n].FontSize, builder->BakedPool[baked_n].Glyphs.Size, builder->BakedPool[baked_n].WantDestroy);
@@ -4075,6 +5254,13 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
                 glyph.V0 = (r->y) * atlas->TexUvScale.y;
                 glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
                 glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+                if (ImFontBakedIsDistanceField(&builder->BakedPool[baked_n]))
+                {
+                    glyph.U0 += IM_FONTSDF_UV_OFFSET;
+                    glyph.U1 += IM_FONTSDF_UV_OFFSET;
+                }
+#endif
             }
 
     // Update other cached UV
@@ -4094,6 +5280,9 @@ void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
         old_tex_w = atlas->TexData->Width;
     if (old_tex_h == -1)
         old_tex_h = atlas->TexData->Height;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    old_tex_h = ImUpperPowerOfTwo(old_tex_h); // Any number of pages
+#endif
 
     // FIXME-NEWATLAS-V2: What to do when reaching limits exposed by backend?
     // FIXME-NEWATLAS-V2: Does ImFontAtlasFlags_NoPowerOfTwoHeight makes sense now? Allow 'lock' and 'compact' operations?
@@ -4125,6 +5314,20 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 2);
 
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    if (ImFontAtlasBudgetMakeSpace(atlas))
+        return;
+#endif
+
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    // Paged texture: appending doesn't upload anything again, so it is preferred to a repack until the texture reaches TexMaxHeight.
+    if (ImFontAtlasPagesCanAppend(atlas))
+    {
+        ImFontAtlasTextureAppendPage(atlas);
+        return;
+    }
+#endif
+
     // Currently using a heuristic for repack without growing.
     if (builder->RectsDiscardedSurface < builder->RectsPackedSurface * 0.20f)
         ImFontAtlasTextureGrow(atlas);
@@ -4132,17 +5335,79 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
         ImFontAtlasTextureRepack(atlas, atlas->TexData->Width, atlas->TexData->Height);
 }
 
-ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+// Full page size reached, the largest rectangle fits a page and there is room for another page
+bool ImFontAtlasPagesCanAppend(ImFontAtlas* atlas)
 {
-    int min_w = ImUpperPowerOfTwo(atlas->TexMinWidth);
-    int min_h = ImUpperPowerOfTwo(atlas->TexMinHeight);
-    if (atlas->Builder == NULL || atlas->TexData == NULL || atlas->TexData->Status == ImTextureStatus_WantDestroy)
-        return ImVec2i(min_w, min_h);
-
     ImFontAtlasBuilder* builder = atlas->Builder;
-    min_w = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.x), min_w);
-    min_h = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.y), min_h);
-    const int surface_approx = builder->RectsPackedSurface - builder->RectsDiscardedSurface; // Expected surface after repack
+    ImTextureData* tex = atlas->TexData;
+    if (!ImFontAtlasPagesEnabled(atlas) || builder->LockDisableResize)
+        return false;
+    const int page_size = ImFontAtlasPagesGetPageSize(atlas);
+    const int pack_padding = atlas->TexGlyphPadding;
+    if (tex->Width < page_size || tex->PageHeight < page_size || (tex->Height % tex->PageHeight) != 0)
+        return false;
+    if (builder->MaxRectSize.x + pack_padding > tex->Width || builder->MaxRectSize.y + pack_padding > tex->PageHeight)
+        return false;
+    return tex->Height + tex->PageHeight <= ImMin(atlas->TexMaxHeight, 0x8000); // ImTextureRect coordinates are 16-bit
+}
+
+// Add a page below the existing ones and continue packing there. Nothing else moves: glyph UVs, draw lists and the backend texture
+// contents stay valid, the new page is uploaded through Updates[] as rectangles get used.
+void ImFontAtlasTextureAppendPage(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* tex = atlas->TexData;
+    IM_ASSERT(tex->PageHeight > 0 && (tex->Height % tex->PageHeight) == 0);
+    IM_ASSERT(tex->Status != ImTextureStatus_WantDestroy && tex->Status != ImTextureStatus_Destroyed);
+    const int old_size = tex->GetSizeInBytes();
+    const int new_h = tex->Height + tex->PageHeight;
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: append page %dx%d => %d pages\n", tex->UniqueID, tex->Width, tex->PageHeight, new_h / tex->PageHeight);
+
+    // Pages are stacked in the pixel buffer, existing pixels keep their offsets
+    unsigned char* new_pixels = (unsigned char*)IM_ALLOC(tex->Width * new_h * tex->BytesPerPixel);
+    IM_ASSERT(new_pixels != NULL);
+    memcpy(new_pixels, tex->Pixels, old_size);
+    memset(new_pixels + old_size, 0, tex->Width * tex->PageHeight * tex->BytesPerPixel);
+    IM_FREE(tex->Pixels);
+    tex->Pixels = new_pixels;
+    tex->Height = new_h;
+    if (tex->Status == ImTextureStatus_OK)
+        tex->Status = ImTextureStatus_WantUpdates; // Backend resizes, possibly with no update queued yet
+    atlas->TexIsBuilt = false;
+
+    builder->Pages.AppendCount++;
+    builder->Pages.PackPage = new_h / tex->PageHeight - 1;
+    stbrp_init_target((stbrp_context*)(void*)&builder->PackContext, tex->Width, tex->PageHeight, builder->PackNodes.Data, builder->PackNodes.Size);
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    ImFontAtlasShelfPackerAddRows(atlas, new_h - tex->PageHeight, new_h);
+#endif
+}
+
+// Move the packer to the next page of the texture (when repacking into several pages), previous pages are considered full
+static bool ImFontAtlasPackNextPage(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* tex = atlas->TexData;
+    if ((builder->Pages.PackPage + 1) * tex->PageHeight >= tex->Height)
+        return false;
+    builder->Pages.PackPage++;
+    stbrp_init_target((stbrp_context*)(void*)&builder->PackContext, tex->Width, tex->PageHeight, builder->PackNodes.Data, builder->PackNodes.Size);
+    return true;
+}
+#endif
+
+ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
+{
+    int min_w = ImUpperPowerOfTwo(atlas->TexMinWidth);
+    int min_h = ImUpperPowerOfTwo(atlas->TexMinHeight);
+    if (atlas->Builder == NULL || atlas->TexData == NULL || atlas->TexData->Status == ImTextureStatus_WantDestroy)
+        return ImVec2i(min_w, min_h);
+
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    min_w = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.x), min_w);
+    min_h = ImMax(ImUpperPowerOfTwo(builder->MaxRectSize.y), min_h);
+    const int surface_approx = builder->RectsPackedSurface - builder->RectsDiscardedSurface; // Expected surface after repack
     const int surface_sqrt = (int)sqrtf((float)surface_approx);
 
     int new_tex_w;
@@ -4243,6 +5508,12 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 // Destroy builder and all cached glyphs. Do not destroy actual fonts.
 void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
 {
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAtlasAsyncGlyphsShutdown(atlas);
+#endif
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    ImFontAtlasGlyphCacheSave(atlas);
+#endif
     for (ImFont* font : atlas->Fonts)
         ImFontAtlasFontDestroyOutput(atlas, font);
     if (atlas->Builder && atlas->FontLoader && atlas->FontLoader->LoaderShutdown)
@@ -4254,6 +5525,370 @@ void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
     atlas->Builder = NULL;
 }
 
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+static int ImFontAtlasShelfGetClassHeight(int h)
+{
+    const int step = ImMax(IM_FONTATLASSHELF_MIN_HEIGHT_STEP, ImUpperPowerOfTwo(h) / 8);
+    return (h + step - 1) / step * step;
+}
+
+// Power of two bin of a span width or a rows height
+static int ImFontAtlasShelfGetBin(int v)
+{
+    IM_ASSERT(v > 0 && v < (1 << IM_FONTATLASSHELF_BIN_COUNT));
+    int bin = 0;
+    while (v >>= 1)
+        bin++;
+    return bin;
+}
+
+// Bins holding values >= 'v' for sure: above the bin of 'v'
+static inline ImU32 ImFontAtlasShelfGetWiderBins(ImU32 bin_mask, int v) { return bin_mask & ~((2u << ImFontAtlasShelfGetBin(v)) - 1); }
+static inline int   ImFontAtlasShelfGetLowestBin(ImU32 bin_mask)         { return (int)ImCountSetBits((bin_mask & (~bin_mask + 1)) - 1); }
+
+// Index of the first class at or above 'class_h' in Classes[]
+static int ImFontAtlasShelfFindClass(ImFontAtlasShelfPacker* packer, int class_h)
+{
+    int lo = 0, hi = packer->Classes.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (packer->Classes.Data[mid].Height < class_h)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static ImFontAtlasShelfClass* ImFontAtlasShelfGetClass(ImFontAtlasShelfPacker* packer, int class_h)
+{
+    const int class_n = ImFontAtlasShelfFindClass(packer, class_h);
+    if (class_n < packer->Classes.Size && packer->Classes[class_n].Height == class_h)
+        return &packer->Classes[class_n];
+    ImFontAtlasShelfClass shelf_class;
+    shelf_class.Height = class_h;
+    shelf_class.BinMask = 0;
+    for (int& span_idx : shelf_class.Bins)
+        span_idx = -1;
+    return packer->Classes.insert(packer->Classes.Data + class_n, shelf_class);
+}
+
+// A span of that class at least 'w' wide, -1 if none
+static int ImFontAtlasShelfClassFindSpan(ImFontAtlasShelfPacker* packer, const ImFontAtlasShelfClass* shelf_class, int w)
+{
+    const ImU32 wider_bins = ImFontAtlasShelfGetWiderBins(shelf_class->BinMask, w);
+    if (wider_bins != 0)
+        return shelf_class->Bins[ImFontAtlasShelfGetLowestBin(wider_bins)];
+    for (int span_idx = shelf_class->Bins[ImFontAtlasShelfGetBin(w)]; span_idx != -1; span_idx = packer->Spans[span_idx].BinNext)
+        if (packer->Spans[span_idx].Width >= w)
+            return span_idx;
+    return -1;
+}
+
+static void ImFontAtlasShelfSpanLinkBin(ImFontAtlasShelfPacker* packer, int span_idx)
+{
+    ImFontAtlasShelfSpan* span = &packer->Spans[span_idx];
+    ImFontAtlasShelfClass* shelf_class = ImFontAtlasShelfGetClass(packer, packer->Shelves[span->ShelfIdx].Height);
+    const int bin = ImFontAtlasShelfGetBin(span->Width);
+    span->BinPrev = -1;
+    span->BinNext = shelf_class->Bins[bin];
+    if (span->BinNext != -1)
+        packer->Spans[span->BinNext].BinPrev = span_idx;
+    shelf_class->Bins[bin] = span_idx;
+    shelf_class->BinMask |= 1u << bin;
+}
+
+static void ImFontAtlasShelfSpanUnlinkBin(ImFontAtlasShelfPacker* packer, int span_idx)
+{
+    ImFontAtlasShelfSpan* span = &packer->Spans[span_idx];
+    if (span->BinPrev != -1)
+    {
+        packer->Spans[span->BinPrev].BinNext = span->BinNext;
+    }
+    else
+    {
+        ImFontAtlasShelfClass* shelf_class = ImFontAtlasShelfGetClass(packer, packer->Shelves[span->ShelfIdx].Height);
+        const int bin = ImFontAtlasShelfGetBin(span->Width);
+        shelf_class->Bins[bin] = span->BinNext;
+        if (span->BinNext == -1)
+            shelf_class->BinMask &= ~(1u << bin);
+    }
+    if (span->BinNext != -1)
+        packer->Spans[span->BinNext].BinPrev = span->BinPrev;
+}
+
+// New span after 'prev_span_idx' in the list of its shelf (-1: first)
+static void ImFontAtlasShelfAddSpan(ImFontAtlasShelfPacker* packer, int shelf_idx, int prev_span_idx, int x, int w)
+{
+    if (w <= 0)
+        return;
+    int span_idx;
+    if (packer->SpansFree.Size > 0)
+    {
+        span_idx = packer->SpansFree.back();
+        packer->SpansFree.pop_back();
+    }
+    else
+    {
+        span_idx = packer->Spans.Size;
+        packer->Spans.resize(span_idx + 1);
+    }
+    ImFontAtlasShelf* shelf = &packer->Shelves[shelf_idx];
+    ImFontAtlasShelfSpan* span = &packer->Spans[span_idx];
+    span->ShelfIdx = shelf_idx;
+    span->X = x;
+    span->Width = w;
+    span->ShelfPrev = prev_span_idx;
+    span->ShelfNext = (prev_span_idx != -1) ? packer->Spans[prev_span_idx].ShelfNext : shelf->FirstSpan;
+    if (span->ShelfNext != -1)
+        packer->Spans[span->ShelfNext].ShelfPrev = span_idx;
+    if (prev_span_idx != -1)
+        packer->Spans[prev_span_idx].ShelfNext = span_idx;
+    else
+        shelf->FirstSpan = span_idx;
+    ImFontAtlasShelfSpanLinkBin(packer, span_idx);
+}
+
+static void ImFontAtlasShelfRemoveSpan(ImFontAtlasShelfPacker* packer, int span_idx)
+{
+    ImFontAtlasShelfSpanUnlinkBin(packer, span_idx);
+    ImFontAtlasShelfSpan* span = &packer->Spans[span_idx];
+    if (span->ShelfPrev != -1)
+        packer->Spans[span->ShelfPrev].ShelfNext = span->ShelfNext;
+    else
+        packer->Shelves[span->ShelfIdx].FirstSpan = span->ShelfNext;
+    if (span->ShelfNext != -1)
+        packer->Spans[span->ShelfNext].ShelfPrev = span->ShelfPrev;
+    span->ShelfIdx = -1;
+    packer->SpansFree.push_back(span_idx);
+}
+
+// Resize a span in place (its neighbors are unchanged), removed if empty
+static void ImFontAtlasShelfSetSpan(ImFontAtlasShelfPacker* packer, int span_idx, int x, int w)
+{
+    if (w <= 0)
+    {
+        ImFontAtlasShelfRemoveSpan(packer, span_idx);
+        return;
+    }
+    ImFontAtlasShelfSpanUnlinkBin(packer, span_idx);
+    packer->Spans[span_idx].X = x;
+    packer->Spans[span_idx].Width = w;
+    ImFontAtlasShelfSpanLinkBin(packer, span_idx);
+}
+
+// Free rows at least 'h' tall, -1 if none
+static int ImFontAtlasShelfFindRows(ImFontAtlasShelfPacker* packer, int h)
+{
+    const ImU32 taller_bins = ImFontAtlasShelfGetWiderBins(packer->RowsBinMask, h);
+    if (taller_bins != 0)
+        return packer->RowsBins[ImFontAtlasShelfGetLowestBin(taller_bins)];
+    for (int rows_idx = packer->RowsBins[ImFontAtlasShelfGetBin(h)]; rows_idx != -1; rows_idx = packer->Rows[rows_idx].BinNext)
+        if (packer->Rows[rows_idx].Y1 - packer->Rows[rows_idx].Y0 >= h)
+            return rows_idx;
+    return -1;
+}
+
+static void ImFontAtlasShelfInsertRows(ImFontAtlasShelfPacker* packer, int y0, int y1)
+{
+    int rows_idx;
+    if (packer->RowsFree.Size > 0)
+    {
+        rows_idx = packer->RowsFree.back();
+        packer->RowsFree.pop_back();
+    }
+    else
+    {
+        rows_idx = packer->Rows.Size;
+        packer->Rows.resize(rows_idx + 1);
+    }
+    ImFontAtlasShelfRows* rows = &packer->Rows[rows_idx];
+    const int bin = ImFontAtlasShelfGetBin(y1 - y0);
+    rows->Y0 = y0;
+    rows->Y1 = y1;
+    rows->BinPrev = -1;
+    rows->BinNext = packer->RowsBins[bin];
+    if (rows->BinNext != -1)
+        packer->Rows[rows->BinNext].BinPrev = rows_idx;
+    packer->RowsBins[bin] = rows_idx;
+    packer->RowsBinMask |= 1u << bin;
+    packer->RowsY0Map.SetInt((ImGuiID)y0, rows_idx + 1);
+    packer->RowsY1Map.SetInt((ImGuiID)y1, rows_idx + 1);
+}
+
+static void ImFontAtlasShelfRemoveRows(ImFontAtlasShelfPacker* packer, int rows_idx)
+{
+    ImFontAtlasShelfRows* rows = &packer->Rows[rows_idx];
+    if (rows->BinPrev != -1)
+    {
+        packer->Rows[rows->BinPrev].BinNext = rows->BinNext;
+    }
+    else
+    {
+        const int bin = ImFontAtlasShelfGetBin(rows->Y1 - rows->Y0);
+        packer->RowsBins[bin] = rows->BinNext;
+        if (rows->BinNext == -1)
+            packer->RowsBinMask &= ~(1u << bin);
+    }
+    if (rows->BinNext != -1)
+        packer->Rows[rows->BinNext].BinPrev = rows->BinPrev;
+    packer->RowsY0Map.SetInt((ImGuiID)rows->Y0, 0);
+    packer->RowsY1Map.SetInt((ImGuiID)rows->Y1, 0);
+    rows->Y1 = rows->Y0;
+    packer->RowsFree.push_back(rows_idx);
+}
+
+void ImFontAtlasShelfPackerInit(ImFontAtlas* atlas)
+{
+    ImFontAtlasShelfPacker* packer = &atlas->Builder->ShelfPacker;
+    ImTextureData* tex = atlas->TexData;
+    packer->Active = !packer->Disabled;
+    packer->Width = tex->Width;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    packer->PageHeight = tex->PageHeight;
+#else
+    packer->PageHeight = tex->Height;
+#endif
+    packer->Shelves.resize(0);
+    packer->ShelvesFree.resize(0);
+    packer->ShelvesMap.Clear();
+    packer->Spans.resize(0);
+    packer->SpansFree.resize(0);
+    packer->Classes.resize(0);
+    packer->Rows.resize(0);
+    packer->RowsFree.resize(0);
+    packer->RowsBinMask = 0;
+    for (int& rows_idx : packer->RowsBins)
+        rows_idx = -1;
+    packer->RowsY0Map.Clear();
+    packer->RowsY1Map.Clear();
+    for (int y = 0; y < tex->Height; y += packer->PageHeight)
+        ImFontAtlasShelfPackerAddRows(atlas, y, y + packer->PageHeight);
+}
+
+// Free rows, merged with the adjacent ones of the same page
+void ImFontAtlasShelfPackerAddRows(ImFontAtlas* atlas, int y0, int y1)
+{
+    ImFontAtlasShelfPacker* packer = &atlas->Builder->ShelfPacker;
+    const int prev_idx = (y0 % packer->PageHeight) != 0 ? packer->RowsY1Map.GetInt((ImGuiID)y0, 0) - 1 : -1;
+    if (prev_idx != -1)
+    {
+        y0 = packer->Rows[prev_idx].Y0;
+        ImFontAtlasShelfRemoveRows(packer, prev_idx);
+    }
+    const int next_idx = (y1 % packer->PageHeight) != 0 ? packer->RowsY0Map.GetInt((ImGuiID)y1, 0) - 1 : -1;
+    if (next_idx != -1)
+    {
+        y1 = packer->Rows[next_idx].Y1;
+        ImFontAtlasShelfRemoveRows(packer, next_idx);
+    }
+    ImFontAtlasShelfInsertRows(packer, y0, y1);
+}
+
+bool ImFontAtlasShelfPackerAddRect(ImFontAtlas* atlas, int w, int h, ImTextureRect* out_r)
+{
+    ImFontAtlasShelfPacker* packer = &atlas->Builder->ShelfPacker;
+    if (w > packer->Width || h > packer->PageHeight)
+        return false;
+    packer->InsertCount++;
+    const int class_h = ImMin(ImFontAtlasShelfGetClassHeight(h), packer->PageHeight);
+
+    // A free span of that class, then of the next one
+    int span_idx = -1;
+    for (int search_h = class_h, n = 0; n < 2 && search_h <= packer->PageHeight && span_idx < 0; search_h = ImFontAtlasShelfGetClassHeight(search_h + 1), n++)
+    {
+        const int class_n = ImFontAtlasShelfFindClass(packer, search_h);
+        if (class_n < packer->Classes.Size && packer->Classes[class_n].Height == search_h)
+            span_idx = ImFontAtlasShelfClassFindSpan(packer, &packer->Classes[class_n], w);
+    }
+
+    // Otherwise open a shelf in free rows tall enough
+    const int rows_idx = (span_idx < 0) ? ImFontAtlasShelfFindRows(packer, class_h) : -1;
+    if (rows_idx != -1)
+    {
+        const ImFontAtlasShelfRows rows = packer->Rows[rows_idx];
+        ImFontAtlasShelfRemoveRows(packer, rows_idx);
+        if (rows.Y0 + class_h < rows.Y1)
+            ImFontAtlasShelfInsertRows(packer, rows.Y0 + class_h, rows.Y1);
+        int shelf_idx;
+        if (packer->ShelvesFree.Size > 0)
+        {
+            shelf_idx = packer->ShelvesFree.back();
+            packer->ShelvesFree.pop_back();
+        }
+        else
+        {
+            shelf_idx = packer->Shelves.Size;
+            packer->Shelves.resize(shelf_idx + 1);
+        }
+        ImFontAtlasShelf* shelf = &packer->Shelves[shelf_idx];
+        shelf->Y = rows.Y0;
+        shelf->Height = class_h;
+        shelf->RectCount = 1;
+        shelf->FirstSpan = -1;
+        packer->ShelvesMap.SetInt((ImGuiID)shelf->Y, shelf_idx + 1);
+        ImFontAtlasShelfAddSpan(packer, shelf_idx, -1, w, packer->Width - w);
+        *out_r = { 0, (unsigned short)shelf->Y, (unsigned short)w, (unsigned short)class_h };
+        return true;
+    }
+
+    // Out of rows: any taller shelf rather than growing the texture
+    for (int class_n = ImFontAtlasShelfFindClass(packer, class_h); span_idx < 0 && class_n < packer->Classes.Size; class_n++)
+        span_idx = ImFontAtlasShelfClassFindSpan(packer, &packer->Classes[class_n], w);
+    if (span_idx < 0)
+        return false;
+
+    const ImFontAtlasShelfSpan span = packer->Spans[span_idx];
+    ImFontAtlasShelf* shelf = &packer->Shelves[span.ShelfIdx];
+    shelf->RectCount++;
+    *out_r = { (unsigned short)span.X, (unsigned short)shelf->Y, (unsigned short)w, (unsigned short)shelf->Height };
+    ImFontAtlasShelfSetSpan(packer, span_idx, span.X + w, span.Width - w);
+    return true;
+}
+
+// Rectangles are at the top of their shelf: 'y' finds it
+void ImFontAtlasShelfPackerDiscardRect(ImFontAtlas* atlas, int x, int y, int w)
+{
+    ImFontAtlasShelfPacker* packer = &atlas->Builder->ShelfPacker;
+    const int shelf_idx = packer->ShelvesMap.GetInt((ImGuiID)y, 0) - 1;
+    IM_ASSERT(shelf_idx >= 0 && packer->Shelves[shelf_idx].Y == y && packer->Shelves[shelf_idx].RectCount > 0);
+    ImFontAtlasShelf* shelf = &packer->Shelves[shelf_idx];
+
+    // Empty shelf: its rows go back to any class
+    if (--shelf->RectCount == 0)
+    {
+        while (shelf->FirstSpan != -1)
+            ImFontAtlasShelfRemoveSpan(packer, shelf->FirstSpan);
+        packer->ShelvesMap.SetInt((ImGuiID)y, 0);
+        ImFontAtlasShelfPackerAddRows(atlas, shelf->Y, shelf->Y + shelf->Height);
+        shelf->Height = 0;
+        packer->ShelvesFree.push_back(shelf_idx);
+        packer->ReleasedShelfCount++;
+        return;
+    }
+
+    // Merge with the free spans on each side, found in the list of the shelf
+    int prev_idx = -1;
+    int next_idx = shelf->FirstSpan;
+    while (next_idx != -1 && packer->Spans[next_idx].X < x)
+    {
+        prev_idx = next_idx;
+        next_idx = packer->Spans[next_idx].ShelfNext;
+    }
+    int x1 = x + w;
+    if (next_idx != -1 && packer->Spans[next_idx].X == x1)
+    {
+        x1 += packer->Spans[next_idx].Width;
+        ImFontAtlasShelfRemoveSpan(packer, next_idx);
+    }
+    if (prev_idx != -1 && packer->Spans[prev_idx].X + packer->Spans[prev_idx].Width == x)
+        ImFontAtlasShelfSetSpan(packer, prev_idx, packer->Spans[prev_idx].X, x1 - packer->Spans[prev_idx].X);
+    else
+        ImFontAtlasShelfAddSpan(packer, shelf_idx, prev_idx, x, x1 - x);
+}
+#endif
+
 void ImFontAtlasPackInit(ImFontAtlas * atlas)
 {
     ImTextureData* tex = atlas->TexData;
@@ -4263,7 +5898,15 @@ void ImFontAtlasPackInit(ImFontAtlas * atlas)
     const int pack_node_count = tex->Width / 2;
     builder->PackNodes.resize(pack_node_count);
     IM_STATIC_ASSERT(sizeof(stbrp_context) <= sizeof(stbrp_context_opaque));
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    builder->Pages.PackPage = 0;
+    stbrp_init_target((stbrp_context*)(void*)&builder->PackContext, tex->Width, tex->PageHeight, builder->PackNodes.Data, builder->PackNodes.Size);
+#else
     stbrp_init_target((stbrp_context*)(void*)&builder->PackContext, tex->Width, tex->Height, builder->PackNodes.Data, builder->PackNodes.Size);
+#endif
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    ImFontAtlasShelfPackerInit(atlas);
+#endif
     builder->RectsPackedSurface = builder->RectsPackedCount = 0;
     builder->MaxRectSize = ImVec2i(0, 0);
     builder->MaxRectBounds = ImVec2i(0, 0);
@@ -4323,6 +5966,10 @@ void ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id)
         index_entry->Generation++; // Keep non-zero on overflow
 
     const int pack_padding = atlas->TexGlyphPadding;
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    if (builder->ShelfPacker.Active)
+        ImFontAtlasShelfPackerDiscardRect(atlas, rect->x, rect->y, rect->w + pack_padding);
+#endif
     builder->RectsIndexFreeListStart = index_idx;
     builder->RectsDiscardedCount++;
     builder->RectsDiscardedSurface += (rect->w + pack_padding) * (rect->h + pack_padding);
@@ -4346,14 +5993,52 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
     for (int attempts_remaining = 3; attempts_remaining >= 0; attempts_remaining--)
     {
         // Try packing
-        stbrp_rect pack_r = {};
-        pack_r.w = w + pack_padding;
-        pack_r.h = h + pack_padding;
-        stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, &pack_r, 1);
-        r.x = (unsigned short)pack_r.x;
-        r.y = (unsigned short)pack_r.y;
-        if (pack_r.was_packed)
-            break;
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+        if (builder->ShelfPacker.Active)
+        {
+            ImTextureRect claimed;
+            if (ImFontAtlasShelfPackerAddRect(atlas, w + pack_padding, h + pack_padding, &claimed))
+            {
+                // Discarded space is reused without a repack: clear what the previous rectangles left around this one (padding included).
+                // The upload mostly overlaps the one of the new pixels. A repack writes into a fresh texture.
+                r.x = claimed.x;
+                r.y = claimed.y;
+                if (overwrite_entry == NULL)
+                {
+                    ImFontAtlasTextureBlockFill(atlas->TexData, claimed.x, claimed.y, claimed.w, claimed.h, IM_COL32_BLACK_TRANS);
+                    ImFontAtlasTextureBlockQueueUpload(atlas, atlas->TexData, claimed.x, claimed.y, claimed.w, claimed.h);
+                }
+                break;
+            }
+        }
+        else
+#endif
+        {
+            stbrp_rect pack_r = {};
+            pack_r.w = w + pack_padding;
+            pack_r.h = h + pack_padding;
+            stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, &pack_r, 1);
+            r.x = (unsigned short)pack_r.x;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+            r.y = (unsigned short)(pack_r.y + builder->Pages.PackPage * atlas->TexData->PageHeight);
+#else
+            r.y = (unsigned short)pack_r.y;
+#endif
+            if (pack_r.was_packed)
+                break;
+        }
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+        // Texture has more pages (repacking into several pages): not a failed attempt. The shelf packer already uses all pages.
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+        if (!builder->ShelfPacker.Active && ImFontAtlasPackNextPage(atlas))
+#else
+        if (ImFontAtlasPackNextPage(atlas))
+#endif
+        {
+            attempts_remaining++;
+            continue;
+        }
+#endif
 
         // If we ran out of attempts, return fallback
         if (attempts_remaining == 0 || builder->LockDisableResize)
@@ -4363,6 +6048,9 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
         }
 
         // Resize or repack atlas! (this should be a rare event)
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+        builder->ShelfPacker.MakeSpaceCount++;
+#endif
         ImFontAtlasTextureMakeSpace(atlas);
     }
 
@@ -4455,125 +6143,643 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
     //char utf8_buf[5];
     //IMGUI_DEBUG_LOG("[font] BuildLoadGlyph U+%04X (%s)\n", (unsigned int)codepoint, ImTextCharToUtf8(utf8_buf, (unsigned int)codepoint));
 
-    // Special hook
-    // FIXME-NEWATLAS: it would be nicer if this used a more standardized way of hooking
-    if (codepoint == font->EllipsisChar && font->EllipsisAutoBake)
-        if (ImFontGlyph* glyph = ImFontAtlasBuildSetupFontBakedEllipsis(atlas, baked))
-            return glyph;
+    // Special hook
+    // FIXME-NEWATLAS: it would be nicer if this used a more standardized way of hooking
+    if (codepoint == font->EllipsisChar && font->EllipsisAutoBake)
+        if (ImFontGlyph* glyph = ImFontAtlasBuildSetupFontBakedEllipsis(atlas, baked))
+            return glyph;
+
+    // Call backend
+    char* loader_user_data_p = (char*)baked->FontLoaderDatas;
+    int src_n = 0;
+    for (ImFontConfig* src : font->Sources)
+    {
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        if (!src->GlyphExcludeRanges || ImFontAtlasBuildAcceptCodepointForSource(src, codepoint))
+        {
+            if (only_load_advance_x == NULL)
+            {
+                ImFontGlyph glyph_buf;
+                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, &glyph_buf, NULL))
+                {
+                    // FIXME: Add hooks for e.g. #7962
+                    glyph_buf.Codepoint = src_codepoint;
+                    glyph_buf.SourceIdx = src_n;
+                    return ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &glyph_buf);
+                }
+            }
+            else
+            {
+                // Special mode but only loading glyphs metrics. Will rasterize and pack later.
+                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, NULL, only_load_advance_x))
+                {
+                    ImFontAtlasBakedAddFontGlyphAdvancedX(atlas, baked, src, codepoint, *only_load_advance_x);
+                    return NULL;
+                }
+            }
+        }
+        loader_user_data_p += loader->FontBakedSrcLoaderDataSize;
+        src_n++;
+    }
+
+    // Lazily load fallback glyph
+    if (baked->LoadNoFallback)
+        return NULL;
+    if (baked->FallbackGlyphIndex == -1)
+        ImFontAtlasBuildSetupFontBakedFallback(baked);
+
+    // Mark index as not found, so we don't attempt the search twice
+    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
+    baked->IndexAdvanceX[codepoint] = baked->FallbackAdvanceX;
+    baked->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_FOUND;
+    return NULL;
+}
+
+static float ImFontBaked_BuildLoadGlyphAdvanceX(ImFontBaked* baked, ImWchar codepoint)
+{
+    if (baked->Size >= IMGUI_FONT_SIZE_THRESHOLD_FOR_LOADADVANCEXONLYMODE || baked->LoadNoRenderOnLayout)
+    {
+        // First load AdvanceX value used by CalcTextSize() API then load the rest when loaded by drawing API.
+        float only_advance_x = 0.0f;
+        ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(baked, (ImWchar)codepoint, &only_advance_x);
+        return glyph ? glyph->AdvanceX : only_advance_x;
+    }
+    else
+    {
+        ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(baked, (ImWchar)codepoint, NULL);
+        return glyph ? glyph->AdvanceX : baked->FallbackAdvanceX;
+    }
+}
+
+// The point of this indirection is to not be inlined in debug mode in order to not bloat inner loop.b
+IM_MSVC_RUNTIME_CHECKS_OFF
+static float BuildLoadGlyphGetAdvanceOrFallback(ImFontBaked* baked, unsigned int codepoint)
+{
+    return ImFontBaked_BuildLoadGlyphAdvanceX(baked, (ImWchar)codepoint);
+}
+IM_MSVC_RUNTIME_CHECKS_RESTORE
+
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
+{
+    // [DEBUG] Log texture update requests
+    ImGuiContext& g = *GImGui;
+    IM_UNUSED(g);
+    for (ImTextureData* tex : atlas->TexList)
+    {
+        if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
+            IM_ASSERT(tex->Updates.Size == 0);
+        if (tex->Status == ImTextureStatus_WantCreate)
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: create %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
+        else if (tex->Status == ImTextureStatus_WantDestroy)
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: destroy %dx%d, texid=0x%" IM_PRIX64 ", backend_data=%p\n", tex->UniqueID, tex->Width, tex->Height, IM_TEXTUREID_TO_U64(tex->TexID), tex->BackendUserData);
+        else if (tex->Status == ImTextureStatus_WantUpdates)
+        {
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update %d regions, texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, tex->Updates.Size, IM_TEXTUREID_TO_U64(tex->TexID), (ImU64)(intptr_t)tex->BackendUserData);
+            for (const ImTextureRect& r : tex->Updates)
+            {
+                IM_UNUSED(r);
+                IM_ASSERT(r.x >= 0 && r.y >= 0);
+                IM_ASSERT(r.x + r.w <= tex->Width && r.y + r.h <= tex->Height); // In theory should subtract PackPadding but it's currently part of atlas and mid-frame change would wreck assert.
+                //IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update (% 4d..%-4d)->(% 4d..%-4d), texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, r.x, r.y, r.x + r.w, r.y + r.h, IM_TEXTUREID_TO_U64(tex->TexID), (ImU64)(intptr_t)tex->BackendUserData);
+            }
+        }
+    }
+}
+#endif
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: backend for stb_truetype
+//-------------------------------------------------------------------------
+// (imstb_truetype.h in included near the top of this file, when IMGUI_ENABLE_STB_TRUETYPE is set)
+//-------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+bool GImFontRasterizeScalar = false;
+
+// Same as the loop in stbtt__rasterize_sorted_edges()
+void ImFontRasterizeScanlineScalar(const float* coverage, const float* fill, int len, unsigned char* out)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < len; i++)
+    {
+        sum += fill[i];
+        const int m = (int)(ImFabs(coverage[i] + sum) * 255 + 0.5f);
+        out[i] = (unsigned char)(m > 255 ? 255 : m);
+    }
+}
+
+void ImFontRasterizeScanlineSIMD(const float* coverage, const float* fill, int len, unsigned char* out)
+{
+    int i = 0;
+    float sum = 0.0f;
+#if defined(IMGUI_ENABLE_AVX2)
+    // In-lane prefix sums, then the low lane total is added to the high lane
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 scale = _mm256_set1_ps(255.0f), half = _mm256_set1_ps(0.5f);
+    __m256 carry = _mm256_setzero_ps();
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256 d = _mm256_loadu_ps(fill + i);
+        d = _mm256_add_ps(d, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(d), 4)));
+        d = _mm256_add_ps(d, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(d), 8)));
+        const __m256 lane_totals = _mm256_permute_ps(d, _MM_SHUFFLE(3, 3, 3, 3));
+        d = _mm256_add_ps(_mm256_add_ps(d, _mm256_permute2f128_ps(lane_totals, lane_totals, 0x08)), carry);
+        const __m256 last = _mm256_permute_ps(d, _MM_SHUFFLE(3, 3, 3, 3));
+        carry = _mm256_permute2f128_ps(last, last, 0x11);
+        __m256 k = _mm256_and_ps(_mm256_add_ps(_mm256_loadu_ps(coverage + i), d), abs_mask);
+        k = _mm256_min_ps(_mm256_add_ps(_mm256_mul_ps(k, scale), half), scale);
+        const __m256i m = _mm256_cvttps_epi32(k);
+        const __m128i m16 = _mm_packs_epi32(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1));
+        _mm_storel_epi64((__m128i*)(void*)(out + i), _mm_packus_epi16(m16, m16));
+    }
+    sum = _mm_cvtss_f32(_mm256_castps256_ps128(carry));
+#elif defined(IMGUI_ENABLE_SSE2)
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 scale = _mm_set1_ps(255.0f), half = _mm_set1_ps(0.5f);
+    __m128 carry = _mm_setzero_ps();
+    for (; i + 4 <= len; i += 4)
+    {
+        __m128 d = _mm_loadu_ps(fill + i);
+        d = _mm_add_ps(d, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(d), 4)));
+        d = _mm_add_ps(d, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(d), 8)));
+        d = _mm_add_ps(d, carry);
+        carry = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+        __m128 k = _mm_and_ps(_mm_add_ps(_mm_loadu_ps(coverage + i), d), abs_mask);
+        k = _mm_min_ps(_mm_add_ps(_mm_mul_ps(k, scale), half), scale);
+        const __m128i m16 = _mm_packs_epi32(_mm_cvttps_epi32(k), _mm_setzero_si128());
+        const int m8 = _mm_cvtsi128_si32(_mm_packus_epi16(m16, m16));
+        memcpy(out + i, &m8, 4);
+    }
+    sum = _mm_cvtss_f32(carry);
+#elif defined(IMGUI_ENABLE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f), scale = vdupq_n_f32(255.0f), half = vdupq_n_f32(0.5f);
+    float32x4_t carry = zero;
+    for (; i + 4 <= len; i += 4)
+    {
+        float32x4_t d = vld1q_f32(fill + i);
+        d = vaddq_f32(d, vextq_f32(zero, d, 3));
+        d = vaddq_f32(d, vextq_f32(zero, d, 2));
+        d = vaddq_f32(d, carry);
+        carry = vdupq_laneq_f32(d, 3);
+        float32x4_t k = vabsq_f32(vaddq_f32(vld1q_f32(coverage + i), d));
+        k = vminq_f32(vaddq_f32(vmulq_f32(k, scale), half), scale);
+        const uint16x4_t m16 = vmovn_u32(vcvtq_u32_f32(k));
+        const uint8x8_t m8 = vmovn_u16(vcombine_u16(m16, m16));
+        vst1_lane_u32((uint32_t*)(void*)(out + i), vreinterpret_u32_u8(m8), 0);
+    }
+    sum = vgetq_lane_f32(carry, 0);
+#endif
+    for (; i < len; i++)
+    {
+        sum += fill[i];
+        const int m = (int)(ImFabs(coverage[i] + sum) * 255 + 0.5f);
+        out[i] = (unsigned char)(m > 255 ? 255 : m);
+    }
+}
+
+#if defined(IMGUI_ENABLE_SSE2) || defined(IMGUI_ENABLE_NEON)
+// dst[0..15] = (src[0..15] + src[-step..] + .. + src[-(count - 1) * step..]) / kernel_width, 'mul' being 65536 / kernel_width rounded up:
+// the sums are at most 8 * 255 (STBTT_MAX_OVERSAMPLE), small enough for the 16-bit multiply-high to give the exact quotient.
+static inline void ImFontRasterizeBoxBlock16(const unsigned char* src, int step, int count, unsigned int mul, unsigned char* dst)
+{
+#if defined(IMGUI_ENABLE_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = zero, hi = zero;
+    for (int k = 0; k < count; k++, src -= step)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)src);
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+    }
+    const __m128i m = _mm_set1_epi16((short)mul);
+    _mm_storeu_si128((__m128i*)(void*)dst, _mm_packus_epi16(_mm_mulhi_epu16(lo, m), _mm_mulhi_epu16(hi, m)));
+#else
+    uint16x8_t lo = vdupq_n_u16(0), hi = vdupq_n_u16(0);
+    for (int k = 0; k < count; k++, src -= step)
+    {
+        const uint8x16_t v = vld1q_u8(src);
+        lo = vaddw_u8(lo, vget_low_u8(v));
+        hi = vaddw_high_u8(hi, v);
+    }
+    const uint16x8_t m = vdupq_n_u16((uint16_t)mul);
+    lo = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(lo), vget_low_u16(m)), 16), vshrn_n_u32(vmull_high_u16(lo, m), 16));
+    hi = vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(hi), vget_low_u16(m)), 16), vshrn_n_u32(vmull_high_u16(hi, m), 16));
+    vst1q_u8(dst, vcombine_u8(vmovn_u16(lo), vmovn_u16(hi)));
+#endif
+}
+#endif
+
+// Pixels before the first row/column count as 0. Going backward, the pixels a block reads were not written yet.
+bool ImFontRasterizePrefilterSIMD(unsigned char* pixels, int w, int h, int stride, int kernel_width, bool vertical)
+{
+#if defined(IMGUI_ENABLE_SSE2) || defined(IMGUI_ENABLE_NEON)
+    if (kernel_width < 2 || kernel_width > 8)
+        return false;
+    const unsigned int mul = (65536 + kernel_width - 1) / kernel_width;
+    if (vertical)
+    {
+        for (int y = h - 1; y >= 0; y--)
+        {
+            unsigned char* row = pixels + y * stride;
+            const int count = ImMin(kernel_width, y + 1);
+            int x = 0;
+            for (; x + 16 <= w; x += 16)
+                ImFontRasterizeBoxBlock16(row + x, stride, count, mul, row + x);
+            for (; x < w; x++)
+            {
+                unsigned int total = 0;
+                for (int k = 0; k < count; k++)
+                    total += row[x - k * stride];
+                row[x] = (unsigned char)(total / kernel_width);
+            }
+        }
+    }
+    else
+    {
+        for (int y = 0; y < h; y++)
+        {
+            unsigned char* row = pixels + y * stride;
+            int x = w;
+            for (; x - 16 >= kernel_width - 1; x -= 16)
+                ImFontRasterizeBoxBlock16(row + x - 16, 1, kernel_width, mul, row + x - 16);
+            for (x--; x >= 0; x--)
+            {
+                unsigned int total = 0;
+                for (int k = 0, count = ImMin(kernel_width, x + 1); k < count; k++)
+                    total += row[x - k];
+                row[x] = (unsigned char)(total / kernel_width);
+            }
+        }
+    }
+    return true;
+#else
+    IM_UNUSED(pixels); IM_UNUSED(w); IM_UNUSED(h); IM_UNUSED(stride); IM_UNUSED(kernel_width); IM_UNUSED(vertical);
+    return false;
+#endif
+}
+#endif // #ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+
+// One for each ConfigData
+struct ImGui_ImplStbTrueType_FontSrcData
+{
+    stbtt_fontinfo  FontInfo;
+    float           ScaleFactor;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    ImU32           FontDataHash;   // 0: not computed yet, done on the first glyph cache lookup
+#endif
+};
+
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+// Everything the rasterized bitmap depends on (rasterizer density is part of the scales)
+struct ImGui_ImplStbTrueType_GlyphCacheKey
+{
+    ImU32           FontDataHash;
+    int             FontDataSize;
+    ImU32           FontNo;
+    int             GlyphIndex;
+    float           ScaleX, ScaleY;
+    int             OversampleH, OversampleV;
+    int             ScanlineWidth;  // Pixels per iteration of the scanline kernel, which rounds differently (0: stb_truetype code)
+};
+
+// See ImFontRasterizeScanlineSIMD()
+static int ImGui_ImplStbTrueType_GetScanlineWidth(bool rasterize_scalar)
+{
+#if defined(IMGUI_ENABLE_STB_TRUETYPE_SIMD) && defined(IMGUI_ENABLE_AVX2)
+    return rasterize_scalar ? 0 : 8;
+#elif defined(IMGUI_ENABLE_STB_TRUETYPE_SIMD) && (defined(IMGUI_ENABLE_SSE2) || defined(IMGUI_ENABLE_NEON))
+    return rasterize_scalar ? 0 : 4;
+#else
+    IM_UNUSED(rasterize_scalar);
+    return 0;
+#endif
+}
+
+static void ImGui_ImplStbTrueType_GlyphCacheGetKey(ImGui_ImplStbTrueType_FontSrcData* bd_font_data, ImFontConfig* src, int glyph_index, float scale_x, float scale_y, int oversample_h, int oversample_v, bool rasterize_scalar, ImFontGlyphCacheEntry* out_entry)
+{
+    if (bd_font_data->FontDataHash == 0)
+        bd_font_data->FontDataHash = ImHashData(src->FontData, (size_t)src->FontDataSize);
+    const ImGui_ImplStbTrueType_GlyphCacheKey key = { bd_font_data->FontDataHash, src->FontDataSize, src->FontNo, glyph_index, scale_x, scale_y, oversample_h, oversample_v, ImGui_ImplStbTrueType_GetScanlineWidth(rasterize_scalar) };
+
+    // KeyHi uses FNV-1a, a CRC with another seed would collide along with KeyLo
+    ImU32 fnv = 2166136261u;
+    for (size_t n = 0; n < sizeof(key); n++)
+        fnv = (fnv ^ ((const unsigned char*)&key)[n]) * 16777619u;
+    out_entry->KeyLo = ImHashData(&key, sizeof(key));
+    out_entry->KeyHi = fnv;
+}
+#endif
+
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+struct ImFontAsyncGlyphJob
+{
+    const stbtt_fontinfo* FontInfo;
+    int                 FontGlyphIndex;     // stbtt glyph index
+    float               ScaleX, ScaleY;
+    int                 OversampleH, OversampleV;
+    int                 Width, Height;
+    ImGuiID             BakedId;            // ImFontBaked pointers move when the pool is garbage collected
+    int                 GlyphIdx;           // Into baked->Glyphs[], which are never erased
+    ImFontAtlasRectId   PackId;             // Checked against the glyph's, in case it was discarded
+    unsigned char*      Pixels;             // Output, allocated with AllocFunc
+    bool                Done;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    bool                AddToGlyphCache;
+    ImFontGlyphCacheEntry GlyphCacheEntry;
+#endif
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+    bool                RasterizeScalar;    // GImFontRasterizeScalar when requested, the worker doesn't read it
+#endif
+};
+
+struct ImFontAsyncGlyphWorkers
+{
+    std::mutex              Mutex;                  // Protects Shutdown, Jobs and the heads/counters
+    std::condition_variable WorkAvailable;
+    std::condition_variable WorkDone;
+    std::thread             Threads[IM_FONTASYNCGLYPHS_MAX_WORKERS];
+    int                     ThreadCount = 0;
+    bool                    Shutdown = false;
+    ImVector<ImFontAsyncGlyphJob> Jobs;             // In request order, only resized by the main thread
+    ImVector<ImFontAtlasPostProcessData> Blits;     // Parallel build destinations, same indices as Jobs (Pixels == NULL: dropped). Empty otherwise
+    int                     QueueHead = 0;          // Next job to rasterize
+    int                     ApplyHead = 0;          // Next job to apply
+    int                     BlitHead = 0;           // Next job to blit, once there is nothing left to rasterize
+    int                     RunningCount = 0;
+    ImGuiMemAllocFunc       AllocFunc = NULL;       // Workers bypass ImGui::MemAlloc(), which updates the debug stats of the current context
+    ImGuiMemFreeFunc        FreeFunc = NULL;
+    void*                   AllocUserData = NULL;
+};
+
+static thread_local ImFontAsyncGlyphWorkers* GImFontAsyncGlyphWorker = NULL;   // Set on worker threads
+
+static void* ImFontAsyncGlyphsMemAlloc(size_t size)
+{
+    if (ImFontAsyncGlyphWorkers* workers = GImFontAsyncGlyphWorker)
+        return workers->AllocFunc(size, workers->AllocUserData);
+    return IM_ALLOC(size);
+}
+
+static void ImFontAsyncGlyphsMemFree(void* ptr)
+{
+    if (ImFontAsyncGlyphWorkers* workers = GImFontAsyncGlyphWorker)
+        workers->FreeFunc(ptr, workers->AllocUserData);
+    else
+        IM_FREE(ptr);
+}
+
+// Parallel build: copy the next rasterized bitmap into the texture. Same as ImFontAtlasBakedSetFontGlyphBitmap() without the upload.
+static bool ImFontAsyncGlyphWorkersBlitOne(ImFontAsyncGlyphWorkers* workers, std::unique_lock<std::mutex>& lock)
+{
+    if (workers->BlitHead >= workers->Blits.Size)
+        return false;
+    const int job_n = workers->BlitHead++;
+    ImFontAtlasPostProcessData pp_data = workers->Blits[job_n];
+    if (pp_data.Pixels == NULL)
+        return true;
+    const ImFontAsyncGlyphJob& job = workers->Jobs[job_n]; // Not resized until the build ends
+    workers->RunningCount++;
+    lock.unlock();
+
+    ImFontAtlasTextureBlockConvert(job.Pixels, ImTextureFormat_Alpha8, job.Width, (unsigned char*)pp_data.Pixels, pp_data.Format, pp_data.Pitch, pp_data.Width, pp_data.Height);
+    ImFontAtlasTextureBlockPostProcess(&pp_data);
+
+    lock.lock();
+    workers->RunningCount--;
+    workers->WorkDone.notify_all();
+    return true;
+}
+
+// Take the next queued job and rasterize it (or blit it), 'lock' is released meanwhile. Returns false when the queue is empty.
+static bool ImFontAsyncGlyphWorkersRunOne(ImFontAsyncGlyphWorkers* workers, std::unique_lock<std::mutex>& lock)
+{
+    if (workers->QueueHead == workers->Jobs.Size)
+        return ImFontAsyncGlyphWorkersBlitOne(workers, lock);
+    const int job_n = workers->QueueHead++;
+    const ImFontAsyncGlyphJob job = workers->Jobs[job_n];
+    workers->RunningCount++;
+    lock.unlock();
 
-    // Call backend
-    char* loader_user_data_p = (char*)baked->FontLoaderDatas;
-    int src_n = 0;
-    for (ImFontConfig* src : font->Sources)
-    {
-        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
-        if (!src->GlyphExcludeRanges || ImFontAtlasBuildAcceptCodepointForSource(src, codepoint))
-        {
-            if (only_load_advance_x == NULL)
-            {
-                ImFontGlyph glyph_buf;
-                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, &glyph_buf, NULL))
-                {
-                    // FIXME: Add hooks for e.g. #7962
-                    glyph_buf.Codepoint = src_codepoint;
-                    glyph_buf.SourceIdx = src_n;
-                    return ImFontAtlasBakedAddFontGlyph(atlas, baked, src, &glyph_buf);
-                }
-            }
-            else
-            {
-                // Special mode but only loading glyphs metrics. Will rasterize and pack later.
-                if (loader->FontBakedLoadGlyph(atlas, src, baked, loader_user_data_p, codepoint, NULL, only_load_advance_x))
-                {
-                    ImFontAtlasBakedAddFontGlyphAdvancedX(atlas, baked, src, codepoint, *only_load_advance_x);
-                    return NULL;
-                }
-            }
-        }
-        loader_user_data_p += loader->FontBakedSrcLoaderDataSize;
-        src_n++;
-    }
+    // Same as the synchronous path in ImGui_ImplStbTrueType_FontBakedLoadGlyph()
+    const size_t size = (size_t)job.Width * job.Height;
+    unsigned char* pixels = (unsigned char*)workers->AllocFunc(size, workers->AllocUserData);
+    memset(pixels, 0, size);
+    float sub_x, sub_y;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+    GImFontRasterizeScalarCurrent = job.RasterizeScalar;
+#endif
+    stbtt_MakeGlyphBitmapSubpixelPrefilter(job.FontInfo, pixels, job.Width, job.Height, job.Width,
+        job.ScaleX, job.ScaleY, 0, 0, job.OversampleH, job.OversampleV, &sub_x, &sub_y, job.FontGlyphIndex);
+
+    lock.lock();
+    workers->Jobs[job_n].Pixels = pixels;
+    workers->Jobs[job_n].Done = true;
+    workers->RunningCount--;
+    workers->WorkDone.notify_all();
+    return true;
+}
 
-    // Lazily load fallback glyph
-    if (baked->LoadNoFallback)
-        return NULL;
-    if (baked->FallbackGlyphIndex == -1)
-        ImFontAtlasBuildSetupFontBakedFallback(baked);
+static void ImFontAsyncGlyphWorkerMain(ImFontAsyncGlyphWorkers* workers)
+{
+    GImFontAsyncGlyphWorker = workers;
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    while (!workers->Shutdown)
+        if (!ImFontAsyncGlyphWorkersRunOne(workers, lock))
+            workers->WorkAvailable.wait(lock);
+}
 
-    // Mark index as not found, so we don't attempt the search twice
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = baked->FallbackAdvanceX;
-    baked->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_FOUND;
-    return NULL;
+static bool ImFontAtlasAsyncGlyphsEnabled(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder->AsyncGlyphs.ParallelBuilding)
+        return true;
+    return atlas->RendererHasTextures && !builder->PreloadedAllGlyphsRanges && !builder->AsyncGlyphs.Disabled;
 }
 
-static float ImFontBaked_BuildLoadGlyphAdvanceX(ImFontBaked* baked, ImWchar codepoint)
+static void ImFontAtlasAsyncGlyphsRequest(ImFontAtlas* atlas, const ImFontAsyncGlyphJob& job)
 {
-    if (baked->Size >= IMGUI_FONT_SIZE_THRESHOLD_FOR_LOADADVANCEXONLYMODE || baked->LoadNoRenderOnLayout)
+    ImFontAsyncGlyphs* async = &atlas->Builder->AsyncGlyphs;
+    ImFontAsyncGlyphWorkers* workers = async->Workers;
+    if (workers == NULL)
     {
-        // First load AdvanceX value used by CalcTextSize() API then load the rest when loaded by drawing API.
-        float only_advance_x = 0.0f;
-        ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(baked, (ImWchar)codepoint, &only_advance_x);
-        return glyph ? glyph->AdvanceX : only_advance_x;
+        workers = async->Workers = IM_NEW(ImFontAsyncGlyphWorkers)();
+        ImGui::GetAllocatorFunctions(&workers->AllocFunc, &workers->FreeFunc, &workers->AllocUserData);
+        workers->ThreadCount = (async->WorkerCount == 0) ? IM_FONTASYNCGLYPHS_DEFAULT_WORKERS : ImClamp(async->WorkerCount, 0, IM_FONTASYNCGLYPHS_MAX_WORKERS);
+        for (int n = 0; n < workers->ThreadCount; n++)
+            workers->Threads[n] = std::thread(ImFontAsyncGlyphWorkerMain, workers);
     }
-    else
     {
-        ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(baked, (ImWchar)codepoint, NULL);
-        return glyph ? glyph->AdvanceX : baked->FallbackAdvanceX;
+        std::lock_guard<std::mutex> lock(workers->Mutex);
+        workers->Jobs.push_back(job);
     }
+    workers->WorkAvailable.notify_one();
+    async->PendingCount++;
+    async->FrameRequests++;
 }
 
-// The point of this indirection is to not be inlined in debug mode in order to not bloat inner loop.b
-IM_MSVC_RUNTIME_CHECKS_OFF
-static float BuildLoadGlyphGetAdvanceOrFallback(ImFontBaked* baked, unsigned int codepoint)
+// Copy a rasterized bitmap to its glyph, if it is still there
+static bool ImFontAtlasAsyncGlyphApply(ImFontAtlas* atlas, const ImFontAsyncGlyphJob& job)
 {
-    return ImFontBaked_BuildLoadGlyphAdvanceX(baked, (ImWchar)codepoint);
+    ImFontBaked* baked = (ImFontBaked*)atlas->Builder->BakedMap.GetVoidPtr(job.BakedId);
+    if (baked == NULL || baked->WantDestroy || job.GlyphIdx >= baked->Glyphs.Size)
+        return false;
+    ImFontGlyph* glyph = &baked->Glyphs[job.GlyphIdx];
+    if (glyph->PackId != job.PackId)
+        return false;
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, job.PackId);
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, baked->OwnerFont->Sources[glyph->SourceIdx], glyph, r, job.Pixels, ImTextureFormat_Alpha8, job.Width);
+    return true;
 }
-IM_MSVC_RUNTIME_CHECKS_RESTORE
 
-#ifndef IMGUI_DISABLE_DEBUG_TOOLS
-void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
+void ImFontAtlasAsyncGlyphsNewFrame(ImFontAtlas* atlas)
 {
-    // [DEBUG] Log texture update requests
-    ImGuiContext& g = *GImGui;
-    IM_UNUSED(g);
-    for (ImTextureData* tex : atlas->TexList)
+    ImFontAsyncGlyphs* async = &atlas->Builder->AsyncGlyphs;
+    async->LastFrameRequests = async->FrameRequests;
+    async->FrameRequests = async->LastFrameApplied = async->LastFrameDropped = 0;
+    async->LastFrameMs = 0.0f;
+    ImFontAsyncGlyphWorkers* workers = async->Workers;
+    if (workers == NULL || async->PendingCount == 0)
+        return;
+
+    // Apply completed jobs in request order until the budget is spent, rasterizing them here when there are no workers
+    const auto start_time = std::chrono::steady_clock::now();
+    const float budget_ms = (async->BudgetMs > 0.0f) ? async->BudgetMs : IM_FONTASYNCGLYPHS_DEFAULT_BUDGET_MS;
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    while (workers->ApplyHead < workers->Jobs.Size && async->LastFrameMs < budget_ms)
     {
-        if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
-            IM_ASSERT(tex->Updates.Size == 0);
-        if (tex->Status == ImTextureStatus_WantCreate)
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: create %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
-        else if (tex->Status == ImTextureStatus_WantDestroy)
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: destroy %dx%d, texid=0x%" IM_PRIX64 ", backend_data=%p\n", tex->UniqueID, tex->Width, tex->Height, IM_TEXTUREID_TO_U64(tex->TexID), tex->BackendUserData);
-        else if (tex->Status == ImTextureStatus_WantUpdates)
+        if (!workers->Jobs[workers->ApplyHead].Done)
         {
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update %d regions, texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, tex->Updates.Size, IM_TEXTUREID_TO_U64(tex->TexID), (ImU64)(intptr_t)tex->BackendUserData);
-            for (const ImTextureRect& r : tex->Updates)
-            {
-                IM_UNUSED(r);
-                IM_ASSERT(r.x >= 0 && r.y >= 0);
-                IM_ASSERT(r.x + r.w <= tex->Width && r.y + r.h <= tex->Height); // In theory should subtract PackPadding but it's currently part of atlas and mid-frame change would wreck assert.
-                //IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update (% 4d..%-4d)->(% 4d..%-4d), texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, r.x, r.y, r.x + r.w, r.y + r.h, IM_TEXTUREID_TO_U64(tex->TexID), (ImU64)(intptr_t)tex->BackendUserData);
-            }
+            if (workers->ThreadCount > 0 || !ImFontAsyncGlyphWorkersRunOne(workers, lock))
+                break;
+            continue;
         }
+        const ImFontAsyncGlyphJob job = workers->Jobs[workers->ApplyHead++];
+        lock.unlock();
+        if (ImFontAtlasAsyncGlyphApply(atlas, job))
+            async->LastFrameApplied++;
+        else
+            async->LastFrameDropped++;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        if (job.AddToGlyphCache)
+            ImFontAtlasGlyphCacheAdd(atlas, job.GlyphCacheEntry, job.Pixels);
+#endif
+        workers->FreeFunc(job.Pixels, workers->AllocUserData);
+        async->PendingCount--;
+        async->LastFrameMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+        lock.lock();
+    }
+    if (workers->ApplyHead == workers->Jobs.Size)
+    {
+        workers->Jobs.resize(0);
+        workers->ApplyHead = workers->QueueHead = 0;
     }
 }
-#endif
 
-//-------------------------------------------------------------------------
-// [SECTION] ImFontAtlas: backend for stb_truetype
-//-------------------------------------------------------------------------
-// (imstb_truetype.h in included near the top of this file, when IMGUI_ENABLE_STB_TRUETYPE is set)
-//-------------------------------------------------------------------------
+void ImFontAtlasAsyncGlyphsWait(ImFontAtlas* atlas)
+{
+    ImFontAsyncGlyphWorkers* workers = atlas->Builder ? atlas->Builder->AsyncGlyphs.Workers : NULL;
+    if (workers == NULL)
+        return;
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    while (ImFontAsyncGlyphWorkersRunOne(workers, lock)) {}
+    workers->WorkDone.wait(lock, [workers] { return workers->RunningCount == 0; });
+}
 
-#ifdef IMGUI_ENABLE_STB_TRUETYPE
+void ImFontAtlasAsyncGlyphsBuildBegin(ImFontAtlas* atlas)
+{
+    ImFontAsyncGlyphs* async = &atlas->Builder->AsyncGlyphs;
+    if (!async->ParallelBuildDisabled)
+        async->ParallelBuilding = true;
+}
 
-// One for each ConfigData
-struct ImGui_ImplStbTrueType_FontSrcData
+void ImFontAtlasAsyncGlyphsBuildEnd(ImFontAtlas* atlas)
 {
-    stbtt_fontinfo  FontInfo;
-    float           ScaleFactor;
-};
+    ImFontAsyncGlyphs* async = &atlas->Builder->AsyncGlyphs;
+    if (!async->ParallelBuilding)
+        return;
+    async->ParallelBuilding = false;
+    async->LastBuildGlyphs = async->LastBuildThreads = 0;
+    async->LastBuildWaitMs = 0.0f;
+    ImFontAsyncGlyphWorkers* workers = async->Workers;
+    if (workers == NULL)
+        return;
+
+    // Rasterize what is left, helping the workers
+    const auto start_time = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    while (ImFontAsyncGlyphWorkersRunOne(workers, lock)) {}
+    workers->WorkDone.wait(lock, [workers] { return workers->RunningCount == 0; });
+
+    // Packing is over and rectangles don't move anymore: blit in parallel, into disjoint rectangles
+    ImTextureData* tex = atlas->TexData;
+    const int job_begin = workers->ApplyHead;
+    workers->Blits.resize(workers->Jobs.Size);
+    for (int job_n = job_begin; job_n < workers->Jobs.Size; job_n++)
+    {
+        const ImFontAsyncGlyphJob& job = workers->Jobs[job_n];
+        ImFontAtlasPostProcessData* pp_data = &workers->Blits[job_n];
+        memset(pp_data, 0, sizeof(*pp_data));
+        ImFontBaked* baked = (ImFontBaked*)atlas->Builder->BakedMap.GetVoidPtr(job.BakedId);
+        if (baked == NULL || baked->WantDestroy || job.GlyphIdx >= baked->Glyphs.Size || baked->Glyphs[job.GlyphIdx].PackId != job.PackId)
+            continue;
+        ImFontGlyph* glyph = &baked->Glyphs[job.GlyphIdx];
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, job.PackId);
+        IM_ASSERT(r->x + r->w <= tex->Width && r->y + r->h <= tex->Height);
+        *pp_data = { atlas, baked->OwnerFont, baked->OwnerFont->Sources[glyph->SourceIdx], baked, glyph, tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h };
+    }
+    workers->BlitHead = job_begin;
+    workers->WorkAvailable.notify_all();
+    while (ImFontAsyncGlyphWorkersRunOne(workers, lock)) {}
+    workers->WorkDone.wait(lock, [workers] { return workers->RunningCount == 0; });
+
+    // Queue uploads in request order
+    for (int job_n = job_begin; job_n < workers->Jobs.Size; job_n++)
+    {
+        const ImFontAsyncGlyphJob& job = workers->Jobs[job_n];
+        if (workers->Blits[job_n].Pixels != NULL)
+        {
+            ImTextureRect* r = ImFontAtlasPackGetRect(atlas, job.PackId);
+            ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+        }
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        if (job.AddToGlyphCache)
+            ImFontAtlasGlyphCacheAdd(atlas, job.GlyphCacheEntry, job.Pixels);
+#endif
+        workers->FreeFunc(job.Pixels, workers->AllocUserData);
+        async->PendingCount--;
+    }
+    async->LastBuildGlyphs = workers->Jobs.Size - job_begin;
+    async->LastBuildThreads = workers->ThreadCount + 1;
+    workers->Jobs.resize(0);
+    workers->Blits.resize(0);
+    workers->ApplyHead = workers->QueueHead = workers->BlitHead = 0;
+    async->LastBuildWaitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+void ImFontAtlasAsyncGlyphsShutdown(ImFontAtlas* atlas)
+{
+    ImFontAsyncGlyphs* async = atlas->Builder ? &atlas->Builder->AsyncGlyphs : NULL;
+    if (async == NULL || async->Workers == NULL)
+        return;
+    ImFontAsyncGlyphWorkers* workers = async->Workers;
+    {
+        std::lock_guard<std::mutex> lock(workers->Mutex);
+        workers->Shutdown = true;
+    }
+    workers->WorkAvailable.notify_all();
+    for (int n = 0; n < workers->ThreadCount; n++)
+        workers->Threads[n].join();
+    for (int job_n = workers->ApplyHead; job_n < workers->Jobs.Size; job_n++) // Applied jobs were freed already
+        if (workers->Jobs[job_n].Pixels != NULL)
+            workers->FreeFunc(workers->Jobs[job_n].Pixels, workers->AllocUserData);
+    IM_DELETE(workers);
+    async->Workers = NULL;
+    async->PendingCount = 0;
+}
+#endif // IMGUI_ENABLE_ASYNC_GLYPHS
 
 static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig* src)
 {
@@ -4597,6 +6803,9 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
         return false;
     }
     src->FontLoaderData = bd_font_data;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    bd_font_data->FontDataHash = 0;
+#endif
 
     const float ref_size = src->DstFont->Sources[0]->SizePixels;
     if (src->MergeMode && src->SizePixels == 0.0f)
@@ -4615,6 +6824,9 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
 static void ImGui_ImplStbTrueType_FontSrcDestroy(ImFontAtlas* atlas, ImFontConfig* src)
 {
     IM_UNUSED(atlas);
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAtlasAsyncGlyphsWait(atlas); // Jobs in flight read the font info
+#endif
     ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
     IM_DELETE(bd_font_data);
     src->FontLoaderData = NULL;
@@ -4645,9 +6857,76 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
         stbtt_GetFontVMetrics(&bd_font_data->FontInfo, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
         baked->Ascent = ImCeil(unscaled_ascent * scale_for_layout);
         baked->Descent = ImFloor(unscaled_descent * scale_for_layout);
+#ifdef IMGUI_ENABLE_SDF_FONTS
+        // Scaled to every size: rounding here would move the baseline by up to a pixel times the scale
+        if (ImFontBakedIsDistanceField(baked))
+        {
+            baked->Ascent = unscaled_ascent * scale_for_layout;
+            baked->Descent = unscaled_descent * scale_for_layout;
+        }
+#endif
+    }
+    return true;
+}
+
+#ifdef IMGUI_ENABLE_SDF_FONTS
+// Distance field bake (see ImFontAtlasSdf): rasterized at the bake size without density nor oversampling, scaled when rendering
+static bool ImGui_ImplStbTrueType_FontBakedLoadGlyphSdf(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, ImGui_ImplStbTrueType_FontSrcData* bd_font_data, int glyph_index, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
+{
+    const float scale = bd_font_data->ScaleFactor * baked->Size;
+    int advance, lsb;
+    stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
+
+    // Load metrics only mode
+    if (out_advance_x != NULL)
+    {
+        IM_ASSERT(out_glyph == NULL);
+        *out_advance_x = advance * scale;
+        return true;
+    }
+
+    // Prepare glyph
+    out_glyph->Codepoint = codepoint;
+    out_glyph->AdvanceX = advance * scale;
+
+    // 128 on the edge, -32 per pixel away from it: 0 or 255 past IM_FONTSDF_PADDING pixels
+    const unsigned char on_edge_value = 128;
+    int w, h, x0, y0;
+    unsigned char* sdf_pixels = stbtt_GetGlyphSDF(&bd_font_data->FontInfo, scale, glyph_index, IM_FONTSDF_PADDING, on_edge_value, (float)on_edge_value / IM_FONTSDF_PADDING, &w, &h, &x0, &y0);
+    if (sdf_pixels == NULL)
+        return true; // Invisible glyph
+
+    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
+    if (pack_id == ImFontAtlasRectId_Invalid)
+    {
+        // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
+        IM_ASSERT(pack_id != ImFontAtlasRectId_Invalid && "Out of texture memory.");
+        stbtt_FreeSDF(sdf_pixels, bd_font_data->FontInfo.userdata);
+        return false;
     }
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
+
+    const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
+    const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
+    const float font_off_x = (src->GlyphOffset.x * offsets_scale);
+    const float font_off_y = (src->GlyphOffset.y * offsets_scale) + baked->Ascent; // Not rounded, see ImGui_ImplStbTrueType_FontBakedInit()
+
+    // Register glyph
+    out_glyph->X0 = x0 + font_off_x;
+    out_glyph->Y0 = y0 + font_off_y;
+    out_glyph->X1 = (x0 + w) + font_off_x;
+    out_glyph->Y1 = (y0 + h) + font_off_y;
+    out_glyph->Visible = true;
+    out_glyph->PackId = pack_id;
+    ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, sdf_pixels, ImTextureFormat_Alpha8, w);
+    stbtt_FreeSDF(sdf_pixels, bd_font_data->FontInfo.userdata);
+
+    ImFontAtlasSdf* sdf = &atlas->Builder->Sdf;
+    sdf->GlyphCount++;
+    sdf->GlyphSurface += w * h;
     return true;
 }
+#endif
 
 static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph, float* out_advance_x)
 {
@@ -4657,6 +6936,10 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     int glyph_index = stbtt_FindGlyphIndex(&bd_font_data->FontInfo, (int)codepoint);
     if (glyph_index == 0)
         return false;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    if (ImFontBakedIsDistanceField(baked))
+        return ImGui_ImplStbTrueType_FontBakedLoadGlyphSdf(atlas, src, baked, bd_font_data, glyph_index, codepoint, out_glyph, out_advance_x);
+#endif
 
     // Fonts unit to pixels
     int oversample_h, oversample_v;
@@ -4669,8 +6952,36 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     // Obtain size and advance
     int x0, y0, x1, y1;
     int advance, lsb;
-    stbtt_GetGlyphBitmapBoxSubpixel(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
-    stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+    const bool rasterize_scalar = GImFontRasterizeScalar; // Read once: the same for the cache key and the (possibly async) rasterization
+#else
+    const bool rasterize_scalar = false;
+#endif
+    IM_UNUSED(rasterize_scalar);
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    // Metrics and bitmap from a previous run (see ImFontGlyphCache). Metrics only requests don't look it up.
+    ImFontGlyphCacheEntry cache_entry = {};
+    const ImFontGlyphCacheEntry* cached = NULL;
+    const bool use_glyph_cache = out_advance_x == NULL && atlas->GlyphCacheFilename != NULL && !atlas->Builder->GlyphCache.Disabled;
+    if (use_glyph_cache)
+    {
+        ImGui_ImplStbTrueType_GlyphCacheGetKey(bd_font_data, src, glyph_index, scale_for_raster_x, scale_for_raster_y, oversample_h, oversample_v, rasterize_scalar, &cache_entry);
+        cached = ImFontAtlasGlyphCacheFind(atlas, cache_entry.KeyLo, cache_entry.KeyHi);
+    }
+    if (cached != NULL)
+    {
+        // A box giving the same packed size
+        x0 = y0 = 0;
+        x1 = cached->Width ? cached->Width - oversample_h + 1 : 0;
+        y1 = cached->Height ? cached->Height - oversample_v + 1 : 0;
+        advance = cached->AdvanceX;
+    }
+    else
+#endif
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, 0, 0, &x0, &y0, &x1, &y1);
+        stbtt_GetGlyphHMetrics(&bd_font_data->FontInfo, glyph_index, &advance, &lsb);
+    }
 
     // Load metrics only mode
     if (out_advance_x != NULL)
@@ -4701,17 +7012,71 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
 
         // Render
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        if (cached != NULL)
+        {
+            x0 = cached->X0;
+            y0 = cached->Y0;
+        }
+        else
+#endif
         stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        cache_entry.X0 = (ImS16)x0;
+        cache_entry.Y0 = (ImS16)y0;
+        cache_entry.Width = (ImU16)w;
+        cache_entry.Height = (ImU16)h;
+        cache_entry.AdvanceX = advance;
+#endif
         ImFontAtlasBuilder* builder = atlas->Builder;
-        builder->TempBuffer.resize(w * h * 1);
-        unsigned char* bitmap_pixels = builder->TempBuffer.Data;
-        memset(bitmap_pixels, 0, w * h * 1);
-
-        // Render with oversampling
-        // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
+        const unsigned char* bitmap_pixels = NULL;
         float sub_x, sub_y;
-        stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, bitmap_pixels, w, h, w,
-            scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        if (cached != NULL)
+        {
+            // Same offsets as stbtt_MakeGlyphBitmapSubpixelPrefilter() gives
+            bitmap_pixels = (const unsigned char*)(cached + 1);
+            sub_x = stbtt__oversample_shift(oversample_h);
+            sub_y = stbtt__oversample_shift(oversample_v);
+        }
+        else
+#endif
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        if (ImFontAtlasAsyncGlyphsEnabled(atlas))
+        {
+            // Leave the rectangle blank, a worker renders the same bitmap (see ImFontAsyncGlyphs)
+            ImFontAsyncGlyphJob job = { &bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, oversample_h, oversample_v, w, h, baked->BakedId, baked->Glyphs.Size, pack_id, NULL, false,
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+                use_glyph_cache, cache_entry,
+#endif
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+                rasterize_scalar,
+#endif
+            };
+            ImFontAtlasAsyncGlyphsRequest(atlas, job);
+            sub_x = stbtt__oversample_shift(oversample_h);
+            sub_y = stbtt__oversample_shift(oversample_v);
+        }
+        else
+#endif
+        {
+            builder->TempBuffer.resize(w * h * 1);
+            unsigned char* pixels = builder->TempBuffer.Data;
+            memset(pixels, 0, w * h * 1);
+
+            // Render with oversampling
+            // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+            GImFontRasterizeScalarCurrent = rasterize_scalar;
+#endif
+            stbtt_MakeGlyphBitmapSubpixelPrefilter(&bd_font_data->FontInfo, pixels, w, h, w,
+                scale_for_raster_x, scale_for_raster_y, 0, 0, oversample_h, oversample_v, &sub_x, &sub_y, glyph_index);
+            bitmap_pixels = pixels;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+            if (use_glyph_cache)
+                ImFontAtlasGlyphCacheAdd(atlas, cache_entry, pixels);
+#endif
+        }
 
         const float ref_size = baked->OwnerFont->Sources[0]->SizePixels;
         const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
@@ -4735,8 +7100,16 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         out_glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
         out_glyph->Visible = true;
         out_glyph->PackId = pack_id;
-        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
+        if (bitmap_pixels != NULL)
+            ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
     }
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    else if (use_glyph_cache && cached == NULL)
+    {
+        cache_entry.AdvanceX = advance;
+        ImFontAtlasGlyphCacheAdd(atlas, cache_entry, NULL);
+    }
+#endif
 
     return true;
 }
@@ -5149,7 +7522,27 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
         glyph->V0 = (r->y) * atlas->TexUvScale.y;
         glyph->U1 = (r->x + r->w) * atlas->TexUvScale.x;
         glyph->V1 = (r->y + r->h) * atlas->TexUvScale.y;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+        if (ImFontBakedIsDistanceField(baked))
+        {
+            glyph->U0 += IM_FONTSDF_UV_OFFSET; // Tells the backend to sample a distance
+            glyph->U1 += IM_FONTSDF_UV_OFFSET;
+        }
+#endif
         baked->MetricsTotalSurface += r->w * r->h;
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+        glyph->LastUsedFrame = atlas->Builder->FrameCount;
+        ImFontAtlasBudget* budget = &atlas->Builder->Budget;
+        if (budget->Evicted.Data.Size > 0)
+        {
+            const ImGuiID key = ImFontAtlasBudgetGetGlyphKey(baked, glyph->Codepoint);
+            if (budget->Evicted.GetInt(key, 0) != 0)
+            {
+                budget->Evicted.SetInt(key, 0);
+                budget->Rerasterized++;
+            }
+        }
+#endif
     }
 
     if (src != NULL)
@@ -5319,6 +7712,14 @@ ImFontBaked* ImFont::GetFontBaked(float size, float density)
 
     if (density < 0.0f)
         density = CurrentRasterizerDensity;
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    // One distance field bake serves all sizes and densities (see ImFontAtlasSdf)
+    if ((Flags & ImFontFlags_DistanceField) && OwnerAtlas->Builder->Sdf.Enabled)
+    {
+        size = IM_FONTSDF_BAKE_SIZE;
+        density = 0.0f;
+    }
+#endif
     if (baked && baked->Size == size && baked->RasterizerDensity == density)
         return baked;
 
@@ -5336,7 +7737,11 @@ ImFontBaked* ImFontAtlasBakedGetOrAdd(ImFontAtlas* atlas, ImFont* font, float fo
 {
     // FIXME-NEWATLAS: Design for picking a nearest size based on some criteria?
     // FIXME-NEWATLAS: Altering font density won't work right away.
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    IM_ASSERT(font_size > 0.0f && font_rasterizer_density >= 0.0f); // 0.0f: distance field bake
+#else
     IM_ASSERT(font_size > 0.0f && font_rasterizer_density > 0.0f);
+#endif
     ImGuiID baked_id = ImFontAtlasBakedGetId(font->FontId, font_size, font_rasterizer_density);
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontBaked** p_baked_in_map = (ImFontBaked**)builder->BakedMap.GetVoidPtrRef(baked_id);
@@ -5582,6 +7987,40 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
 
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** out_remaining)
 {
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    // Memoize the common case, which only depends on the text and font
+    ImFontAtlasBuilder* builder = OwnerAtlas->Builder;
+    if (builder != NULL && max_width == FLT_MAX && out_remaining == NULL)
+    {
+        ImFontTextSizeCache* cache = &builder->TextSizes;
+        if (!text_end)
+            text_end = text_begin + ImStrlen(text_begin);
+        ImGuiID key;
+        ImVec2 text_size;
+        if (ImFontTextSizeCacheFind(cache, builder->FrameCount, GetFontBaked(size), size, wrap_width, text_begin, text_end, &key, &text_size))
+        {
+            cache->FrameHits++;
+            if (cache->Verify)
+            {
+                const ImVec2 computed_size = ImFontCalcTextSizeEx(this, size, max_width, wrap_width, text_begin, text_end, text_end, NULL, NULL, ImDrawTextFlags_None);
+                if (computed_size.x != text_size.x || computed_size.y != text_size.y)
+                {
+                    IMGUI_DEBUG_LOG_FONT("[font] Text size cache: \"%.*s\" cached %.2fx%.2f, computed %.2fx%.2f\n", (int)(text_end - text_begin), text_begin, text_size.x, text_size.y, computed_size.x, computed_size.y);
+                    cache->VerifyFailures++;
+                }
+                return computed_size;
+            }
+            return text_size;
+        }
+        text_size = ImFontCalcTextSizeEx(this, size, max_width, wrap_width, text_begin, text_end, text_end, NULL, NULL, ImDrawTextFlags_None);
+        if (key != 0)
+        {
+            cache->FrameMisses++;
+            ImFontTextSizeCacheAdd(cache, key, builder->FrameCount, text_begin, text_end, text_size);
+        }
+        return text_size;
+    }
+#endif
     return ImFontCalcTextSizeEx(this, size, max_width, wrap_width, text_begin, text_end, text_end, out_remaining, NULL, ImDrawTextFlags_None);
 }
 
@@ -5592,6 +8031,9 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     const ImFontGlyph* glyph = baked->FindGlyph(c);
     if (!glyph || !glyph->Visible)
         return;
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    ((ImFontGlyph*)glyph)->LastUsedFrame = OwnerAtlas->Builder->FrameCount;
+#endif
     if (glyph->Colored)
         col |= ~IM_COL32_A_MASK;
     float scale = (size >= 0.0f) ? (size / baked->Size) : 1.0f;
@@ -5645,6 +8087,33 @@ begin:
     const float origin_x = x;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
 
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    // Replay the vertices of a previous call with the same text when they are not clipped.
+    // Runs are only captured from calls that didn't clip anything, so the output is the same.
+    ImFontGlyphRunCache* run_cache = (OwnerAtlas->Builder != NULL && !OwnerAtlas->Builder->GlyphRuns.Disabled && text_end - text_begin <= IM_FONTGLYPHRUN_MAX_TEXT_LENGTH) ? &OwnerAtlas->Builder->GlyphRuns : NULL;
+    ImGuiID run_key = 0;
+    if (run_cache != NULL)
+    {
+        run_key = ImFontGlyphRunCacheGetKey(baked, size, wrap_width, flags, text_begin, text_end);
+        if (ImFontGlyphRun* run = ImFontGlyphRunCacheFind(run_cache, run_key, text_begin, text_end))
+        {
+            if (x + run->Min.x >= clip_rect.x && y + run->Min.y >= clip_rect.y && x + run->Max.x <= clip_rect.z && y + run->Max.y <= clip_rect.w)
+            {
+                ImFontGlyphRunCacheBlit(run_cache, run, draw_list, x, y, col);
+                run->LastUsedFrame = OwnerAtlas->Builder->FrameCount;
+                run_cache->FrameHits++;
+                return;
+            }
+        }
+    }
+    const int run_generation = run_cache ? run_cache->Generation : 0;
+    const float origin_y = y;
+    bool clipped = false;
+    bool any_colored = false;
+#else
+    IM_UNUSED(flags);
+#endif
+
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y)
@@ -5664,6 +8133,9 @@ begin:
                 s = line_end ? line_end + 1 : text_end;
             }
             y += line_height;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+            clipped = true;
+#endif
         }
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
@@ -5693,9 +8165,17 @@ begin:
     unsigned int vtx_index = draw_list->_VtxCurrentIdx;
     const int cmd_count = draw_list->CmdBuffer.Size;
     const bool cpu_fine_clip = (flags & ImDrawTextFlags_CpuFineClip) != 0;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImDrawVert* const run_vtx_begin = vtx_write;
+    ImDrawIdx* const run_idx_begin = idx_write;
+    const unsigned int run_vtx_index = vtx_index;
+#endif
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    const int frame_count = OwnerAtlas->Builder->FrameCount;
+#endif
 
     while (s < text_end)
     {
@@ -5710,7 +8190,12 @@ begin:
                 x = origin_x;
                 y += line_height;
                 if (y > clip_rect.w)
+                {
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+                    clipped = true;
+#endif
                     break; // break out of main loop
+                }
                 word_wrap_eol = NULL;
                 s = ImTextCalcWordWrapNextLineStart(s, text_end, flags); // Wrapping skips upcoming blanks
                 continue;
@@ -5731,7 +8216,12 @@ begin:
                 x = origin_x;
                 y += line_height;
                 if (y > clip_rect.w)
+                {
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+                    clipped = true;
+#endif
                     break; // break out of main loop
+                }
                 continue;
             }
             if (c == '\r')
@@ -5745,6 +8235,9 @@ begin:
         float char_width = glyph->AdvanceX * scale;
         if (glyph->Visible)
         {
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+            ((ImFontGlyph*)glyph)->LastUsedFrame = frame_count;
+#endif
             // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
             float x1 = x + glyph->X0 * scale;
             float x2 = x + glyph->X1 * scale;
@@ -5759,6 +8252,10 @@ begin:
                 float v2 = glyph->V1;
 
                 // CPU side clipping used to fit text in their frame when the frame is too small. Only does clipping for axis aligned quads.
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+                if (cpu_fine_clip && (x1 < clip_rect.x || y1 < clip_rect.y || x2 > clip_rect.z || y2 > clip_rect.w))
+                    clipped = true;
+#endif
                 if (cpu_fine_clip)
                 {
                     if (x1 < clip_rect.x)
@@ -5790,6 +8287,9 @@ begin:
 
                 // Support for untinted glyphs
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+                any_colored |= glyph->Colored;
+#endif
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                 {
@@ -5804,6 +8304,12 @@ begin:
                     idx_write += 6;
                 }
             }
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+            else
+            {
+                clipped = true;
+            }
+#endif
         }
         x += char_width;
     }
@@ -5829,6 +8335,20 @@ begin:
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_index;
+
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    // Capture on the second sighting, a text that is only drawn once is not worth the copy.
+    // A colored glyph drawn in white can't be told apart from the others, don't capture those.
+    if (run_cache != NULL)
+    {
+        run_cache->FrameMisses++;
+        if (run_cache->Seen.GetInt(run_key, -1) < 0)
+            run_cache->Seen.SetInt(run_key, OwnerAtlas->Builder->FrameCount);
+        else if (!clipped && run_generation == run_cache->Generation && !(any_colored && col == col_untinted))
+            ImFontGlyphRunCacheAdd(run_cache, run_key, OwnerAtlas->Builder->FrameCount, text_begin, text_end, ImVec2(origin_x, origin_y),
+                run_vtx_begin, (int)(vtx_write - run_vtx_begin), run_idx_begin, (int)(idx_write - run_idx_begin), run_vtx_index, any_colored ? col_untinted : 0);
+    }
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -72,6 +72,53 @@ Index of this file:
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
 #endif
+// ARMv8 CRC32 extension (-march=armv8-a+crc, always available on Apple Silicon)
+#if defined(__ARM_FEATURE_CRC32) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER)
+#define IMGUI_ENABLE_ARM_CRC32
+#include <arm_acle.h>
+#endif
+// SSE2 integer operations (always available on x64) are used by the UTF-8 kernels and the polygon fill indices.
+// AVX2 (e.g. -mavx2) is only used by the UTF-8 text kernels so far, NEON (always available on AArch64) by the UTF-8, polyline and polygon fill kernels.
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_ENABLE_SSE2
+#endif
+#if defined(IMGUI_ENABLE_SSE) && defined(__AVX2__)
+#define IMGUI_ENABLE_AVX2
+#endif
+#if (defined(__aarch64__) || defined(_M_ARM64)) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+// Bytes processed at a time by the ImTextCountCharsFromUtf8()/ImTextStrFromUtf8() fast paths, 0 when only the scalar decoder is available.
+#if defined(IMGUI_ENABLE_AVX2)
+#define IMGUI_TEXT_UTF8_BLOCK   32
+#elif defined(IMGUI_ENABLE_NEON) || defined(IMGUI_ENABLE_SSE2)
+#define IMGUI_TEXT_UTF8_BLOCK   16
+#else
+#define IMGUI_TEXT_UTF8_BLOCK   0
+#endif
+
+// Hash backend used by ImHashData()/ImHashStr() to compute IDs. Define IMGUI_HASH_BACKEND in imconfig.h to override the automatic selection.
+// The CRC32 backends all produce the same IDs, WYHASH produces different IDs (so .ini data from a CRC32 build won't match).
+#define IMGUI_HASH_BACKEND_CRC32_TABLE  0   // Byte-at-a-time CRC32c with a 1KB table (portable)
+#define IMGUI_HASH_BACKEND_CRC32_SSE4_2 1   // SSE 4.2 _mm_crc32_xx, 8 bytes at a time
+#define IMGUI_HASH_BACKEND_CRC32_ARM    2   // ARMv8 __crc32cx, 8 bytes at a time
+#define IMGUI_HASH_BACKEND_WYHASH       3   // wyhash (64-bit multiply-mix, folded to 32-bit), no table and no special instructions
+#ifndef IMGUI_HASH_BACKEND
+#if defined(IMGUI_ENABLE_SSE4_2_CRC)
+#define IMGUI_HASH_BACKEND IMGUI_HASH_BACKEND_CRC32_SSE4_2
+#elif defined(IMGUI_ENABLE_ARM_CRC32)
+#define IMGUI_HASH_BACKEND IMGUI_HASH_BACKEND_CRC32_ARM
+#else
+#define IMGUI_HASH_BACKEND IMGUI_HASH_BACKEND_CRC32_TABLE
+#endif
+#endif
+#if IMGUI_HASH_BACKEND == IMGUI_HASH_BACKEND_CRC32_SSE4_2 && !defined(IMGUI_ENABLE_SSE4_2_CRC)
+#error "IMGUI_HASH_BACKEND_CRC32_SSE4_2 requires SSE 4.2 (e.g. -msse4.2)"
+#endif
+#if IMGUI_HASH_BACKEND == IMGUI_HASH_BACKEND_CRC32_ARM && !defined(IMGUI_ENABLE_ARM_CRC32)
+#error "IMGUI_HASH_BACKEND_CRC32_ARM requires the ARMv8 CRC32 extension (e.g. -march=armv8-a+crc)"
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -127,6 +174,9 @@ Index of this file:
 #ifndef IMGUI_ENABLE_FREETYPE
 #define IMGUI_ENABLE_STB_TRUETYPE
 #endif
+#if defined(IMGUI_ENABLE_ASYNC_GLYPHS) && !defined(IMGUI_ENABLE_STB_TRUETYPE)
+#error "IMGUI_ENABLE_ASYNC_GLYPHS requires the stb_truetype font loader."
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] Forward declarations
@@ -144,6 +194,11 @@ struct ImDrawListSharedData;        // Data shared between all ImDrawList instan
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
+struct ImFontGlyphRun;              // Cached vertices/indices of a rendered text
+struct ImFontGlyphRunCache;         // Cache of ImFontGlyphRun, owned by ImFontAtlasBuilder
+struct ImFontTextSizeCache;         // Cache of ImFont::CalcTextSizeA() results, owned by ImFontAtlasBuilder
+struct ImFontAsyncGlyphs;           // Background glyph rasterization, owned by ImFontAtlasBuilder
+struct ImFontAtlasPages;            // Paged atlas texture state, owned by ImFontAtlasBuilder
 
 // ImGui
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
@@ -368,6 +423,16 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
 IMGUI_API const char*   ImHashSkipUncontributingPrefix(const char* label);
+// Hash kernels behind ImHashData()/ImHashStr(), IMGUI_HASH_BACKEND selects which one is used.
+// All the kernels supported by the target are available for benchmarking and testing.
+IMGUI_API ImGuiID       ImHashDataCrc32Table(const void* data, size_t data_size, ImGuiID seed);
+#ifdef IMGUI_ENABLE_SSE4_2_CRC
+IMGUI_API ImGuiID       ImHashDataCrc32SSE42(const void* data, size_t data_size, ImGuiID seed);
+#endif
+#ifdef IMGUI_ENABLE_ARM_CRC32
+IMGUI_API ImGuiID       ImHashDataCrc32Arm(const void* data, size_t data_size, ImGuiID seed);
+#endif
+IMGUI_API ImGuiID       ImHashDataWyhash(const void* data, size_t data_size, ImGuiID seed);
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -846,6 +911,19 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawList: Anti-aliased polyline kernels used by AddPolyline().
+// - Normals: one per segment (closed: points_count, open: points_count - 1, the last point copies the previous one).
+// - Edges: 'offsets_count' points per line point, at point + averaged normal * offsets[n]. Open lines use the normal itself for the first point.
+// The SIMD kernels do 4 points per iteration and give the same results as the scalar ones (except for compilers contracting the scalar math into FMAs).
+// All the kernels supported by the target are available for benchmarking and testing.
+IMGUI_API void          ImPolylineNormalsScalar(const ImVec2* points, int points_count, bool closed, ImVec2* out_normals);
+IMGUI_API void          ImPolylineEdgesScalar(const ImVec2* points, const ImVec2* normals, int points_count, bool closed, const float* offsets, int offsets_count, ImVec2* out_edges);
+#if defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)
+#define IMGUI_ENABLE_POLYLINE_SIMD
+IMGUI_API void          ImPolylineNormalsSIMD(const ImVec2* points, int points_count, bool closed, ImVec2* out_normals);
+IMGUI_API void          ImPolylineEdgesSIMD(const ImVec2* points, const ImVec2* normals, int points_count, bool closed, const float* offsets, int offsets_count, ImVec2* out_edges);
+#endif
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -3829,6 +3907,356 @@ typedef stbrp_node stbrp_node_im;
 #endif
 struct stbrp_context_opaque { char data[80]; };
 
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+// Glyph-run cache: vertices and indices ImFont::RenderText() emitted for a whole text, relative to its (truncated) position.
+// - A text is cached the second time it is rendered unclipped (so text changing every frame doesn't churn the cache).
+// - Hits are blitted when their bounding box fits the clip rectangle: translate positions, patch colors, offset indices.
+// - Everything is dropped when the atlas repacks or discards bakes/glyphs (UVs change). Runs unused for a while are compacted away.
+#define IM_FONTGLYPHRUN_MAX_TEXT_LENGTH     256                 // Longer texts are not cached
+#define IM_FONTGLYPHRUN_DEFAULT_BUDGET      (2 * 1024 * 1024)   // Bytes
+#define IM_FONTGLYPHRUN_UNUSED_FRAMES       60                  // Runs unused for this many frames are discarded
+
+struct ImFontGlyphRun
+{
+    ImGuiID             Key;                // Hash of baked id, size, wrap width, flags and text
+    int                 TextOffset;         // Into ImFontGlyphRunCache::Text, hits compare the text to rule out hash collisions
+    int                 TextLength;
+    int                 VtxOffset, VtxCount;// Into ImFontGlyphRunCache::Vtx
+    int                 IdxOffset, IdxCount;// Into ImFontGlyphRunCache::Idx, relative to the first vertex of the run
+    ImVec2              Min, Max;           // Bounding box of the vertices
+    int                 LastUsedFrame;
+};
+
+struct ImFontGlyphRunCache
+{
+    ImVector<ImFontGlyphRun> Runs;          // In Vtx/Idx/Text offset order
+    ImGuiStorage        Map;                // Key -> index into Runs[]
+    ImGuiStorage        Seen;               // Key -> frame, texts rendered once (candidates)
+    ImVector<ImDrawVert> Vtx;               // col is 1 for colored glyphs (untinted), 0 otherwise
+    ImVector<ImDrawIdx> Idx;
+    ImVector<char>      Text;
+    int                 Generation;         // Incremented by ImFontAtlasGlyphRunsClear(), captures started before are not stored
+    int                 BudgetBytes;        // 0: IM_FONTGLYPHRUN_DEFAULT_BUDGET. Nothing is captured past it, runs unused last frame are dropped past 3/4 of it
+    bool                Disabled;           // Runtime switch, for A/B comparisons
+
+    // Stats
+    int                 FrameHits;          // Current frame
+    int                 FrameMisses;        // Current frame, cacheable texts that were not in the cache (including first sightings)
+    int                 LastFrameHits;
+    int                 LastFrameMisses;
+    int                 ClearCount;         // Invalidations by the atlas
+
+    int                 GetResidentBytes() const { return Runs.size_in_bytes() + Vtx.size_in_bytes() + Idx.size_in_bytes() + Text.size_in_bytes(); }
+};
+
+IMGUI_API void              ImFontAtlasGlyphRunsClear(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasGlyphRunsNewFrame(ImFontAtlas* atlas);
+#endif
+
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+// Text size cache: results of ImFont::CalcTextSizeA() without max width or remaining output (what ImGui::CalcTextSize() uses).
+// - Keyed by baked id, size, wrap width and text hash. The text is stored too, hits compare it to rule out hash collisions.
+// - Least recently used entries are evicted by whole frames once 3/4 of the budget is reached, nothing is added past it.
+// - Everything is dropped when the atlas discards bakes/glyphs (advances may change).
+#define IM_FONTTEXTSIZE_MAX_TEXT_LENGTH     256                 // Longer texts are not cached
+#define IM_FONTTEXTSIZE_DEFAULT_BUDGET      (256 * 1024)        // Bytes
+
+struct ImFontTextSizeEntry
+{
+    ImGuiID             Key;                // Hash of baked id, size, wrap width and text
+    int                 TextOffset;         // Into ImFontTextSizeCache::Text
+    int                 TextLength;
+    ImVec2              Size;
+    int                 LastUsedFrame;
+};
+
+struct ImFontTextSizeCache
+{
+    ImVector<ImFontTextSizeEntry> Entries;  // In Text offset order
+    ImGuiStorage        Map;                // Key -> index into Entries[]
+    ImVector<char>      Text;
+    int                 BudgetBytes;        // 0: IM_FONTTEXTSIZE_DEFAULT_BUDGET
+    bool                Disabled;           // Runtime switch, for A/B comparisons
+    bool                Verify;             // Recompute on hits and count differences in VerifyFailures (correctness mode, as slow as disabled)
+
+    // Stats
+    int                 FrameHits;          // Current frame
+    int                 FrameMisses;        // Current frame, cacheable calls that were not in the cache
+    int                 LastFrameHits;
+    int                 LastFrameMisses;
+    int                 EvictedCount;       // Entries evicted to stay in the budget
+    int                 ClearCount;         // Invalidations by the atlas
+    int                 VerifyFailures;
+
+    int                 GetResidentBytes() const { return Entries.size_in_bytes() + Map.Data.size_in_bytes() + Text.size_in_bytes(); }
+};
+
+IMGUI_API void              ImFontAtlasTextSizesClear(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextSizesNewFrame(ImFontAtlas* atlas);
+#endif
+
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+// Async glyphs: the stb_truetype loader resolves metrics and packs the rectangle right away, the bitmap is rasterized on worker threads.
+// - The glyph is added as usual and renders blank meanwhile (its rectangle was never used since the texture was created or repacked, so it is cleared).
+// - Completed bitmaps are applied by ImFontAtlasUpdateNewFrame() in request order, within a time budget (at least one per frame). Without workers they are rasterized there too.
+// - Results are dropped when their baked or glyph was discarded meanwhile. Font sources wait for the jobs in flight before being destroyed.
+// - Only used with ImGuiBackendFlags_RendererHasTextures, legacy backends upload the atlas once.
+// - Parallel build: ImFontAtlasBuildLegacyPreloadAllGlyphRanges() (legacy backends, ImFontAtlas::Build()) queues its glyphs the same way,
+//   packing them single-threaded in the usual order while the workers rasterize. Once everything is packed, the workers and the calling
+//   thread blit the bitmaps into their (disjoint) rectangles and uploads are queued in request order: the atlas doesn't depend on the
+//   number of threads, and matches a serial build.
+#define IM_FONTASYNCGLYPHS_DEFAULT_WORKERS      2
+#define IM_FONTASYNCGLYPHS_MAX_WORKERS          8
+#define IM_FONTASYNCGLYPHS_DEFAULT_BUDGET_MS    1.0f
+
+struct ImFontAsyncGlyphWorkers;     // Threads and job queue, defined in imgui_draw.cpp
+
+struct ImFontAsyncGlyphs
+{
+    ImFontAsyncGlyphWorkers* Workers;       // Created by the first request
+    int                 WorkerCount;        // 0: IM_FONTASYNCGLYPHS_DEFAULT_WORKERS, <0: no threads. Read when the workers are created
+    float               BudgetMs;           // 0: IM_FONTASYNCGLYPHS_DEFAULT_BUDGET_MS. Main thread time per frame spent applying (and without workers, rasterizing) glyphs
+    bool                Disabled;           // Runtime switch, for A/B comparisons: rasterize in the loader again
+    bool                ParallelBuildDisabled; // Runtime switch, for A/B comparisons: preload glyph ranges serially again
+    bool                ParallelBuilding;   // Between ImFontAtlasAsyncGlyphsBuildBegin() and ImFontAtlasAsyncGlyphsBuildEnd()
+
+    // Stats
+    int                 PendingCount;       // Requested and not applied yet
+    int                 FrameRequests;      // Current frame
+    int                 LastFrameRequests;
+    int                 LastFrameApplied;
+    int                 LastFrameDropped;   // Results of discarded bakes/glyphs
+    float               LastFrameMs;        // Main thread time of the last ImFontAtlasAsyncGlyphsNewFrame()
+    int                 LastBuildGlyphs;    // Rasterized by the last parallel build
+    int                 LastBuildThreads;   // Workers + calling thread
+    float               LastBuildWaitMs;    // Time the last parallel build spent after packing: rasterizing what was left, then blitting
+};
+
+IMGUI_API void              ImFontAtlasAsyncGlyphsNewFrame(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasAsyncGlyphsWait(ImFontAtlas* atlas);     // Rasterize all requests (helping the workers), results are applied by the next NewFrame
+IMGUI_API void              ImFontAtlasAsyncGlyphsShutdown(ImFontAtlas* atlas); // Join the workers, drop what was not applied
+IMGUI_API void              ImFontAtlasAsyncGlyphsBuildBegin(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasAsyncGlyphsBuildEnd(ImFontAtlas* atlas);  // Rasterize and blit everything queued since ImFontAtlasAsyncGlyphsBuildBegin()
+#endif
+
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+// Paged atlas: once the texture reaches PageSize in both dimensions, ImFontAtlasTextureMakeSpace() appends a page below the existing
+// ones instead of creating a bigger texture and repacking everything into it. Existing glyphs keep their position and UVs, and the
+// backend keeps the existing pages on the GPU (ImGuiBackendFlags_RendererHasTexturePages), only the new rectangles get uploaded.
+// - V coordinates are in page units (ImTextureData::PageHeight), their integer part is the page index. Packed rectangles never cross pages.
+// - The packer fills pages in order, space discarded in previous pages is only reclaimed by a repack.
+// - Pages are appended up to atlas->TexMaxHeight, even with discarded space. Then the texture repacks (20% discarded heuristic) or
+//   grows as usual, into pages of the same size.
+#define IM_FONTATLASPAGES_DEFAULT_PAGE_SIZE     1024
+
+struct ImFontAtlasPages
+{
+    int                 PageSize;           // 0: IM_FONTATLASPAGES_DEFAULT_PAGE_SIZE. Power of two, read when the texture needs space
+    bool                Disabled;           // Runtime switch, for A/B comparisons: grow and repack into single page textures again
+    int                 PackPage;           // Page the packer is filling
+
+    // Stats
+    int                 AppendCount;        // Pages appended
+    int                 RepackCount;        // Textures created by a grow/repack (uploaded again as a whole)
+};
+
+IMGUI_API bool              ImFontAtlasPagesCanAppend(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextureAppendPage(ImFontAtlas* atlas);
+#endif
+
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+// Atlas budget: evicts what was least recently used to keep the atlas texture around MaxBytes, instead of letting zooming or DPI changes
+// accumulate bakes until the texture reaches TexMaxWidth/TexMaxHeight.
+// - Checked by ImFontAtlasUpdateNewFrame(): once the packed rectangles use 3/4 of the budget, evict down to 1/2 of it. Bakes not used on
+//   the last frame go first (oldest first), then single glyphs of the remaining bakes (oldest ImFontGlyph::LastUsedFrame first).
+// - Glyph eviction runs at most once every IM_FONTATLASBUDGET_INTERVAL_FRAMES frames. With the glyph run cache it takes one more frame:
+//   the cache is cleared so that a frame of rendering updates the glyph timestamps.
+// - Evicted glyphs keep their advance (layout and the text size cache stay valid) and are rasterized again on their next use.
+// - Evicted space is reclaimed by a repack: by ImFontAtlasTextureMakeSpace() instead of growing the texture past the budget, and at the
+//   beginning of a frame to shrink a texture over the budget (also at most once every IM_FONTATLASBUDGET_INTERVAL_FRAMES frames).
+// - The budget is soft: when everything is in use the texture grows as usual. Fonts with ImFontFlags_LockBakedSizes are never evicted.
+#define IM_FONTATLASBUDGET_DEFAULT_BYTES        (4 * 1024 * 1024)
+#define IM_FONTATLASBUDGET_INTERVAL_FRAMES      30
+#define IM_FONTATLASBUDGET_MAX_EVICTED_KEYS     16384   // Evicted glyphs remembered to count re-rasterizations
+
+struct ImFontAtlasBudget
+{
+    int                 MaxBytes;           // 0: IM_FONTATLASBUDGET_DEFAULT_BYTES. Texture size (width * height * bytes per pixel)
+    bool                Disabled;           // Runtime switch, for A/B comparisons: only discard unused bakes when the texture is full again
+    bool                GlyphSweepPending;  // Glyph run cache cleared on GlyphSweepFrame, evict glyphs not rendered since then on the next frame
+    bool                GlyphCompactPending;// Evicted glyphs to remove from ImFontBaked::Glyphs[]
+    int                 GlyphSweepFrame;
+    int                 LastDefragFrame;
+    ImGuiStorage        Evicted;            // Hash of baked id and codepoint -> 1
+
+    // Stats
+    int                 EvictedBakes;
+    int                 EvictedGlyphs;
+    int                 Rerasterized;       // Evicted glyphs loaded again
+    int                 DefragCount;        // Repacks done to reclaim evicted space
+    int                 OverBudgetCount;    // Texture grown past the budget because nothing could be evicted
+};
+
+IMGUI_API int               ImFontAtlasBudgetGetMaxBytes(ImFontAtlas* atlas);
+IMGUI_API int               ImFontAtlasBudgetGetLiveBytes(ImFontAtlas* atlas);  // Packed and not discarded
+IMGUI_API void              ImFontAtlasBudgetNewFrame(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBudgetMakeSpace(ImFontAtlas* atlas);     // Return true when space was made without growing the texture
+#endif
+
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+// Glyph disk cache: bitmaps and metrics rasterized by the stb_truetype loader, kept in ImFontAtlas::GlyphCacheFilename across runs.
+// - Keyed by a hash of the font data, font number, glyph index, raster scale (size and rasterizer density), oversampling and scanline kernel.
+// - A hit copies the bitmap into the atlas instead of rasterizing it (also skipping the async glyph workers). Misses are added once rasterized.
+// - The file is read at once on the first lookup and written back as a whole when new glyphs were added. It uses native endianness, a bad
+//   magic/version ignores it and a truncated or corrupted file keeps its valid entries (it is rewritten on the next save).
+// - Nothing is added past IM_FONTGLYPHCACHE_MAX_BYTES.
+#define IM_FONTGLYPHCACHE_VERSION           2
+#define IM_FONTGLYPHCACHE_MAX_BYTES         (16 * 1024 * 1024)
+
+struct ImFontGlyphCacheEntry                // Followed by Width * Height alpha bytes
+{
+    ImU32               KeyLo, KeyHi;       // Two independent hashes of the key, KeyLo is used for lookups
+    ImS16               X0, Y0;             // Bitmap box (stbtt_GetGlyphBitmapBox)
+    ImU16               Width, Height;      // Packed size including oversampling, 0 for invisible glyphs
+    int                 AdvanceX;           // Unscaled (stbtt_GetGlyphHMetrics)
+};
+
+struct ImFontGlyphCache
+{
+    ImVector<char>      Data;               // Entries, as in the file after its header
+    ImGuiStorage        Map;                // KeyLo -> offset into Data[]
+    bool                Loaded;             // File read (or attempted)
+    bool                Dirty;              // Entries added since then
+    bool                Disabled;           // Runtime switch, for A/B comparisons: no lookups, nothing added
+
+    int                 EntryCount;         // In Data[]
+
+    // Stats
+    int                 LoadedCount;        // Entries read from the file
+    int                 Hits;
+    int                 Misses;
+    int                 SaveCount;
+};
+
+IMGUI_API const ImFontGlyphCacheEntry* ImFontAtlasGlyphCacheFind(ImFontAtlas* atlas, ImU32 key_lo, ImU32 key_hi);
+IMGUI_API void              ImFontAtlasGlyphCacheAdd(ImFontAtlas* atlas, const ImFontGlyphCacheEntry& entry, const unsigned char* pixels);
+IMGUI_API bool              ImFontAtlasGlyphCacheSave(ImFontAtlas* atlas);      // Write the file if entries were added, also done by ImFontAtlasBuildDestroy()
+#endif
+
+#ifdef IMGUI_ENABLE_SDF_FONTS
+// Distance field fonts: fonts with ImFontFlags_DistanceField get a single bake (IM_FONTSDF_BAKE_SIZE, RasterizerDensity 0.0f) holding
+// signed distance fields, which ImFont::GetFontBaked() returns for every size and density. Text is laid out by scaling that bake as with
+// ImFontFlags_LockBakedSizes, and the backend turns the distances into coverage (ImGuiBackendFlags_RendererHasDistanceFields).
+// - Zooming and DPI changes don't create bakes: no rasterization, no atlas growth and no texture uploads.
+// - Texels are 0.5 on the glyph edge and lose 0.5 every IM_FONTSDF_PADDING bake pixels (stbtt_GetGlyphSDF). The glyph boxes include
+//   that padding, and are placed from the bake ascent without rounding it. Glyph U coordinates are offset by IM_FONTSDF_UV_OFFSET, which is how the backend tells them from other vertices.
+// - Rendered by the stb_truetype loader, on the main thread (no async glyphs, no disk cache: one bake is rasterized per run).
+// - Sharp corners get rounded when magnified far above the bake size, and small sizes lose hinting: prefer it for scalable content.
+#define IM_FONTSDF_BAKE_SIZE                32.0f
+#define IM_FONTSDF_PADDING                  4
+#define IM_FONTSDF_UV_OFFSET                2.0f
+
+struct ImFontAtlasSdf
+{
+    bool                Enabled;            // Backend supports it and not Disabled, updated by ImFontAtlasUpdateNewFrame()
+    bool                Disabled;           // Runtime switch, for A/B comparisons: bake each size again
+
+    // Stats
+    int                 GlyphCount;         // Distance field glyphs rasterized
+    int                 GlyphSurface;       // Their packed pixels
+};
+
+inline bool                 ImFontBakedIsDistanceField(const ImFontBaked* baked) { return baked->RasterizerDensity == 0.0f; }
+#endif
+
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+// Shelf packer: replaces stb_rectpack in ImFontAtlasPackAddRect(), whose skyline search visits the whole skyline on every insert.
+// - Rectangles go into shelves spanning the texture width, whose height is a class: the rectangle height rounded up to a multiple of
+//   max(IM_FONTATLASSHELF_MIN_HEIGHT_STEP, UpperPowerOfTwo(h) / 8), so at most ~1/8 is wasted vertically.
+// - The free parts of a shelf are in a list sorted by X, a discarded rectangle finds its neighbors there. They are also in a list per class
+//   and power of two width bin: an insert takes the first span of the next non empty bin (all wide enough), else searches the bin of its
+//   width, in the same class then in the next one.
+// - Opening a shelf takes rows from free ranges binned by height the same way. Out of rows, any taller class is searched.
+// - A discarded rectangle gives its span back right away (merged with its free neighbors), and a shelf left empty gives its rows back
+//   to any class. Discarded space is reused without waiting for a repack, cleared when a new rectangle claims it.
+// - Shelves never cross pages (IMGUI_ENABLE_PAGED_ATLAS), every page keeps being filled.
+#define IM_FONTATLASSHELF_MIN_HEIGHT_STEP   2
+#define IM_FONTATLASSHELF_BIN_COUNT         16      // Widths and heights up to 65535
+
+struct ImFontAtlasShelf
+{
+    int                 Y;
+    int                 Height;             // Class height, 0: unused entry
+    int                 RectCount;          // Rectangles packed and not discarded
+    int                 FirstSpan;          // Free spans sorted by X, -1: none
+};
+
+struct ImFontAtlasShelfSpan                 // Free part of a shelf
+{
+    int                 ShelfIdx;           // -1: unused entry
+    int                 X, Width;
+    int                 ShelfPrev, ShelfNext;   // In the list of its shelf
+    int                 BinPrev, BinNext;       // In the list of its class and width bin
+};
+
+struct ImFontAtlasShelfClass                // Free spans of the shelves of one class height
+{
+    int                 Height;
+    ImU32               BinMask;            // Non empty Bins[]
+    int                 Bins[IM_FONTATLASSHELF_BIN_COUNT];  // First span with a width in [1 << n, 2 << n), -1: none
+};
+
+struct ImFontAtlasShelfRows                 // Rows not used by any shelf
+{
+    int                 Y0, Y1;             // Y0 == Y1: unused entry
+    int                 BinPrev, BinNext;   // In the list of its height bin
+};
+
+struct ImFontAtlasShelfPacker
+{
+    bool                Active;             // Packing instead of stb_rectpack, decided by ImFontAtlasPackInit()
+    bool                Disabled;           // Runtime switch, for A/B comparisons: use stb_rectpack from the next repack
+    int                 Width;
+    int                 PageHeight;         // Texture height without IMGUI_ENABLE_PAGED_ATLAS
+    ImVector<ImFontAtlasShelf> Shelves;
+    ImVector<int>       ShelvesFree;        // Unused Shelves[] entries
+    ImGuiStorage        ShelvesMap;         // Y -> index into Shelves[] + 1
+    ImVector<ImFontAtlasShelfSpan> Spans;
+    ImVector<int>       SpansFree;          // Unused Spans[] entries
+    ImVector<ImFontAtlasShelfClass> Classes;    // Sorted by Height, created on first use
+    ImVector<ImFontAtlasShelfRows> Rows;
+    ImVector<int>       RowsFree;           // Unused Rows[] entries
+    ImU32               RowsBinMask;        // Non empty RowsBins[]
+    int                 RowsBins[IM_FONTATLASSHELF_BIN_COUNT];  // First free rows with a height in [1 << n, 2 << n), -1: none
+    ImGuiStorage        RowsY0Map;          // Y0 -> index into Rows[] + 1, to merge adjacent free rows
+    ImGuiStorage        RowsY1Map;          // Y1 -> index into Rows[] + 1
+
+    // Stats
+    int                 InsertCount;
+    int                 ReleasedShelfCount; // Shelves emptied by discards, their rows reused
+    int                 MakeSpaceCount;     // Failed inserts making the texture grow/repack/append, counted with either packer
+};
+
+IMGUI_API void              ImFontAtlasShelfPackerInit(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasShelfPackerAddRows(ImFontAtlas* atlas, int y0, int y1);
+IMGUI_API bool              ImFontAtlasShelfPackerAddRect(ImFontAtlas* atlas, int w, int h, ImTextureRect* out_r);   // Size including padding. Returns the space claimed: its width, the shelf height
+IMGUI_API void              ImFontAtlasShelfPackerDiscardRect(ImFontAtlas* atlas, int x, int y, int w);
+#endif
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+// stb_truetype rasterizer: vectorized versions of its per-pixel passes, run for every glyph (oversampled glyphs have OversampleH x OversampleV times the pixels).
+// - Scanline: accumulation pass of stbtt__rasterize_sorted_edges(), writes min(|coverage[i] + fill[0] + .. + fill[i]| * 255 + 0.5, 255) to out[i].
+//   The SIMD kernel does 4 pixels per iteration (8 with AVX2), the running sum is a prefix sum in registers plus the carry of the previous block.
+//   Adding in a different order rounds differently: a pixel may be 1 away from the scalar kernel, never more.
+// - Prefilter: box filter of oversampled glyphs (stbtt__h_prefilter()/stbtt__v_prefilter()), in place: each pixel becomes the average of itself and
+//   the kernel_width - 1 previous ones along the row (or column), the same results as stb_truetype. 16 pixels per iteration, false without SSE2/NEON.
+// The scalar scanline kernel is available for benchmarking and testing, GImFontRasterizeScalar goes back to the stb_truetype code in the rasterizer.
+IMGUI_API void              ImFontRasterizeScanlineScalar(const float* coverage, const float* fill, int len, unsigned char* out);
+IMGUI_API void              ImFontRasterizeScanlineSIMD(const float* coverage, const float* fill, int len, unsigned char* out);
+IMGUI_API bool              ImFontRasterizePrefilterSIMD(unsigned char* pixels, int w, int h, int stride, int kernel_width, bool vertical);
+extern IMGUI_API bool       GImFontRasterizeScalar;     // Runtime switch, for A/B comparisons: rasterize with the stb_truetype code again. Main thread only, read when a glyph is requested.
+#endif
+
 // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasBuilder
 {
@@ -3857,6 +4285,31 @@ struct ImFontAtlasBuilder
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    ImFontGlyphRunCache         GlyphRuns;
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    ImFontTextSizeCache         TextSizes;
+#endif
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    ImFontAsyncGlyphs           AsyncGlyphs;
+#endif
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    ImFontAtlasPages            Pages;
+#endif
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    ImFontAtlasBudget           Budget;
+#endif
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    ImFontGlyphCache            GlyphCache;
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    ImFontAtlasSdf              Sdf;
+#endif
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    ImFontAtlasShelfPacker      ShelfPacker;
+#endif
+
     ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
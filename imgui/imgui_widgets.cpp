@@ -8403,6 +8403,9 @@ void ImGuiSelectionBasicStorage::Clear()
     Size = 0;
     _SelectionOrder = 1; // Always >0
     _Storage.Data.resize(0);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    _Storage.BuildIndex();
+#endif
 }
 
 void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
@@ -8410,6 +8413,9 @@ void ImGuiSelectionBasicStorage::Swap(ImGuiSelectionBasicStorage& r)
     ImSwap(Size, r.Size);
     ImSwap(_SelectionOrder, r._SelectionOrder);
     _Storage.Data.swap(r._Storage.Data);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    _Storage.Index.swap(r._Storage.Index);
+#endif
 }
 
 bool ImGuiSelectionBasicStorage::Contains(ImGuiID id) const
@@ -8431,7 +8437,24 @@ bool ImGuiSelectionBasicStorage::GetNextSelectedItem(void** opaque_it, ImGuiID*
     ImGuiStoragePair* it = (ImGuiStoragePair*)*opaque_it;
     ImGuiStoragePair* it_end = _Storage.Data.Data + _Storage.Data.Size;
     if (PreserveOrder && it == NULL && it_end != NULL)
+    {
         ImQsort(_Storage.Data.Data, (size_t)_Storage.Data.Size, sizeof(ImGuiStoragePair), PairComparerByValueInt); // ~ImGuiStorage::BuildSortByValueInt()
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+        _Storage.BuildIndex();
+#endif
+    }
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // Data is in insertion order (SetItemSelected() appends, Remove() moves the last pair): sort it before iterating so items still come out sorted by id.
+    else if (!PreserveOrder && it == NULL)
+    {
+        for (ImGuiStoragePair* p = _Storage.Data.Data; p + 1 < it_end; p++)
+            if (p[0].key > p[1].key)
+            {
+                _Storage.BuildSortByKey();
+                break;
+            }
+    }
+#endif
     if (it == NULL)
         it = _Storage.Data.Data;
     IM_ASSERT(it >= _Storage.Data.Data && it <= it_end);
@@ -8457,6 +8480,14 @@ void ImGuiSelectionBasicStorage::SetItemSelected(ImGuiID id, bool selected)
 static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicStorage* selection, ImGuiID id, bool selected, int size_before_amends, int selection_order)
 {
     ImGuiStorage* storage = &selection->_Storage;
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // Data is not sorted: look pairs up through the index, new pairs are appended and indexed right away.
+    IM_UNUSED(size_before_amends);
+    if (selected == (storage->GetInt(id, 0) != 0))
+        return;
+    *storage->GetIntRef(id, 0) = selected ? selection_order : 0;
+    selection->Size += selected ? +1 : -1;
+#else
     ImGuiStoragePair* it = ImLowerBound(storage->Data.Data, storage->Data.Data + size_before_amends, id);
     const bool is_contained = (it != storage->Data.Data + size_before_amends) && (it->key == id);
     if (selected == (is_contained && it->val_i != 0))
@@ -8466,6 +8497,7 @@ static void ImGuiSelectionBasicStorage_BatchSetItemSelected(ImGuiSelectionBasicS
     else if (is_contained)
         it->val_i = selected ? selection_order : 0; // Modify in-place.
     selection->Size += selected ? +1 : -1;
+#endif
 }
 
 static void ImGuiSelectionBasicStorage_BatchFinish(ImGuiSelectionBasicStorage* selection, bool selected, int size_before_amends)
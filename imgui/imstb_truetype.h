@@ -3368,6 +3368,10 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
       if (active)
          stbtt__fill_active_edges_new(scanline, scanline2+1, result->w, active, scan_y_top);
 
+#ifdef STBTT_accumulate_scanline // [DEAR IMGUI] Allow replacing the accumulation pass (e.g. with a vectorized one)
+      STBTT_accumulate_scanline(scanline, scanline2, result->w, result->pixels + j*result->stride);
+      STBTT__NOTUSED(i);
+#else
       {
          float sum = 0;
          for (i=0; i < result->w; ++i) {
@@ -3381,6 +3385,7 @@ static void stbtt__rasterize_sorted_edges(stbtt__bitmap *result, stbtt__edge *e,
             result->pixels[j*result->stride + i] = (unsigned char) m;
          }
       }
+#endif
       // advance all the edges
       step = &active;
       while (*step) {
@@ -4022,6 +4027,10 @@ static void stbtt__h_prefilter(unsigned char *pixels, int w, int h, int stride_i
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_w = w - kernel_width;
    int j;
+#ifdef STBTT_prefilter // [DEAR IMGUI] Allow replacing the box filter (e.g. with a vectorized one), false to run this one
+   if (STBTT_prefilter(pixels, w, h, stride_in_bytes, (int) kernel_width, 0))
+      return;
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < h; ++j) {
       int i;
@@ -4084,6 +4093,10 @@ static void stbtt__v_prefilter(unsigned char *pixels, int w, int h, int stride_i
    unsigned char buffer[STBTT_MAX_OVERSAMPLE];
    int safe_h = h - kernel_width;
    int j;
+#ifdef STBTT_prefilter // [DEAR IMGUI] Allow replacing the box filter (e.g. with a vectorized one), false to run this one
+   if (STBTT_prefilter(pixels, w, h, stride_in_bytes, (int) kernel_width, 1))
+      return;
+#endif
    STBTT_memset(buffer, 0, STBTT_MAX_OVERSAMPLE); // suppress bogus warning from VS2013 -analyze
    for (j=0; j < w; ++j) {
       int i;
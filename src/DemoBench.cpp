@@ -0,0 +1,2148 @@
+#include "demo.h"
+#include "trace.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "backends/imgui_impl_wgpu.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Micro-benchmarks and consistency checks for the imgui internals we replaced or extended.
+// Everything runs on the main thread when its button is pressed, so expect a short hitch.
+struct DemoBench : public Demo {
+    void imgui(WGPU*) override;
+
+    void hashBench();
+    void hashCollisions();
+    void hashImgui();
+    void storageBench();
+    void storageImgui();
+    void utf8Bench();
+    void utf8Fuzz();
+    void utf8Imgui();
+    void textSizeBench();
+    void textSizeImgui();
+    void glyphRunBench();
+    void glyphRunImgui();
+    void polylineBench();
+    void polylineImgui();
+    void polygonFillBench();
+    void polygonFillImgui();
+    void fontZoomImgui();
+    void evictionBench();
+    void evictionImgui();
+    void glyphLoadBench();
+    void glyphLoadImgui();
+    void packerBench();
+    void packerImgui();
+    void pagesBench();
+    void pagesImgui();
+    void rasterBench();
+    void rasterImgui();
+    void sdfBench();
+    void sdfImgui();
+    void buildBench();
+    void buildImgui();
+    void uploadBench();
+    void uploadImgui();
+
+    struct HashKernel {
+        const char *name;
+        ImGuiID (*func)(const void*, size_t, ImGuiID);
+        bool crc32;     // produces the same values as the table
+    };
+    struct HashResult {
+        const char *kernel;
+        float nsPerHash[3] = {};    // labels, ints, pointers
+        uint32_t collisions = 0;
+        bool crc32 = true;
+        bool matchesTable = true;
+    };
+    std::vector<HashResult> hashResults;
+    uint32_t collisionKeys = 0;
+    double expectedCollisions = 0.0;
+
+    // [0] the sorted vector baseline, [1] ImGuiStorage
+    struct StorageResult {
+        uint32_t keys = 0;
+        float buildNs[2] = {};      // per key, the baseline appends and sorts once
+        float hitNs[2] = {};
+        float missNs[2] = {};
+        float insertNs[2] = {};     // insert + remove of a new key in the full storage
+        size_t bytes[2] = {};
+        bool matches = true;
+    };
+    std::vector<StorageResult> storageResults;
+    bool storageChurnMatches = true;
+
+    // [0] the one code point at a time loops, [1] ImTextCountCharsFromUtf8/ImTextStrFromUtf8
+    struct Utf8Result {
+        const char *text;
+        float countMBs[2] = {};
+        float decodeMBs[2] = {};
+    };
+    std::vector<Utf8Result> utf8Results;
+    uint32_t utf8FuzzCases = 0;
+    uint32_t utf8FuzzMismatches = 0;
+    std::string utf8FuzzFirstMismatch;
+
+    // [0] cache disabled, [1] enabled (ImFontTextSizeCache)
+    uint32_t textSizeLabels = 0;
+    float textSizeNs[2] = {};
+    uint32_t textSizeMismatches = 0;
+
+    // [0] cache disabled, [1] replayed (ImFontGlyphRunCache)
+    uint32_t glyphRunLabels = 0;
+    float glyphRunNs[2] = {};
+    uint32_t glyphRunReplayed = 0;      // labels that were replayed from the cache
+    uint32_t glyphRunMismatches = 0;    // labels whose vertices or indices differ from the uncached ones
+
+    // [0] scalar kernels, [1] SIMD kernels (ImPolylineNormals*/ImPolylineEdges*)
+    struct PolylineResult {
+        uint32_t points = 0;
+        float thickness = 0.0f;
+        const char *path = "";
+        float addPolylineNs = 0.0f;     // per point, whole ImDrawList::AddPolyline()
+        float kernelNs[2] = {};         // per point, normals + edges
+        float maxError = 0.0f;          // largest difference between the kernels
+        uint32_t differences = 0;       // coordinates that are not bit-identical
+    };
+    std::vector<PolylineResult> polylineResults;
+
+    struct PolygonFillResult {
+        const char *shape;
+        uint32_t points = 0;
+        float convexNs = 0.0f;          // per point, ImDrawList::AddConvexPolyFilled(), anti-aliased (circles only)
+        float concaveNs[2] = {};        // per point, ImDrawList::AddConcavePolyFilled(), [0] anti-aliased, [1] not
+        float areaError = 0.0f;         // relative difference between the triangles and the polygon area
+    };
+    std::vector<PolygonFillResult> polygonFillResults;
+
+    // ImFontAtlasBudget in a scratch atlas: single glyphs evicted, then the whole bake, loaded again each time
+    struct EvictionResult {
+        float size = 0.0f;
+        int glyphs = 0;                 // compared after each eviction
+        int evictedGlyphs = 0;
+        int evictedBakes = 0;
+        int rerasterized = 0;
+        uint32_t mismatches = 0;        // glyphs not loaded again with the same metrics and bitmap
+    };
+    std::vector<EvictionResult> evictionResults;
+
+    // glyphs loaded in a scratch atlas by the async glyph workers and from the glyph disk cache, against the loader rasterizing them
+    struct GlyphLoadResult {
+        float size = 0.0f;
+        int glyphs = 0;
+        int asyncRequested = 0;         // ImFontAsyncGlyphs::PendingCount after the requests
+        int asyncFrames = 0;            // until everything was applied
+        uint32_t asyncMismatches = 0;
+        int cacheHits = 0;              // in a new atlas reading the file written by the loader
+        uint32_t cacheMismatches = 0;
+    };
+    std::vector<GlyphLoadResult> glyphLoadResults;
+
+    // [0] stb_rectpack, [1] shelf packer (ImFontAtlasShelfPacker)
+    struct PackerResult {
+        uint32_t inserts = 0;
+        float insertNs = 0.0f;          // per ImFontAtlasPackAddRect(), including the grows/repacks it triggers
+        int makeSpace = 0;              // inserts that had to grow/repack the texture
+        float churnNs = 0.0f;           // same, replacing bakes once the sweep is over
+        int churnMakeSpace = 0;
+        int texWidth = 0, texHeight = 0;
+        float efficiency = 0.0f;        // live rectangles surface / texture surface, at the end of the sweep
+        uint32_t overlaps = 0;
+        uint32_t outside = 0;           // rectangles past the texture size
+    };
+    PackerResult packerResults[2];
+
+    // ImFontAtlasPages in a scratch atlas with small pages, over a zoom sweep: appending a page must not move the glyphs already packed
+    struct PagesResult {
+        int pageSize = 0;
+        int pages = 0;                  // at the end of the sweep
+        int appended = 0;
+        int repacks = 0;
+        int glyphs = 0;
+        uint32_t moved = 0;             // glyphs with another rectangle or other pixels, without a repack in between
+        uint32_t crossing = 0;          // rectangles across a page
+    };
+    std::vector<PagesResult> pagesResults;
+
+    // [0] stb_truetype code, [1] SIMD accumulation and prefilter passes (ImFontRasterizeScanlineSIMD/ImFontRasterizePrefilterSIMD)
+    struct RasterResult {
+        const char *font = nullptr;
+        int oversample = 1;
+        int glyphs = 0;
+        float glyphUs[2] = {};          // per glyph bake, including its packing and copy into the atlas
+        int maxDiff = 0;                // largest difference of a glyph pixel between the two
+        uint32_t diffPixels = 0;
+        uint32_t pixels = 0;
+    };
+    std::vector<RasterResult> rasterResults;
+    std::vector<const char*> rasterMissing;     // fonts not found on this system
+
+    // the distance field bake of a vector font scaled to several sizes, against the regular bake of each size. Coverage is computed
+    // like the backend shaders do (bilinear samples at the pixel centers, sdf_coverage() for the distances)
+    struct SdfResult {
+        float size = 0.0f;
+        int glyphs = 0;
+        bool distanceField = false;     // the font returned its distance field bake for this size
+        float baseline = 0.0f;          // regular minus scaled baseline: the regular bake rounds its ascent at each size
+        float meanError = 0.0f;         // coverage difference on the same baseline, over the pixels covered by either
+        float maxError = 0.0f;
+        uint32_t advanceMismatches = 0; // more than 0.01 px
+    };
+    std::vector<SdfResult> sdfResults;
+    bool sdfMissing = false;
+
+    // ImFontAtlas::Build() of whole glyph ranges, serial preload then ImFontAsyncGlyphs parallel builds
+    struct BuildResult {
+        const char *font = nullptr;
+        int workers = 0;                // IM_FONTASYNCGLYPHS: WorkerCount, -1: calling thread only. 0: serial preload
+        int threads = 1;
+        int glyphs = 0;
+        float buildMs = 0.0f;           // whole Build(), best run
+        float waitMs = 0.0f;            // after packing: rasterizing what was left + blits
+        bool matches = true;            // same texture and glyphs as the serial preload
+    };
+    std::vector<BuildResult> buildResults;
+    std::vector<const char*> buildMissing;
+
+    // ImGui_ImplWGPU_GetTextureUploadRegions() on the atlas updates of a zoom sweep, [0] bounding box, [1] coalesced
+    struct UploadResult {
+        int pageHeight = 0;             // 0: not paged
+        uint32_t updates = 0;           // textures in ImTextureStatus_WantUpdates
+        uint32_t rects = 0;             // ImTextureData::Updates[] entries
+        uint64_t requestedBytes = 0;
+        uint32_t writes[2] = {};
+        uint64_t uploadBytes[2] = {};
+        float regionsUs[2] = {};        // per update
+        uint32_t uncovered[2] = {};     // dirty pixels in no region
+        uint32_t badRegions[2] = {};    // past the update bounding box, or across a page
+    };
+    std::vector<UploadResult> uploadResults;
+
+    // sweeps the font size every frame like a zoom gesture, each size is a new bake
+    bool fontZoom = false;
+    float fontZoomPhase = 0.0f;
+};
+
+std::unique_ptr<Demo> createDemoBench() {
+    return std::make_unique<DemoBench>();
+}
+
+namespace {
+    using Clock = std::chrono::high_resolution_clock;
+
+    const DemoBench::HashKernel hashKernels[] = {
+        {"crc32 table", ImHashDataCrc32Table, true},
+#ifdef IMGUI_ENABLE_SSE4_2_CRC
+        {"crc32 sse4.2", ImHashDataCrc32SSE42, true},
+#endif
+#ifdef IMGUI_ENABLE_ARM_CRC32
+        {"crc32 armv8", ImHashDataCrc32Arm, true},
+#endif
+        {"wyhash", ImHashDataWyhash, false},
+    };
+
+    const char *hashBackendName() {
+        switch (IMGUI_HASH_BACKEND) {
+            case IMGUI_HASH_BACKEND_CRC32_TABLE: return "crc32 table";
+            case IMGUI_HASH_BACKEND_CRC32_SSE4_2: return "crc32 sse4.2";
+            case IMGUI_HASH_BACKEND_CRC32_ARM: return "crc32 armv8";
+            case IMGUI_HASH_BACKEND_WYHASH: return "wyhash";
+            default: return "?";
+        }
+    }
+
+    // The kinds of labels a frame of widgets hashes: short buttons, hidden ids, ### ids, long tree node
+    // labels and formatted child window names.
+    int makeLabel(char *buffer, size_t size, uint32_t i) {
+        switch (i % 6) {
+            case 0: return snprintf(buffer, size, "Button %u", i);
+            case 1: return snprintf(buffer, size, "##slider%u", i);
+            case 2: return snprintf(buffer, size, "Item %u###item%u", i, i * 7);
+            case 3: return snprintf(buffer, size, "A longer label for a tree node, like in the demo window %u", i);
+            case 4: return snprintf(buffer, size, "Window/Child_%08X", i * 2654435761u);
+            default: return snprintf(buffer, size, "X%u", i);
+        }
+    }
+
+    // murmur3 finalizer, a bijection: distinct indices give distinct keys
+    ImGuiID storageKey(uint32_t i) {
+        i ^= i >> 16;
+        i *= 0x85EBCA6Bu;
+        i ^= i >> 13;
+        i *= 0xC2B2AE35u;
+        i ^= i >> 16;
+        return i;
+    }
+
+    // The sorted vector ImGuiStorage uses without IMGUI_STORAGE_OPEN_ADDRESSING, kept as the baseline
+    struct SortedStorage {
+        ImVector<ImGuiStoragePair> data;
+
+        ImGuiStoragePair *find(ImGuiID key) {
+            ImGuiStoragePair *it = ImLowerBound(data.begin(), data.end(), key);
+            return it != data.end() && it->key == key ? it : nullptr;
+        }
+        int getInt(ImGuiID key) {
+            const ImGuiStoragePair *it = find(key);
+            return it ? it->val_i : 0;
+        }
+        void setInt(ImGuiID key, int value) {
+            ImGuiStoragePair *it = ImLowerBound(data.begin(), data.end(), key);
+            if (it == data.end() || it->key != key) data.insert(it, ImGuiStoragePair(key, value));
+            else it->val_i = value;
+        }
+        void remove(ImGuiID key) {
+            if (ImGuiStoragePair *it = find(key)) data.erase(it);
+        }
+    };
+
+    const char *utf8KernelName() {
+#if defined(IMGUI_ENABLE_AVX2)
+        return "AVX2";
+#elif IMGUI_TEXT_UTF8_BLOCK && defined(IMGUI_ENABLE_SSE)
+        return "SSE2";
+#elif IMGUI_TEXT_UTF8_BLOCK && defined(IMGUI_ENABLE_NEON)
+        return "NEON";
+#else
+        return "scalar";
+#endif
+    }
+
+    // The loops ImTextCountCharsFromUtf8/ImTextStrFromUtf8 had before the block fast paths, the reference for the fuzz checks
+    int countCharsReference(const char *text, const char *textEnd) {
+        int count = 0;
+        while ((!textEnd || text < textEnd) && *text) {
+            unsigned int c;
+            text += ImTextCharFromUtf8(&c, text, textEnd);
+            count++;
+        }
+        return count;
+    }
+
+    int strFromUtf8Reference(ImWchar *buf, int bufSize, const char *text, const char *textEnd, const char **remaining) {
+        ImWchar *out = buf;
+        ImWchar *bufEnd = buf + bufSize;
+        while (out < bufEnd - 1 && (!textEnd || text < textEnd) && *text) {
+            unsigned int c;
+            text += ImTextCharFromUtf8(&c, text, textEnd);
+            *out++ = (ImWchar) c;
+        }
+        *out = 0;
+        if (remaining) *remaining = text;
+        return (int) (out - buf);
+    }
+
+    // Appends one random piece of UTF-8, `wellFormed` restricts it to ASCII and 2-byte sequences (the block fast path)
+    void appendUtf8Fragment(std::string &text, uint32_t random, bool wellFormed) {
+        auto randomIn = [&](uint32_t lo, uint32_t hi) {
+            random = storageKey(random);
+            return (char) (lo + random % (hi - lo + 1));
+        };
+        auto cont = [&] { return randomIn(0x80, 0xBF); };
+        switch (random % (wellFormed ? 4 : 10)) {
+            case 0: case 1: case 2: {   // ASCII run
+                const uint32_t length = 1 + (random >> 8) % 48;
+                for (uint32_t i = 0; i < length; ++i) text += randomIn(0x20, 0x7E);
+                break;
+            }
+            case 3: text += randomIn(0xC2, 0xDF); text += cont(); break;
+            case 4: text += randomIn(0xE0, 0xEF); text += cont(); text += cont(); break;    // includes surrogates and overlongs
+            case 5: text += randomIn(0xF0, 0xF4); text += cont(); text += cont(); text += cont(); break;
+            case 6: text += randomIn(0x80, 0xFF); break;                                   // stray byte
+            case 7: text += randomIn(0xC0, 0xF7); break;                                   // truncated sequence
+            case 8: text += "\xC0\x80"; break;                                            // overlong NUL
+            default: text += (random & 0x100) ? '\0' : randomIn(0x01, 0x1F); break;
+        }
+    }
+
+    // Runs `func` over `count` items until at least 20ms have passed, returns ns per item
+    template<class Func>
+    float timePerItem(uint32_t count, Func &&func) {
+        uint32_t rounds = 0;
+        const auto start = Clock::now();
+        std::chrono::duration<double, std::nano> elapsed = {};
+        do {
+            func();
+            rounds++;
+            elapsed = Clock::now() - start;
+        } while (elapsed < std::chrono::milliseconds(20));
+        return (float) (elapsed.count() / ((double) rounds * count));
+    }
+}
+
+void DemoBench::hashBench() {
+    TRACE_ZONE("DemoBench::hashBench");
+    constexpr uint32_t count = 4096;
+    std::vector<char> labelData;
+    std::vector<uint32_t> labelOffsets;
+    std::vector<int> ints(count);
+    std::vector<void*> pointers(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        char label[128];
+        const int length = makeLabel(label, sizeof(label), i);
+        labelOffsets.push_back((uint32_t) labelData.size());
+        labelData.insert(labelData.end(), label, label + length + 1);
+        ints[i] = (int) i;
+        pointers[i] = &pointers[i];
+    }
+
+    hashResults.clear();
+    volatile ImGuiID sink = 0;
+    // hash == nullptr measures ImHashStr/ImHashData, labels then also go through the ### scan
+    auto measure = [&](HashResult &result, ImGuiID (*hash)(const void*, size_t, ImGuiID)) {
+        const ImGuiID seed = ImHashStr("Window");
+        result.nsPerHash[0] = timePerItem(count, [&] {
+            for (uint32_t offset : labelOffsets) {
+                const char *label = &labelData[offset];
+                sink = hash ? hash(label, strlen(label), seed) : ImHashStr(label, 0, seed);
+            }
+        });
+        result.nsPerHash[1] = timePerItem(count, [&] {
+            for (const int &value : ints) sink = hash ? hash(&value, sizeof(int), seed) : ImHashData(&value, sizeof(int), seed);
+        });
+        result.nsPerHash[2] = timePerItem(count, [&] {
+            for (void *const &ptr : pointers) sink = hash ? hash(&ptr, sizeof(void*), seed) : ImHashData(&ptr, sizeof(void*), seed);
+        });
+    };
+
+    for (const HashKernel &kernel : hashKernels) {
+        HashResult &result = hashResults.emplace_back(HashResult{.kernel = kernel.name, .crc32 = kernel.crc32});
+        measure(result, kernel.func);
+        for (uint32_t i = 0; i < count && kernel.crc32; ++i) {
+            const char *label = &labelData[labelOffsets[i]];
+            if (kernel.func(label, strlen(label), i) != ImHashDataCrc32Table(label, strlen(label), i)) {
+                result.matchesTable = false;
+            }
+        }
+    }
+    HashResult &builtin = hashResults.emplace_back(HashResult{.kernel = "ImHashStr/ImHashData"});
+    builtin.crc32 = IMGUI_HASH_BACKEND != IMGUI_HASH_BACKEND_WYHASH;
+    measure(builtin, nullptr);
+    for (uint32_t i = 0; i < count && builtin.crc32; ++i) {
+        if (ImHashData(&ints[i], sizeof(int), i) != ImHashDataCrc32Table(&ints[i], sizeof(int), i)) {
+            builtin.matchesTable = false;
+        }
+    }
+    (void) sink;
+}
+
+void DemoBench::hashCollisions() {
+    TRACE_ZONE("DemoBench::hashCollisions");
+    collisionKeys = 1 << 20;
+    // birthday bound for 32-bit hashes
+    expectedCollisions = (double) collisionKeys * (collisionKeys - 1) / 2.0 / 4294967296.0;
+    if (hashResults.empty()) hashBench();
+
+    std::vector<ImGuiID> ids(collisionKeys);
+    const ImGuiID seed = ImHashStr("Window");
+    for (HashResult &result : hashResults) {
+        const HashKernel *kernel = nullptr;
+        for (const HashKernel &k : hashKernels) {
+            if (strcmp(k.name, result.kernel) == 0) kernel = &k;
+        }
+        for (uint32_t i = 0; i < collisionKeys; ++i) {
+            char label[128];
+            const int length = makeLabel(label, sizeof(label), i);
+            ids[i] = kernel ? kernel->func(label, length, seed) : ImHashStr(label, length, seed);
+        }
+        std::sort(ids.begin(), ids.end());
+        result.collisions = 0;
+        for (uint32_t i = 1; i < collisionKeys; ++i) {
+            result.collisions += ids[i] == ids[i - 1];
+        }
+    }
+}
+
+void DemoBench::hashImgui() {
+    ImGui::Text("ID hash backend: %s (IMGUI_HASH_BACKEND)", hashBackendName());
+    if (ImGui::Button("benchmark##hash")) hashBench();
+    ImGui::SameLine();
+    if (ImGui::Button("collisions##hash")) hashCollisions();
+    if (hashResults.empty()) return;
+
+    if (ImGui::BeginTable("hash", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("kernel");
+        ImGui::TableSetupColumn("labels ns");
+        ImGui::TableSetupColumn("int ns");
+        ImGui::TableSetupColumn("ptr ns");
+        ImGui::TableSetupColumn("collisions");
+        ImGui::TableSetupColumn("== table");
+        ImGui::TableHeadersRow();
+        for (const HashResult &result : hashResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.kernel);
+            for (float ns : result.nsPerHash) {
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", ns);
+            }
+            ImGui::TableNextColumn();
+            if (collisionKeys) ImGui::Text("%u", result.collisions);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(!result.crc32 ? "-" : result.matchesTable ? "yes" : "NO");
+        }
+        ImGui::EndTable();
+    }
+    if (collisionKeys) {
+        ImGui::Text("%u keys, %.1f collisions expected from a uniform 32-bit hash", collisionKeys, expectedCollisions);
+    }
+}
+
+void DemoBench::storageBench() {
+    TRACE_ZONE("DemoBench::storageBench");
+    constexpr uint32_t lookups = 1 << 16;
+    constexpr uint32_t inserts = 256;   // the baseline moves half the vector on each one
+    storageResults.clear();
+    volatile int sink = 0;
+
+    for (uint32_t keys : {1000u, 100000u, 1000000u}) {
+        StorageResult &result = storageResults.emplace_back(StorageResult{.keys = keys});
+        SortedStorage sorted;
+        ImGuiStorage storage;
+
+        result.buildNs[0] = timePerItem(keys, [&] {
+            sorted.data.clear();
+            for (uint32_t i = 0; i < keys; ++i) sorted.data.push_back(ImGuiStoragePair(storageKey(i), (int) i));
+            std::sort(sorted.data.begin(), sorted.data.end(), [](const ImGuiStoragePair &a, const ImGuiStoragePair &b) { return a.key < b.key; });
+        });
+        result.buildNs[1] = timePerItem(keys, [&] {
+            storage.Clear();
+            for (uint32_t i = 0; i < keys; ++i) storage.SetInt(storageKey(i), (int) i);
+        });
+
+        // random order, so the big storages don't fit in cache
+        std::vector<ImGuiID> hits(lookups);
+        std::vector<ImGuiID> misses(lookups);
+        for (uint32_t i = 0; i < lookups; ++i) {
+            hits[i] = storageKey(storageKey(i) % keys);
+            misses[i] = storageKey(keys + i);
+        }
+        result.hitNs[0] = timePerItem(lookups, [&] { for (ImGuiID key : hits) sink = sorted.getInt(key); });
+        result.hitNs[1] = timePerItem(lookups, [&] { for (ImGuiID key : hits) sink = storage.GetInt(key); });
+        result.missNs[0] = timePerItem(lookups, [&] { for (ImGuiID key : misses) sink = sorted.getInt(key); });
+        result.missNs[1] = timePerItem(lookups, [&] { for (ImGuiID key : misses) sink = storage.GetInt(key); });
+        result.insertNs[0] = timePerItem(inserts, [&] {
+            for (uint32_t i = 0; i < inserts; ++i) sorted.setInt(misses[i], 1);
+            for (uint32_t i = 0; i < inserts; ++i) sorted.remove(misses[i]);
+        });
+        result.insertNs[1] = timePerItem(inserts, [&] {
+            for (uint32_t i = 0; i < inserts; ++i) storage.SetInt(misses[i], 1);
+            for (uint32_t i = 0; i < inserts; ++i) storage.Remove(misses[i]);
+        });
+
+        result.bytes[0] = (size_t) sorted.data.capacity() * sizeof(ImGuiStoragePair);
+        result.bytes[1] = (size_t) storage.Data.capacity() * sizeof(ImGuiStoragePair);
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+        result.bytes[1] += (size_t) storage.Index.capacity() * sizeof(int);
+#endif
+        result.matches = storage.Data.Size == sorted.data.Size;
+        for (const ImGuiStoragePair &pair : sorted.data) {
+            if (storage.GetInt(pair.key, -1) != pair.val_i) result.matches = false;
+        }
+    }
+
+    // Random sets and removes over a small key range, so probe sequences overlap and removals shift them back
+    SortedStorage sorted;
+    ImGuiStorage storage;
+    storageChurnMatches = true;
+    for (uint32_t i = 0; i < 200000 && storageChurnMatches; ++i) {
+        const uint32_t random = storageKey(i);
+        const ImGuiID key = storageKey(random % 3000);
+        if (random & 0x80000000u) {
+            sorted.setInt(key, (int) i);
+            storage.SetInt(key, (int) i);
+        } else {
+            sorted.remove(key);
+            storage.Remove(key);
+        }
+        const ImGuiStoragePair *expected = sorted.find(key);
+        storageChurnMatches = storage.GetInt(key, -1) == (expected ? expected->val_i : -1);
+    }
+    storageChurnMatches = storageChurnMatches && storage.Data.Size == sorted.data.Size;
+    for (const ImGuiStoragePair &pair : sorted.data) {
+        if (storage.GetInt(pair.key, -1) != pair.val_i) storageChurnMatches = false;
+    }
+    (void) sink;
+}
+
+void DemoBench::storageImgui() {
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    ImGui::TextUnformatted("ImGuiStorage backend: open addressing (IMGUI_STORAGE_OPEN_ADDRESSING)");
+#else
+    ImGui::TextUnformatted("ImGuiStorage backend: sorted vector");
+#endif
+    if (ImGui::Button("benchmark##storage")) storageBench();
+    if (storageResults.empty()) return;
+
+    ImGui::TextDisabled("ns per key, sorted vector / ImGuiStorage");
+    if (ImGui::BeginTable("storage", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("keys");
+        ImGui::TableSetupColumn("build");
+        ImGui::TableSetupColumn("lookup hit");
+        ImGui::TableSetupColumn("lookup miss");
+        ImGui::TableSetupColumn("insert + remove");
+        ImGui::TableSetupColumn("memory KB");
+        ImGui::TableSetupColumn("same pairs");
+        ImGui::TableHeadersRow();
+        for (const StorageResult &result : storageResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%u", result.keys);
+            for (const float *ns : {result.buildNs, result.hitNs, result.missNs, result.insertNs}) {
+                ImGui::TableNextColumn(); ImGui::Text("%.1f / %.1f", ns[0], ns[1]);
+            }
+            ImGui::TableNextColumn(); ImGui::Text("%.0f / %.0f", (double) result.bytes[0] / 1024.0, (double) result.bytes[1] / 1024.0);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.matches ? "yes" : "NO");
+        }
+        ImGui::EndTable();
+    }
+    ImGui::Text("random set/remove churn: %s", storageChurnMatches ? "same pairs" : "MISMATCH");
+}
+
+void DemoBench::utf8Bench() {
+    TRACE_ZONE("DemoBench::utf8Bench");
+    constexpr size_t textSize = 1 << 20;
+    // ~1MB each: log lines, Latin/Cyrillic (2-byte sequences between ASCII), CJK (3-byte) and random bytes
+    const char *logLine = "[12:34:56.789] INFO renderer: uploaded 64 glyphs to atlas page 0 (1024x1024)\n";
+    const char *cyrillic = "Съешь же ещё этих мягких французских булок, да выпей чаю. Déjà vu, naïve café. ";
+    const char *cjk = "日本語のテキストを表示するためのサンプル文字列です。中文字符也在这里。";
+    const char *names[] = {"ASCII log", "Latin/Cyrillic", "CJK", "random bytes"};
+    std::string texts[std::size(names)];
+    for (size_t i = 0; i < std::size(names); ++i) {
+        const char *source = i == 0 ? logLine : i == 1 ? cyrillic : cjk;
+        for (uint32_t n = 0; texts[i].size() < textSize; ++n) {
+            if (i == 3) texts[i] += (char) (1 + storageKey(n) % 255);
+            else texts[i] += source;
+        }
+    }
+
+    utf8Results.clear();
+    std::vector<ImWchar> buffer(textSize + 1);
+    volatile int sink = 0;
+    for (size_t i = 0; i < std::size(names); ++i) {
+        Utf8Result &result = utf8Results.emplace_back(Utf8Result{.text = names[i]});
+        const char *text = texts[i].c_str();
+        const char *textEnd = text + texts[i].size();
+        const uint32_t bytes = (uint32_t) texts[i].size();
+        auto toMBs = [](float nsPerByte) { return nsPerByte > 0.0f ? 1000.0f / nsPerByte : 0.0f; };
+        result.countMBs[0] = toMBs(timePerItem(bytes, [&] { sink = countCharsReference(text, textEnd); }));
+        result.countMBs[1] = toMBs(timePerItem(bytes, [&] { sink = ImTextCountCharsFromUtf8(text, textEnd); }));
+        result.decodeMBs[0] = toMBs(timePerItem(bytes, [&] { sink = strFromUtf8Reference(buffer.data(), (int) buffer.size(), text, textEnd, nullptr); }));
+        result.decodeMBs[1] = toMBs(timePerItem(bytes, [&] { sink = ImTextStrFromUtf8(buffer.data(), (int) buffer.size(), text, textEnd); }));
+    }
+    (void) sink;
+}
+
+void DemoBench::utf8Fuzz() {
+    TRACE_ZONE("DemoBench::utf8Fuzz");
+    constexpr uint32_t cases = 200000;
+    utf8FuzzCases = cases;
+    utf8FuzzMismatches = 0;
+    utf8FuzzFirstMismatch.clear();
+
+    std::string text;
+    ImWchar expected[512];
+    ImWchar decoded[512];
+    for (uint32_t i = 0; i < cases; ++i) {
+        uint32_t random = storageKey(i ^ 0x5EED0000u);
+        text.clear();
+        const uint32_t fragments = random % 24;
+        const bool wellFormed = (random >> 8) % 3 == 0;
+        for (uint32_t f = 0; f < fragments; ++f) appendUtf8Fragment(text, storageKey(random + f), wellFormed);
+        const size_t size = text.size();
+        // zeros past the terminator: with a NULL end the decoder may read a few bytes after a 0 in a truncated sequence
+        text.append(8, '\0');
+
+        random = storageKey(random);
+        const bool nullEnd = random & 1;
+        const char *textEnd = nullEnd ? nullptr : text.data() + (size ? (random >> 1) % (size + 1) : 0);
+        const int bufSize = 1 + (int) ((random >> 12) % 300);
+
+        const char *expectedRemaining = nullptr;
+        const char *decodedRemaining = nullptr;
+        const int expectedCount = countCharsReference(text.data(), textEnd);
+        const int count = ImTextCountCharsFromUtf8(text.data(), textEnd);
+        const int expectedLength = strFromUtf8Reference(expected, bufSize, text.data(), textEnd, &expectedRemaining);
+        const int length = ImTextStrFromUtf8(decoded, bufSize, text.data(), textEnd, &decodedRemaining);
+        const bool match = count == expectedCount && length == expectedLength && decodedRemaining == expectedRemaining &&
+                           memcmp(decoded, expected, (size_t) (length + 1) * sizeof(ImWchar)) == 0;
+        if (!match && utf8FuzzMismatches++ == 0) {
+            char description[128];
+            snprintf(description, sizeof(description), "case %u: %zu bytes, %s end, buffer %d: count %d/%d, length %d/%d",
+                     i, size, nullEnd ? "NULL" : "explicit", bufSize, count, expectedCount, length, expectedLength);
+            utf8FuzzFirstMismatch = description;
+        }
+    }
+}
+
+void DemoBench::utf8Imgui() {
+    ImGui::Text("UTF-8 kernel: %s, %d bytes per block (IMGUI_TEXT_UTF8_BLOCK)", utf8KernelName(), IMGUI_TEXT_UTF8_BLOCK);
+    if (ImGui::Button("benchmark##utf8")) utf8Bench();
+    ImGui::SameLine();
+    if (ImGui::Button("fuzz##utf8")) utf8Fuzz();
+
+    if (!utf8Results.empty()) {
+        ImGui::TextDisabled("MB/s, one code point at a time / ImText*");
+        if (ImGui::BeginTable("utf8", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("text");
+            ImGui::TableSetupColumn("ImTextCountCharsFromUtf8");
+            ImGui::TableSetupColumn("ImTextStrFromUtf8");
+            ImGui::TableHeadersRow();
+            for (const Utf8Result &result : utf8Results) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(result.text);
+                ImGui::TableNextColumn(); ImGui::Text("%.0f / %.0f", result.countMBs[0], result.countMBs[1]);
+                ImGui::TableNextColumn(); ImGui::Text("%.0f / %.0f", result.decodeMBs[0], result.decodeMBs[1]);
+            }
+            ImGui::EndTable();
+        }
+    }
+    if (utf8FuzzCases) {
+        ImGui::Text("fuzz: %u cases, %u mismatches", utf8FuzzCases, utf8FuzzMismatches);
+        if (utf8FuzzMismatches) ImGui::TextUnformatted(utf8FuzzFirstMismatch.c_str());
+    }
+}
+
+void DemoBench::textSizeBench() {
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    TRACE_ZONE("DemoBench::textSizeBench");
+    // about what a busy frame measures, well within the default budget
+    constexpr uint32_t count = 2000;
+    std::vector<std::string> labels(count);
+    char buffer[128];
+    for (uint32_t i = 0; i < count; ++i) {
+        makeLabel(buffer, sizeof(buffer), i);
+        labels[i] = buffer;
+    }
+
+    ImFontTextSizeCache &cache = ImGui::GetIO().Fonts->Builder->TextSizes;
+    const bool disabled = cache.Disabled;
+    std::vector<ImVec2> sizes(count);
+    volatile float sink = 0.0f;
+    for (int enabled = 0; enabled < 2; ++enabled) {
+        cache.Disabled = !enabled;
+        textSizeNs[enabled] = timePerItem(count, [&] {
+            for (const std::string &label : labels) sink = ImGui::CalcTextSize(label.c_str(), label.c_str() + label.size(), true).x;
+        });
+    }
+    textSizeLabels = count;
+    textSizeMismatches = 0;
+    for (int enabled = 0; enabled < 2; ++enabled) {
+        cache.Disabled = !enabled;
+        for (uint32_t i = 0; i < count; ++i) {
+            const ImVec2 size = ImGui::CalcTextSize(labels[i].c_str(), nullptr, true);
+            if (!enabled) sizes[i] = size;
+            else if (size.x != sizes[i].x || size.y != sizes[i].y) textSizeMismatches++;
+        }
+    }
+    cache.Disabled = disabled;
+    (void) sink;
+#endif
+}
+
+void DemoBench::textSizeImgui() {
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    if (ImGui::Button("benchmark##textSize")) textSizeBench();
+    if (textSizeLabels) {
+        ImGui::Text("ImGui::CalcTextSize, %u labels: %.1f ns uncached, %.1f ns cached, %u mismatches",
+                    textSizeLabels, textSizeNs[0], textSizeNs[1], textSizeMismatches);
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_TEXT_SIZE_CACHE");
+#endif
+}
+
+void DemoBench::glyphRunBench() {
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    TRACE_ZONE("DemoBench::glyphRunBench");
+    // well within the default budget, at different positions and colors than when captured
+    constexpr uint32_t count = 500;
+    std::vector<std::string> labels(count);
+    char buffer[128];
+    for (uint32_t i = 0; i < count; ++i) {
+        makeLabel(buffer, sizeof(buffer), i);
+        labels[i] = buffer;
+    }
+    ImFont *font = ImGui::GetFont();
+    const float size = ImGui::GetFontSize();
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    auto draw = [&](uint32_t i, uint32_t pass) {
+        const ImVec2 pos(10.5f + (float) ((i + pass * 3) % 13), 20.0f + (float) (i % 17) * size);
+        const ImU32 col = IM_COL32(255, (i * 37 + pass) & 255, 128, 255 - (i % 5) * 20);
+        const float wrapWidth = i % 6 == 3 ? 150.0f : 0.0f;
+        drawList.AddText(font, size, pos, col, labels[i].c_str(), labels[i].c_str() + labels[i].size(), wrapWidth);
+    };
+    auto reset = [&] {
+        drawList._ResetForNewFrame();
+        drawList.PushClipRectFullScreen();
+        drawList.PushTexture(ImGui::GetIO().Fonts->TexRef);
+    };
+
+    ImFontGlyphRunCache &cache = ImGui::GetIO().Fonts->Builder->GlyphRuns;
+    const bool disabled = cache.Disabled;
+    for (int enabled = 0; enabled < 2; ++enabled) {
+        cache.Disabled = !enabled;
+        uint32_t pass = 0;
+        glyphRunNs[enabled] = timePerItem(count, [&] {
+            reset();
+            for (uint32_t i = 0; i < count; ++i) draw(i, pass);
+            pass++;
+        });
+    }
+
+    // the output of the third draw (seen, captured, replayed) against the uncached one
+    glyphRunLabels = count;
+    glyphRunReplayed = 0;
+    glyphRunMismatches = 0;
+    std::vector<ImDrawVert> vertices;
+    std::vector<ImDrawIdx> indices;
+    ImFontAtlasGlyphRunsClear(ImGui::GetIO().Fonts);
+    for (uint32_t i = 0; i < count; ++i) {
+        cache.Disabled = true;
+        reset();
+        draw(i, 2);
+        vertices.assign(drawList.VtxBuffer.begin(), drawList.VtxBuffer.end());
+        indices.assign(drawList.IdxBuffer.begin(), drawList.IdxBuffer.end());
+        cache.Disabled = false;
+        for (uint32_t pass = 0; pass < 3; ++pass) {
+            reset();
+            const int hits = cache.FrameHits;
+            draw(i, pass);
+            glyphRunReplayed += pass == 2 && cache.FrameHits > hits;
+        }
+        const bool same = vertices.size() == (size_t) drawList.VtxBuffer.Size && indices.size() == (size_t) drawList.IdxBuffer.Size &&
+                          memcmp(vertices.data(), drawList.VtxBuffer.Data, drawList.VtxBuffer.size_in_bytes()) == 0 &&
+                          memcmp(indices.data(), drawList.IdxBuffer.Data, drawList.IdxBuffer.size_in_bytes()) == 0;
+        glyphRunMismatches += !same;
+    }
+    cache.Disabled = disabled;
+    drawList._ClearFreeMemory();
+#endif
+}
+
+void DemoBench::glyphRunImgui() {
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    if (ImGui::Button("benchmark##glyphRuns")) glyphRunBench();
+    if (glyphRunLabels) {
+        ImGui::Text("ImDrawList::AddText, %u labels: %.1f ns uncached, %.1f ns cached", glyphRunLabels, glyphRunNs[0], glyphRunNs[1]);
+        if (glyphRunMismatches) ImGui::Text("%u replayed, %u MISMATCH", glyphRunReplayed, glyphRunMismatches);
+        else ImGui::Text("%u replayed, identical to the uncached vertices", glyphRunReplayed);
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_GLYPH_RUN_CACHE");
+#endif
+}
+
+void DemoBench::polylineBench() {
+    TRACE_ZONE("DemoBench::polylineBench");
+    polylineResults.clear();
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    const ImDrawListFlags flags = ImGui::GetWindowDrawList()->Flags; // same AA settings as the windows
+    const float fringeScale = ImGui::GetDrawListSharedData()->InitialFringeScale;
+    for (uint32_t points : {100u, 1000u, 10000u}) {
+        // a noisy chart like PlotLines() draws, 16-bit indices fit 4 vertices per point up to 16k points
+        std::vector<ImVec2> line(points);
+        for (uint32_t i = 0; i < points; ++i) {
+            const float noise = (float) (storageKey(i) & 0xFFFF) / 65536.0f;
+            line[i] = ImVec2(10.0f + 1200.0f * (float) i / (float) points, 300.0f + 200.0f * sinf((float) i * 0.05f) + 20.0f * noise);
+        }
+        std::vector<ImVec2> normals[2], edges[2];
+        for (float thickness : {1.0f, 1.5f, 3.0f, 8.0f}) {
+            PolylineResult &result = polylineResults.emplace_back(PolylineResult{.points = points, .thickness = thickness});
+            const bool useTexture = (flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (int) thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX && thickness == (float) (int) thickness && fringeScale == 1.0f;
+            const bool thick = !useTexture && thickness > fringeScale;
+            result.path = useTexture ? "texture" : thick ? "thick" : "thin";
+
+            result.addPolylineNs = timePerItem(points, [&] {
+                drawList._ResetForNewFrame();
+                drawList.Flags = flags;
+                drawList.PushClipRectFullScreen();
+                drawList.PushTexture(ImGui::GetIO().Fonts->TexRef);
+                drawList.AddPolyline(line.data(), (int) points, IM_COL32_WHITE, ImDrawFlags_None, thickness);
+            });
+
+            // offsets as AddPolyline() computes them, for the kernels alone
+            float offsets[4] = {};
+            const int offsetsCount = thick ? 4 : 2;
+            if (thick) {
+                const float halfInner = (thickness - fringeScale) * 0.5f;
+                offsets[0] = halfInner + fringeScale; offsets[1] = halfInner; offsets[2] = -halfInner; offsets[3] = -(halfInner + fringeScale);
+            } else {
+                offsets[0] = useTexture ? thickness * 0.5f + 1.0f : fringeScale;
+                offsets[1] = -offsets[0];
+            }
+            using NormalsKernel = void (*)(const ImVec2*, int, bool, ImVec2*);
+            using EdgesKernel = void (*)(const ImVec2*, const ImVec2*, int, bool, const float*, int, ImVec2*);
+#ifdef IMGUI_ENABLE_POLYLINE_SIMD
+            const NormalsKernel normalsKernels[2] = {ImPolylineNormalsScalar, ImPolylineNormalsSIMD};
+            const EdgesKernel edgesKernels[2] = {ImPolylineEdgesScalar, ImPolylineEdgesSIMD};
+#else
+            const NormalsKernel normalsKernels[2] = {ImPolylineNormalsScalar, ImPolylineNormalsScalar};
+            const EdgesKernel edgesKernels[2] = {ImPolylineEdgesScalar, ImPolylineEdgesScalar};
+#endif
+            for (int k = 0; k < 2; ++k) {
+                normals[k].resize(points);
+                edges[k].resize(points * offsetsCount);
+                result.kernelNs[k] = timePerItem(points, [&] {
+                    normalsKernels[k](line.data(), (int) points, false, normals[k].data());
+                    edgesKernels[k](line.data(), normals[k].data(), (int) points, false, offsets, offsetsCount, edges[k].data());
+                });
+            }
+            const float *a = &edges[0][0].x;
+            const float *b = &edges[1][0].x;
+            for (size_t i = 0; i < edges[0].size() * 2; ++i) {
+                if (a[i] != b[i]) result.differences++;
+                result.maxError = std::max(result.maxError, fabsf(a[i] - b[i]));
+            }
+        }
+    }
+    drawList._ClearFreeMemory();
+}
+
+void DemoBench::polylineImgui() {
+#ifdef IMGUI_ENABLE_POLYLINE_SIMD
+    ImGui::TextUnformatted("polyline kernels: SIMD, 4 points per iteration");
+#else
+    ImGui::TextUnformatted("polyline kernels: scalar only");
+#endif
+    if (ImGui::Button("benchmark##polyline")) polylineBench();
+    if (polylineResults.empty()) return;
+    ImGui::TextDisabled("ns per point, anti-aliased open polyline");
+    if (ImGui::BeginTable("polyline", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("points");
+        ImGui::TableSetupColumn("thickness");
+        ImGui::TableSetupColumn("path");
+        ImGui::TableSetupColumn("AddPolyline");
+        ImGui::TableSetupColumn("kernels scalar / SIMD");
+        ImGui::TableSetupColumn("differences");
+        ImGui::TableHeadersRow();
+        for (const PolylineResult &result : polylineResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%u", result.points);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", result.thickness);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.path);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", result.addPolylineNs);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f / %.2f", result.kernelNs[0], result.kernelNs[1]);
+            ImGui::TableNextColumn(); ImGui::Text("%u (max %g)", result.differences, result.maxError);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void DemoBench::polygonFillBench() {
+    TRACE_ZONE("DemoBench::polygonFillBench");
+    polygonFillResults.clear();
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    const ImDrawListFlags flags = ImGui::GetWindowDrawList()->Flags;
+    const char *shapes[] = {"circle", "star", "noisy"};
+    for (int shape = 0; shape < 3; ++shape) {
+        for (uint32_t points : {100u, 1000u, 4000u, 16000u}) {
+            // 16-bit indices fit 2 vertices per point up to 32k points
+            std::vector<ImVec2> polygon(points);
+            for (uint32_t i = 0; i < points; ++i) {
+                const float a = IM_PI * 2.0f * (float) i / (float) points;
+                const float noise = (float) (storageKey(i) & 0xFFFF) / 65536.0f;
+                const float radius = shape == 0 ? 200.0f : shape == 1 ? ((i & 1) ? 100.0f : 200.0f) : 150.0f + 50.0f * noise;
+                polygon[i] = ImVec2(600.0f + radius * cosf(a), 400.0f + radius * sinf(a));
+            }
+            PolygonFillResult &result = polygonFillResults.emplace_back(PolygonFillResult{.shape = shapes[shape], .points = points});
+            auto time = [&](ImDrawListFlags fillFlags, bool concave) {
+                return timePerItem(points, [&] {
+                    drawList._ResetForNewFrame();
+                    drawList.Flags = (flags & ~ImDrawListFlags_AntiAliasedFill) | fillFlags;
+                    drawList.PushClipRectFullScreen();
+                    drawList.PushTexture(ImGui::GetIO().Fonts->TexRef);
+                    if (concave) drawList.AddConcavePolyFilled(polygon.data(), (int) points, IM_COL32_WHITE);
+                    else drawList.AddConvexPolyFilled(polygon.data(), (int) points, IM_COL32_WHITE);
+                });
+            };
+            if (shape == 0) result.convexNs = time(ImDrawListFlags_AntiAliasedFill, false);
+            result.concaveNs[0] = time(ImDrawListFlags_AntiAliasedFill, true);
+            result.concaveNs[1] = time(ImDrawListFlags_None, true);
+
+            // without anti-aliasing the vertices are the points, the triangles must cover the polygon exactly once
+            double polygonArea = 0.0, trianglesArea = 0.0;
+            for (uint32_t i = 0, j = points - 1; i < points; j = i++) {
+                polygonArea += (double) polygon[j].x * polygon[i].y - (double) polygon[i].x * polygon[j].y;
+            }
+            const ImDrawVert *vtx = drawList.VtxBuffer.Data;
+            const ImDrawIdx *idx = drawList.IdxBuffer.Data;
+            for (int i = 0; i + 2 < drawList.IdxBuffer.Size; i += 3) {
+                const ImVec2 a = vtx[idx[i]].pos, b = vtx[idx[i + 1]].pos, c = vtx[idx[i + 2]].pos;
+                trianglesArea += fabs((double) (b.x - a.x) * (c.y - a.y) - (double) (c.x - a.x) * (b.y - a.y));
+            }
+            result.areaError = (float) fabs(trianglesArea / fabs(polygonArea) - 1.0);
+        }
+    }
+    drawList._ClearFreeMemory();
+}
+
+void DemoBench::polygonFillImgui() {
+    if (ImGui::Button("benchmark##polygonFill")) polygonFillBench();
+    if (polygonFillResults.empty()) return;
+    ImGui::TextDisabled("ns per point");
+    if (ImGui::BeginTable("polygonFill", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("shape");
+        ImGui::TableSetupColumn("points");
+        ImGui::TableSetupColumn("convex AA");
+        ImGui::TableSetupColumn("concave AA");
+        ImGui::TableSetupColumn("concave");
+        ImGui::TableSetupColumn("area error");
+        ImGui::TableHeadersRow();
+        for (const PolygonFillResult &result : polygonFillResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.shape);
+            ImGui::TableNextColumn(); ImGui::Text("%u", result.points);
+            ImGui::TableNextColumn();
+            if (result.convexNs > 0.0f) ImGui::Text("%.2f", result.convexNs);
+            else ImGui::TextDisabled("-");
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", result.concaveNs[0]);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", result.concaveNs[1]);
+            ImGui::TableNextColumn(); ImGui::Text("%g", result.areaError);
+        }
+        ImGui::EndTable();
+    }
+}
+
+void DemoBench::fontZoomImgui() {
+    ImGui::Checkbox("animate", &fontZoom);
+    ImGui::SameLine();
+    ImGui::TextDisabled("atlas growth and uploads are in the overlay (F1)");
+    if (!fontZoom) return;
+    fontZoomPhase += ImGui::GetIO().DeltaTime;
+    const float size = 13.0f + 51.0f * (0.5f - 0.5f * cosf(fontZoomPhase));
+    ImGui::PushFont(nullptr, size);
+    ImGui::TextWrapped("%.2f px: The quick brown fox jumps over the lazy dog 0123456789 (){}[]<>!?", size);
+    ImGui::PopFont();
+}
+
+namespace {
+    // the glyphs loaded by the atlas checks
+    constexpr const char *glyphText = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789.,;:!?@#$%&*()[]{}<>/\\|+-=_~^'\"`";
+}
+
+#if defined(IMGUI_ENABLE_ATLAS_BUDGET) || defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE)
+namespace {
+    struct GlyphImage {
+        float metrics[5] = {};          // X0, Y0, X1, Y1, AdvanceX
+        int width = 0, height = 0;
+        std::vector<unsigned char> pixels;
+    };
+
+    // loads (or finds) every glyph of glyphText, which also keeps the bake in use for this frame
+    void captureGlyphs(ImFontAtlas *atlas, ImFont *font, float size, std::vector<GlyphImage> &images) {
+        ImFontBaked *baked = font->GetFontBaked(size);
+        images.clear();
+        for (const char *p = glyphText; *p; ) {
+            unsigned int c = 0;
+            p += ImTextCharFromUtf8(&c, p, nullptr);
+            const ImFontGlyph *glyph = baked->FindGlyph((ImWchar) c);
+            GlyphImage &image = images.emplace_back();
+            const float metrics[5] = {glyph->X0, glyph->Y0, glyph->X1, glyph->Y1, glyph->AdvanceX};
+            memcpy(image.metrics, metrics, sizeof(metrics));
+            if (glyph->PackId == ImFontAtlasRectId_Invalid) continue;
+            const ImTextureRect *r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+            ImTextureData *tex = atlas->TexData;
+            image.width = r->w;
+            image.height = r->h;
+            for (int y = 0; y < r->h; ++y) {
+                const auto *row = (const unsigned char*) tex->GetPixelsAt(r->x, r->y + y);
+                image.pixels.insert(image.pixels.end(), row, row + r->w * tex->BytesPerPixel);
+            }
+        }
+    }
+
+    // glyphs without the same metrics and bitmap
+    uint32_t compareGlyphs(const std::vector<GlyphImage> &a, const std::vector<GlyphImage> &b) {
+        uint32_t mismatches = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            const bool same = i < b.size() && memcmp(a[i].metrics, b[i].metrics, sizeof(a[i].metrics)) == 0 &&
+                              a[i].width == b[i].width && a[i].height == b[i].height && a[i].pixels == b[i].pixels;
+            mismatches += !same;
+        }
+        return mismatches;
+    }
+}
+#endif
+
+#if defined(IMGUI_ENABLE_ATLAS_BUDGET) || defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE) || defined(IMGUI_ENABLE_PAGED_ATLAS)
+namespace {
+    // scratch atlas with the default font, in the state of a frame with a renderer (ImGuiBackendFlags_RendererHasTextures)
+    ImFontAtlas *createGlyphAtlas(ImFont **font) {
+        ImFontAtlas *atlas = IM_NEW(ImFontAtlas)();
+        atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+        *font = atlas->AddFontDefault();
+        ImFontAtlasUpdateNewFrame(atlas, 1, true);
+        return atlas;
+    }
+}
+#endif
+
+#if defined(IMGUI_ENABLE_PAGED_ATLAS) || defined(IMGUI_ENABLE_SDF_FONTS)
+namespace {
+    // a context taking over a scratch atlas, for the backend flags the atlas reads from its first context. Doesn't change the current
+    // context, and ImGui::DestroyContext() deletes the atlas with it
+    ImGuiContext *createAtlasContext(ImFontAtlas *atlas, ImGuiBackendFlags flags) {
+        ImGuiContext *context = ImGui::CreateContext(atlas);
+        context->IO.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | flags;
+        return context;
+    }
+}
+#endif
+
+void DemoBench::evictionBench() {
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    TRACE_ZONE("DemoBench::evictionBench");
+    evictionResults.clear();
+
+    for (float size : {13.0f, 32.0f}) {
+        // a budget far below the glyphs, frames are simulated with ImFontAtlasUpdateNewFrame()
+        ImFont *font = nullptr;
+        ImFontAtlas *atlas = createGlyphAtlas(&font);
+        int frame = 1;
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        atlas->Builder->AsyncGlyphs.Disabled = true;
+#endif
+        auto capture = [&](std::vector<GlyphImage> &images) { captureGlyphs(atlas, font, size, images); };
+
+        EvictionResult result;
+        result.size = size;
+        std::vector<GlyphImage> reference, again;
+        capture(reference);
+        result.glyphs = (int) reference.size();
+        ImFontAtlasBudget &budget = atlas->Builder->Budget;
+        budget.MaxBytes = 1024;
+
+        // the bake stays in use but its glyphs are not rendered: they go at the next glyph sweep
+        for (int n = 0; n < IM_FONTATLASBUDGET_INTERVAL_FRAMES * 2 && budget.EvictedGlyphs == 0; ++n) {
+            ImFontAtlasUpdateNewFrame(atlas, ++frame, true);
+            font->GetFontBaked(size);
+        }
+        ImFontAtlasUpdateNewFrame(atlas, ++frame, true); // compacts ImFontBaked::Glyphs[]
+        capture(again);
+        result.mismatches += compareGlyphs(reference, again);
+
+        // then the whole bake, once it missed a frame
+        for (int n = 0; n < 4 && budget.EvictedBakes == 0; ++n) {
+            ImFontAtlasUpdateNewFrame(atlas, ++frame, true);
+        }
+        capture(again);
+        result.mismatches += compareGlyphs(reference, again);
+
+        result.evictedGlyphs = budget.EvictedGlyphs;
+        result.evictedBakes = budget.EvictedBakes;
+        result.rerasterized = budget.Rerasterized;
+        evictionResults.push_back(result);
+        IM_DELETE(atlas);
+    }
+#endif
+}
+
+void DemoBench::evictionImgui() {
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    if (ImGui::Button("check##eviction")) evictionBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("evicts glyphs then a bake from a scratch atlas, they must load again identical");
+    if (evictionResults.empty()) return;
+    if (ImGui::BeginTable("eviction", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("size");
+        ImGui::TableSetupColumn("glyphs");
+        ImGui::TableSetupColumn("evicted glyphs");
+        ImGui::TableSetupColumn("evicted bakes");
+        ImGui::TableSetupColumn("rasterized again");
+        ImGui::TableSetupColumn("reloaded");
+        ImGui::TableHeadersRow();
+        for (const EvictionResult &result : evictionResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%.0f px", result.size);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.glyphs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.evictedGlyphs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.evictedBakes);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.rerasterized);
+            ImGui::TableNextColumn();
+            if (result.evictedGlyphs == 0 || result.evictedBakes == 0) ImGui::TextUnformatted("NOT EVICTED");
+            else if (result.mismatches) ImGui::Text("%u MISMATCH", result.mismatches);
+            else ImGui::TextUnformatted("identical");
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_ATLAS_BUDGET");
+#endif
+}
+
+void DemoBench::glyphLoadBench() {
+#if defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE)
+    TRACE_ZONE("DemoBench::glyphLoadBench");
+    glyphLoadResults.clear();
+    for (float size : {13.0f, 32.0f}) {
+        GlyphLoadResult result;
+        result.size = size;
+        std::vector<GlyphImage> reference, images;
+        ImFont *font = nullptr;
+        ImFontAtlas *atlas = createGlyphAtlas(&font);
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        atlas->Builder->AsyncGlyphs.Disabled = true;
+#endif
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        // all misses, saved when the atlas is destroyed
+        constexpr const char *cacheFile = "imgui_bench_glyphs.bin";
+        remove(cacheFile);
+        atlas->GlyphCacheFilename = cacheFile;
+#endif
+        captureGlyphs(atlas, font, size, reference);
+        result.glyphs = (int) reference.size();
+        IM_DELETE(atlas);
+
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+        atlas = createGlyphAtlas(&font);
+        atlas->GlyphCacheFilename = cacheFile;
+        captureGlyphs(atlas, font, size, images);
+        result.cacheHits = atlas->Builder->GlyphCache.Hits;
+        result.cacheMismatches = compareGlyphs(reference, images);
+        IM_DELETE(atlas);
+        remove(cacheFile);
+#endif
+
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        // the requests render blank until the frames apply them
+        atlas = createGlyphAtlas(&font);
+        const ImFontAsyncGlyphs &async = atlas->Builder->AsyncGlyphs;
+        captureGlyphs(atlas, font, size, images);
+        result.asyncRequested = async.PendingCount;
+        for (int frame = 2; async.PendingCount > 0 && frame < 1000; ++frame) {
+            ImFontAtlasAsyncGlyphsWait(atlas);
+            ImFontAtlasUpdateNewFrame(atlas, frame, true);
+            result.asyncFrames++;
+        }
+        captureGlyphs(atlas, font, size, images);
+        result.asyncMismatches = compareGlyphs(reference, images);
+        IM_DELETE(atlas);
+#endif
+        glyphLoadResults.push_back(result);
+    }
+#endif
+}
+
+void DemoBench::glyphLoadImgui() {
+#if defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE)
+    if (ImGui::Button("check##glyphLoad")) glyphLoadBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("glyphs rasterized by the loader, then on the glyph workers and from the disk cache");
+    if (glyphLoadResults.empty()) return;
+    if (ImGui::BeginTable("glyphLoad", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("size");
+        ImGui::TableSetupColumn("glyphs");
+        ImGui::TableSetupColumn("async requests");
+        ImGui::TableSetupColumn("async glyphs");
+        ImGui::TableSetupColumn("cache hits");
+        ImGui::TableSetupColumn("cached glyphs");
+        ImGui::TableHeadersRow();
+        for (const GlyphLoadResult &result : glyphLoadResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%.0f px", result.size);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.glyphs);
+            ImGui::TableNextColumn();
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+            ImGui::Text("%d, applied in %d frames", result.asyncRequested, result.asyncFrames);
+            ImGui::TableNextColumn();
+            if (result.asyncRequested == 0) ImGui::TextUnformatted("NOT ASYNC");
+            else if (result.asyncMismatches) ImGui::Text("%u MISMATCH", result.asyncMismatches);
+            else ImGui::TextUnformatted("identical");
+#else
+            ImGui::TextDisabled("-");
+            ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+#endif
+            ImGui::TableNextColumn();
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+            ImGui::Text("%d", result.cacheHits);
+            ImGui::TableNextColumn();
+            if (result.cacheHits == 0) ImGui::TextUnformatted("NOT CACHED");
+            else if (result.cacheMismatches) ImGui::Text("%u MISMATCH", result.cacheMismatches);
+            else ImGui::TextUnformatted("identical");
+#else
+            ImGui::TextDisabled("-");
+            ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+#endif
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_ASYNC_GLYPHS and IMGUI_ENABLE_GLYPH_DISK_CACHE");
+#endif
+}
+
+void DemoBench::packerBench() {
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    TRACE_ZONE("DemoBench::packerBench");
+    // glyph boxes of the current bake, relative to its size
+    const ImFontBaked *reference = ImGui::GetFontBaked();
+    std::vector<ImVec2> boxes;
+    for (const ImFontGlyph &glyph : reference->Glyphs) {
+        if (glyph.Visible) boxes.push_back(ImVec2((glyph.X1 - glyph.X0) / reference->Size, (glyph.Y1 - glyph.Y0) / reference->Size));
+    }
+    if (boxes.empty()) return;
+
+    // a zoom sweep at two DPI scales, each size is a bake of all these glyphs. Only the last few bakes stay alive, the
+    // older ones are discarded like the atlas discards unused bakes.
+    constexpr size_t liveBakes = 8;
+    for (int shelf = 0; shelf < 2; ++shelf) {
+        ImFontAtlas *atlas = IM_NEW(ImFontAtlas)();
+        atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+        ImFontAtlasBuildInit(atlas);
+        ImFontAtlasBuilder *builder = atlas->Builder;
+        builder->ShelfPacker.Disabled = !shelf;
+        ImFontAtlasTextureRepack(atlas, atlas->TexData->Width, atlas->TexData->Height); // picks the packer
+
+        std::vector<std::vector<ImFontAtlasRectId>> bakes;
+        std::chrono::duration<double, std::nano> elapsed = {};
+        auto bake = [&](float pixels) {
+            std::vector<ImFontAtlasRectId> &ids = bakes.emplace_back();
+            ids.reserve(boxes.size());
+            const auto start = Clock::now();
+            for (const ImVec2 &box : boxes) {
+                ids.push_back(ImFontAtlasPackAddRect(atlas, (int) ceilf(box.x * pixels) + 1, (int) ceilf(box.y * pixels) + 1));
+            }
+            elapsed += Clock::now() - start;
+            if (bakes.size() > liveBakes) {
+                for (ImFontAtlasRectId id : bakes.front()) {
+                    if (id != ImFontAtlasRectId_Invalid) ImFontAtlasPackDiscardRect(atlas, id);
+                }
+                bakes.erase(bakes.begin());
+            }
+        };
+        const int padding = atlas->TexGlyphPadding;
+        auto liveRects = [&]() {
+            std::vector<ImTextureRect> live;
+            for (const std::vector<ImFontAtlasRectId> &ids : bakes) {
+                for (ImFontAtlasRectId id : ids) {
+                    if (id != ImFontAtlasRectId_Invalid) live.push_back(*ImFontAtlasPackGetRect(atlas, id));
+                }
+            }
+            return live;
+        };
+        PackerResult &result = packerResults[shelf];
+        uint32_t inserts = 0;
+        for (int scale = 1; scale <= 2; ++scale) {
+            for (int size = 10; size <= 72; size += 2) {
+                bake((float) (size * scale));
+                inserts += (uint32_t) boxes.size();
+            }
+        }
+        result.inserts = inserts;
+        result.insertNs = (float) (elapsed.count() / inserts);
+        result.makeSpace = builder->ShelfPacker.MakeSpaceCount;
+
+        // the texture size is set by the end of the sweep, with the largest bakes alive
+        const ImTextureData *tex = atlas->TexData;
+        double surface = 0.0;
+        for (const ImTextureRect &r : liveRects()) surface += (double) (r.w + padding) * (r.h + padding);
+        result.texWidth = tex->Width;
+        result.texHeight = tex->Height;
+        result.efficiency = (float) (surface / ((double) tex->Width * tex->Height));
+
+        // then zooming back and forth in the same range: the discarded space is enough for the new bakes
+        elapsed = {};
+        for (int size = 72, step = -6, n = 0; n < 64; size += step, ++n) {
+            if (size <= 10 || size >= 144) step = -step;
+            bake((float) size);
+        }
+        result.churnNs = (float) (elapsed.count() / (64.0 * boxes.size()));
+        result.churnMakeSpace = builder->ShelfPacker.MakeSpaceCount - result.makeSpace;
+
+        // the live rectangles (with their padding) must not overlap, nor leave the texture
+        const std::vector<ImTextureRect> live = liveRects();
+        result.overlaps = 0;
+        result.outside = 0;
+        for (size_t i = 0; i < live.size(); ++i) {
+            if (live[i].x + live[i].w > atlas->TexData->Width || live[i].y + live[i].h > atlas->TexData->Height) result.outside++;
+            for (size_t j = i + 1; j < live.size(); ++j) {
+                const ImTextureRect &a = live[i], &b = live[j];
+                if (a.x < b.x + b.w + padding && b.x < a.x + a.w + padding && a.y < b.y + b.h + padding && b.y < a.y + a.h + padding) result.overlaps++;
+            }
+        }
+        IM_DELETE(atlas);
+    }
+#endif
+}
+
+void DemoBench::packerImgui() {
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    if (ImGui::Button("benchmark##packer")) packerBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("glyph stream of a zoom sweep in a scratch atlas");
+    if (packerResults[0].inserts == 0) return;
+    if (ImGui::BeginTable("packer", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("packer");
+        ImGui::TableSetupColumn("sweep ns");
+        ImGui::TableSetupColumn("grow/repack");
+        ImGui::TableSetupColumn("churn ns");
+        ImGui::TableSetupColumn("grow/repack");
+        ImGui::TableSetupColumn("texture");
+        ImGui::TableSetupColumn("used");
+        ImGui::TableSetupColumn("rectangles");
+        ImGui::TableHeadersRow();
+        for (int shelf = 0; shelf < 2; ++shelf) {
+            const PackerResult &result = packerResults[shelf];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(shelf ? "shelf" : "stb_rectpack");
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", result.insertNs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.makeSpace);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", result.churnNs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.churnMakeSpace);
+            ImGui::TableNextColumn(); ImGui::Text("%dx%d", result.texWidth, result.texHeight);
+            ImGui::TableNextColumn(); ImGui::Text("%.0f%%", result.efficiency * 100.0f);
+            ImGui::TableNextColumn();
+            if (result.overlaps || result.outside) ImGui::Text("%u OVERLAP, %u OUTSIDE", result.overlaps, result.outside);
+            else ImGui::TextUnformatted("disjoint");
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("ns per ImFontAtlasPackAddRect(), %u inserts in the sweep", packerResults[0].inserts);
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_SHELF_PACKER");
+#endif
+}
+
+void DemoBench::pagesBench() {
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    TRACE_ZONE("DemoBench::pagesBench");
+    pagesResults.clear();
+
+    // a packed glyph, where it is and its pixels
+    struct Placed {
+        ImFontAtlasRectId id = ImFontAtlasRectId_Invalid;
+        ImTextureRect rect = {};
+        std::vector<unsigned char> pixels;
+    };
+    for (int pageSize : {128, 256}) {
+        ImFont *font = nullptr;
+        ImFontAtlas *atlas = createGlyphAtlas(&font);
+        ImGuiContext *context = createAtlasContext(atlas, ImGuiBackendFlags_RendererHasTexturePages);
+        ImFontAtlasBuilder *builder = atlas->Builder;
+        builder->Pages.PageSize = pageSize;
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        builder->AsyncGlyphs.Disabled = true;
+#endif
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+        builder->Budget.Disabled = true;
+#endif
+        auto read = [&](Placed &placed) {
+            ImTextureData *tex = atlas->TexData;
+            placed.rect = *ImFontAtlasPackGetRect(atlas, placed.id);
+            placed.pixels.clear();
+            for (int y = 0; y < placed.rect.h; ++y) {
+                const auto *row = (const unsigned char*) tex->GetPixelsAt(placed.rect.x, placed.rect.y + y);
+                placed.pixels.insert(placed.pixels.end(), row, row + placed.rect.w * tex->BytesPerPixel);
+            }
+        };
+
+        // every bake stays in use, the texture only gets space from new pages (or a repack once TexMaxHeight is reached)
+        PagesResult result;
+        result.pageSize = pageSize;
+        std::vector<Placed> placed;
+        std::vector<float> sizes;
+        int repacks = builder->Pages.RepackCount;
+        for (int frame = 2, size = 10; size <= 48; ++frame, size += 2) {
+            ImFontAtlasUpdateNewFrame(atlas, frame, true);
+            for (float previous : sizes) font->GetFontBaked(previous);
+            sizes.push_back((float) size);
+            const size_t previousGlyphs = placed.size();
+            ImFontBaked *baked = font->GetFontBaked((float) size);
+            for (const char *p = glyphText; *p; ) {
+                unsigned int c = 0;
+                p += ImTextCharFromUtf8(&c, p, nullptr);
+                const ImFontGlyph *glyph = baked->FindGlyph((ImWchar) c);
+                if (glyph->PackId != ImFontAtlasRectId_Invalid) placed.emplace_back().id = glyph->PackId;
+            }
+            for (ImTextureData *tex : atlas->TexList) {
+                if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates) {
+                    tex->SetStatus(ImTextureStatus_OK);
+                }
+            }
+
+            if (builder->Pages.RepackCount != repacks) {
+                repacks = builder->Pages.RepackCount;
+                for (Placed &glyph : placed) read(glyph);
+                continue;
+            }
+            Placed now;
+            for (size_t i = 0; i < previousGlyphs; ++i) {
+                now.id = placed[i].id;
+                read(now);
+                const ImTextureRect &a = placed[i].rect, &b = now.rect;
+                result.moved += a.x != b.x || a.y != b.y || a.w != b.w || a.h != b.h || placed[i].pixels != now.pixels;
+            }
+            for (size_t i = previousGlyphs; i < placed.size(); ++i) read(placed[i]);
+        }
+
+        const ImTextureData *tex = atlas->TexData;
+        for (const Placed &glyph : placed) {
+            const ImTextureRect &r = glyph.rect;
+            result.crossing += r.h > 0 && r.y / tex->PageHeight != (r.y + r.h - 1) / tex->PageHeight;
+        }
+        result.pages = tex->Height / tex->PageHeight;
+        result.appended = builder->Pages.AppendCount;
+        result.repacks = builder->Pages.RepackCount;
+        result.glyphs = (int) placed.size();
+        pagesResults.push_back(result);
+        ImGui::DestroyContext(context);     // deletes the atlas, its last reference
+    }
+#endif
+}
+
+void DemoBench::pagesImgui() {
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    if (ImGui::Button("check##pages")) pagesBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("zoom sweep in a scratch atlas with small pages, packed glyphs must stay in place");
+    if (pagesResults.empty()) return;
+    if (ImGui::BeginTable("pages", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("page");
+        ImGui::TableSetupColumn("glyphs");
+        ImGui::TableSetupColumn("pages");
+        ImGui::TableSetupColumn("appended");
+        ImGui::TableSetupColumn("grow/repack");
+        ImGui::TableSetupColumn("packed");
+        ImGui::TableHeadersRow();
+        for (const PagesResult &result : pagesResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%d rows", result.pageSize);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.glyphs);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.pages);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.appended);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.repacks);
+            ImGui::TableNextColumn();
+            if (result.appended == 0) ImGui::TextUnformatted("NOT PAGED");
+            else if (result.moved || result.crossing) ImGui::Text("%u MOVED, %u ACROSS PAGES", result.moved, result.crossing);
+            else ImGui::TextUnformatted("in place");
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_PAGED_ATLAS");
+#endif
+}
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+namespace {
+    struct RasterFont {
+        const char *label;
+        const char *paths[3];       // nullptr: the default font
+        const char *text;
+    };
+    constexpr const char *rasterLatin = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789.,;:!?@#$%&*()[]{}<>/\\|+-=_~^'\"`";
+    constexpr const char *rasterCjk =
+        "\xe7\x9a\x84\xe4\xb8\x80\xe6\x98\xaf\xe4\xb8\x8d\xe4\xba\x86\xe4\xba\xba\xe6\x88\x91\xe5\x9c\xa8\xe6\x9c\x89\xe4\xbb\x96"  // 的一是不了人我在有他
+        "\xe8\xbf\x99\xe4\xb8\xad\xe5\xa4\xa7\xe6\x9d\xa5\xe4\xb8\x8a\xe5\x9b\xbd\xe4\xb8\xaa\xe5\x88\xb0\xe8\xaf\xb4\xe4\xbb\xac"  // 这中大来上国个到说们
+        "\xe4\xb8\xba\xe5\xad\x90\xe5\x92\x8c\xe4\xbd\xa0\xe5\x9c\xb0\xe5\x87\xba\xe9\x81\x93\xe4\xb9\x9f\xe6\x97\xb6\xe5\xb9\xb4"  // 为子和你地出道也时年
+        "\xe5\xbe\x97\xe5\xb0\xb1\xe9\x82\xa3\xe8\xa6\x81\xe4\xb8\x8b\xe4\xbb\xa5\xe7\x94\x9f\xe4\xbc\x9a\xe8\x87\xaa\xe7\x9d\x80"  // 得就那要下以生会自着
+        "\xe5\x8e\xbb\xe4\xb9\x8b\xe8\xbf\x87\xe5\xae\xb6\xe5\xad\xa6\xe5\xaf\xb9\xe5\x8f\xaf\xe5\xa5\xb9\xe9\x87\x8c\xe5\x90\x8e"  // 去之过家学对可她里后
+        "\xe9\xbe\x8d\xe9\xac\xb1\xe9\xbd\x89\xe7\x81\xa3\xe9\xb8\x9e\xe8\xae\x80\xe9\xab\x94\xe9\xb7\xb9\xe9\xa9\x97\xe5\x9b\x8d"; // 龍鬱齉灣鸞讀體鷹驗囍 (dense ones)
+    const RasterFont rasterFonts[] = {
+        {"Latin (default font)", {}, rasterLatin},
+        {"Latin", {"C:/Windows/Fonts/arial.ttf", "/System/Library/Fonts/Supplemental/Arial.ttf", "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"}, rasterLatin},
+        {"CJK", {"C:/Windows/Fonts/msyh.ttc", "/System/Library/Fonts/Hiragino Sans GB.ttc", "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc"}, rasterCjk},
+    };
+}
+#endif
+
+void DemoBench::rasterBench() {
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+    TRACE_ZONE("DemoBench::rasterBench");
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr float size = 32.0f;
+    constexpr int runs = 3;
+    rasterResults.clear();
+    rasterMissing.clear();
+    const bool wasScalar = GImFontRasterizeScalar;
+
+    for (const RasterFont &source : rasterFonts) {
+        for (int oversample = 1; oversample <= 4; ++oversample) {
+            // a scratch atlas per kernel and run, glyphs baked synchronously (best run kept)
+            ImFontAtlas *atlases[2] = {};
+            ImFont *fonts[2] = {};
+            RasterResult result;
+            result.font = source.label;
+            result.oversample = oversample;
+            result.glyphUs[0] = result.glyphUs[1] = FLT_MAX;
+            for (int run = 0; run < runs * 2; ++run) {
+                const int simd = run & 1;
+                if (atlases[simd]) IM_DELETE(atlases[simd]);
+                ImFontAtlas *atlas = atlases[simd] = IM_NEW(ImFontAtlas)();
+                atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+                ImFontConfig config;
+                config.OversampleH = config.OversampleV = oversample;
+                config.Flags |= ImFontFlags_NoLoadError;
+                ImFont *font = nullptr;
+                if (source.paths[0] == nullptr) {
+                    font = atlas->AddFontDefault(&config);
+                }
+                for (const char *path : source.paths) {
+                    if (font == nullptr && path != nullptr) font = atlas->AddFontFromFileTTF(path, size, &config);
+                }
+                if (font == nullptr) break;
+                fonts[simd] = font;
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+                atlas->Builder->AsyncGlyphs.Disabled = true;
+#endif
+                ImFontBaked *baked = font->GetFontBaked(size);
+                GImFontRasterizeScalar = !simd;
+                int glyphs = 0;
+                const auto start = Clock::now();
+                for (const char *text = source.text; *text; ) {
+                    unsigned int c = 0;
+                    text += ImTextCharFromUtf8(&c, text, nullptr);
+                    baked->FindGlyph((ImWchar) c);
+                    ++glyphs;
+                }
+                const std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+                result.glyphs = glyphs;
+                result.glyphUs[simd] = std::min(result.glyphUs[simd], (float) (elapsed.count() / glyphs));
+            }
+            GImFontRasterizeScalar = wasScalar;
+            if (fonts[0] == nullptr) {
+                rasterMissing.push_back(source.label);
+                for (ImFontAtlas *atlas : atlases) if (atlas) IM_DELETE(atlas);
+                break;
+            }
+
+            // golden image: the same glyph bitmaps with both kernels
+            ImFontBaked *baked[2] = {fonts[0]->GetFontBaked(size), fonts[1]->GetFontBaked(size)};
+            for (const char *text = source.text; *text; ) {
+                unsigned int c = 0;
+                text += ImTextCharFromUtf8(&c, text, nullptr);
+                const ImFontGlyph *glyphs[2] = {baked[0]->FindGlyphNoFallback((ImWchar) c), baked[1]->FindGlyphNoFallback((ImWchar) c)};
+                if (!glyphs[0] || !glyphs[1] || glyphs[0]->PackId == ImFontAtlasRectId_Invalid || glyphs[1]->PackId == ImFontAtlasRectId_Invalid) continue;
+                const ImTextureRect *rects[2] = {ImFontAtlasPackGetRect(atlases[0], glyphs[0]->PackId), ImFontAtlasPackGetRect(atlases[1], glyphs[1]->PackId)};
+                if (rects[0]->w != rects[1]->w || rects[0]->h != rects[1]->h) {
+                    result.maxDiff = 255;
+                    continue;
+                }
+                for (int y = 0; y < rects[0]->h; ++y) {
+                    const auto *row0 = (const unsigned char*) atlases[0]->TexData->GetPixelsAt(rects[0]->x, rects[0]->y + y);
+                    const auto *row1 = (const unsigned char*) atlases[1]->TexData->GetPixelsAt(rects[1]->x, rects[1]->y + y);
+                    for (int x = 0; x < rects[0]->w; ++x) {
+                        const int diff = std::abs((int) row0[x] - (int) row1[x]);
+                        result.maxDiff = std::max(result.maxDiff, diff);
+                        result.diffPixels += diff != 0;
+                    }
+                }
+                result.pixels += (uint32_t) rects[0]->w * rects[0]->h;
+            }
+            for (ImFontAtlas *atlas : atlases) IM_DELETE(atlas);
+            rasterResults.push_back(result);
+        }
+    }
+#endif
+}
+
+void DemoBench::rasterImgui() {
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+    if (ImGui::Button("benchmark##raster")) rasterBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("bakes the same glyphs at 32px with the stb_truetype code, then the SIMD passes");
+#if defined(IMGUI_ENABLE_AVX2)
+    ImGui::TextUnformatted("SIMD: AVX2 accumulation (8 pixels per iteration), SSE2 prefilter (16)");
+#elif defined(IMGUI_ENABLE_SSE2)
+    ImGui::TextUnformatted("SIMD: SSE2 accumulation (4 pixels per iteration) and prefilter (16)");
+#elif defined(IMGUI_ENABLE_NEON)
+    ImGui::TextUnformatted("SIMD: NEON accumulation (4 pixels per iteration) and prefilter (16)");
+#else
+    ImGui::TextUnformatted("SIMD: none in this build, same code both ways");
+#endif
+    for (const char *font : rasterMissing) ImGui::TextDisabled("%s: no font file found", font);
+    if (rasterResults.empty()) return;
+    if (ImGui::BeginTable("raster", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("font");
+        ImGui::TableSetupColumn("oversample");
+        ImGui::TableSetupColumn("us/glyph stb_truetype");
+        ImGui::TableSetupColumn("SIMD");
+        ImGui::TableSetupColumn("max diff");
+        ImGui::TableSetupColumn("pixels differing");
+        ImGui::TableHeadersRow();
+        for (const RasterResult &result : rasterResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.font);
+            ImGui::TableNextColumn(); ImGui::Text("%dx%d", result.oversample, result.oversample);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", result.glyphUs[0]);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f (%.2fx)", result.glyphUs[1], result.glyphUs[0] / result.glyphUs[1]);
+            ImGui::TableNextColumn(); ImGui::Text("%d%s", result.maxDiff, result.maxDiff > 1 ? " MISMATCH" : "");
+            ImGui::TableNextColumn(); ImGui::Text("%u / %u", result.diffPixels, result.pixels);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("%d Latin glyphs, %d CJK glyphs", (int) strlen(rasterLatin), ImTextCountCharsFromUtf8(rasterCjk, nullptr));
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_STB_TRUETYPE_SIMD");
+#endif
+}
+
+#ifdef IMGUI_ENABLE_SDF_FONTS
+namespace {
+    const char *const sdfFontPaths[] = {"C:/Windows/Fonts/arial.ttf", "/System/Library/Fonts/Supplemental/Arial.ttf", "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"};
+    // measured with DejaVu Sans from 12 to 96 px: 0.03 to 0.10, most of it on the edges of small sizes (no hinting either way)
+    constexpr float sdfMaxMeanError = 0.15f;
+
+    // a glyph quad as ImFont::RenderChar() lays it out at 'scale', and its bitmap in 0..1
+    struct GlyphQuad {
+        float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f;
+        int width = 0, height = 0;
+        std::vector<float> texels;
+    };
+
+    GlyphQuad glyphQuad(ImFontAtlas *atlas, const ImFontGlyph *glyph, float scale) {
+        GlyphQuad quad;
+        quad.x0 = glyph->X0 * scale;
+        quad.y0 = glyph->Y0 * scale;
+        quad.x1 = glyph->X1 * scale;
+        quad.y1 = glyph->Y1 * scale;
+        if (glyph->PackId == ImFontAtlasRectId_Invalid) return quad;
+        const ImTextureRect *r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
+        ImTextureData *tex = atlas->TexData;
+        quad.width = r->w;
+        quad.height = r->h;
+        for (int y = 0; y < r->h; ++y) {
+            for (int x = 0; x < r->w; ++x) quad.texels.push_back(*(const unsigned char*) tex->GetPixelsAt(r->x + x, r->y + y) / 255.0f);
+        }
+        return quad;
+    }
+
+    // the bitmap at a layout position with the UVs of the quad, filtered bilinearly over the (empty) atlas padding
+    float sampleQuad(const GlyphQuad &quad, float x, float y) {
+        if (quad.x1 <= quad.x0 || quad.y1 <= quad.y0) return 0.0f;
+        const float u = (x - quad.x0) / (quad.x1 - quad.x0) * quad.width - 0.5f;
+        const float v = (y - quad.y0) / (quad.y1 - quad.y0) * quad.height - 0.5f;
+        const int u0 = (int) floorf(u), v0 = (int) floorf(v);
+        const float fu = u - u0, fv = v - v0;
+        auto texel = [&](int tx, int ty) {
+            return tx < 0 || ty < 0 || tx >= quad.width || ty >= quad.height ? 0.0f : quad.texels[ty * quad.width + tx];
+        };
+        return (texel(u0, v0) * (1.0f - fu) + texel(u0 + 1, v0) * fu) * (1.0f - fv) + (texel(u0, v0 + 1) * (1.0f - fu) + texel(u0 + 1, v0 + 1) * fu) * fv;
+    }
+
+    bool insideQuad(const GlyphQuad &quad, float x, float y) {
+        return x >= quad.x0 && x < quad.x1 && y >= quad.y0 && y < quad.y1;
+    }
+}
+#endif
+
+void DemoBench::sdfBench() {
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    TRACE_ZONE("DemoBench::sdfBench");
+    sdfResults.clear();
+    sdfMissing = false;
+
+    // the same font file twice, [0] baked per size, [1] ImFontFlags_DistanceField, in an atlas whose context has the backend flag
+    ImFontAtlas *atlas = IM_NEW(ImFontAtlas)();
+    atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+    ImFont *fonts[2] = {};
+    for (int sdf = 0; sdf < 2; ++sdf) {
+        ImFontConfig config;
+        config.Flags |= ImFontFlags_NoLoadError | (sdf ? ImFontFlags_DistanceField : 0);
+        for (const char *path : sdfFontPaths) {
+            if (fonts[sdf] == nullptr) fonts[sdf] = atlas->AddFontFromFileTTF(path, IM_FONTSDF_BAKE_SIZE, &config);
+        }
+    }
+    if (fonts[0] == nullptr || fonts[1] == nullptr) {
+        sdfMissing = true;
+        IM_DELETE(atlas);
+        return;
+    }
+    ImGuiContext *context = createAtlasContext(atlas, ImGuiBackendFlags_RendererHasDistanceFields);
+    ImFontAtlasUpdateNewFrame(atlas, 1, true);
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    atlas->Builder->AsyncGlyphs.Disabled = true;
+#endif
+
+    std::vector<float> distances;
+    for (float size : {12.0f, 16.0f, 24.0f, 48.0f, 96.0f}) {
+        ImFontBaked *baked[2] = {fonts[0]->GetFontBaked(size), fonts[1]->GetFontBaked(size)};
+        const float scale = size / baked[1]->Size;
+        SdfResult result;
+        result.size = size;
+        result.distanceField = ImFontBakedIsDistanceField(baked[1]);
+        result.baseline = IM_ROUND(baked[0]->Ascent) - baked[1]->Ascent * scale;
+        double errorSum = 0.0;
+        uint32_t errorPixels = 0;
+        for (const char *p = glyphText; *p; ) {
+            unsigned int c = 0;
+            p += ImTextCharFromUtf8(&c, p, nullptr);
+            const ImFontGlyph *glyphs[2] = {baked[0]->FindGlyph((ImWchar) c), baked[1]->FindGlyph((ImWchar) c)};
+            result.glyphs++;
+            result.advanceMismatches += fabsf(glyphs[1]->AdvanceX * scale - glyphs[0]->AdvanceX) > 0.01f;
+            GlyphQuad quads[2] = {glyphQuad(atlas, glyphs[0], 1.0f), glyphQuad(atlas, glyphs[1], scale)};
+            quads[1].y0 += result.baseline;
+            quads[1].y1 += result.baseline;
+
+            // pixel centers over both quads. The distances are sampled around the quad too, for the derivatives (fwidth())
+            const int left = (int) floorf(std::min(quads[0].x0, quads[1].x0)), right = (int) ceilf(std::max(quads[0].x1, quads[1].x1));
+            const int top = (int) floorf(std::min(quads[0].y0, quads[1].y0)), bottom = (int) ceilf(std::max(quads[0].y1, quads[1].y1));
+            const int width = right - left + 1, height = bottom - top + 1;
+            distances.resize((size_t) width * height);
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) distances[y * width + x] = sampleQuad(quads[1], left + x + 0.5f, top + y + 0.5f);
+            }
+            for (int y = 0; y < height - 1; ++y) {
+                for (int x = 0; x < width - 1; ++x) {
+                    const float cx = left + x + 0.5f, cy = top + y + 0.5f;
+                    const float reference = insideQuad(quads[0], cx, cy) ? sampleQuad(quads[0], cx, cy) : 0.0f;
+                    float coverage = 0.0f;
+                    if (insideQuad(quads[1], cx, cy)) {
+                        const float d = distances[y * width + x];
+                        const float fwidth = fabsf(distances[y * width + x + 1] - d) + fabsf(distances[(y + 1) * width + x] - d);
+                        coverage = ImClamp((d - 0.5f) / std::max(fwidth, 1e-4f) + 0.5f, 0.0f, 1.0f);
+                    }
+                    if (reference == 0.0f && coverage == 0.0f) continue;
+                    const float error = fabsf(coverage - reference);
+                    errorSum += error;
+                    errorPixels++;
+                    result.maxError = std::max(result.maxError, error);
+                }
+            }
+        }
+        result.meanError = errorPixels ? (float) (errorSum / errorPixels) : 0.0f;
+        sdfResults.push_back(result);
+    }
+    ImGui::DestroyContext(context);     // deletes the atlas
+#endif
+}
+
+void DemoBench::sdfImgui() {
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    if (ImGui::Button("check##sdf")) sdfBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("distance field glyphs scaled from one bake, against the glyphs baked at each size");
+    if (sdfMissing) ImGui::TextDisabled("no font file found (Arial, DejaVu Sans)");
+    if (sdfResults.empty()) return;
+    if (ImGui::BeginTable("sdf", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("size");
+        ImGui::TableSetupColumn("glyphs");
+        ImGui::TableSetupColumn("baseline");
+        ImGui::TableSetupColumn("mean error");
+        ImGui::TableSetupColumn("max error");
+        ImGui::TableSetupColumn("coverage");
+        ImGui::TableHeadersRow();
+        for (const SdfResult &result : sdfResults) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::Text("%.0f px", result.size);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.glyphs);
+            ImGui::TableNextColumn(); ImGui::Text("%+.2f px", result.baseline);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", result.meanError);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", result.maxError);
+            ImGui::TableNextColumn();
+            if (!result.distanceField) ImGui::TextUnformatted("NOT DISTANCE FIELD");
+            else if (result.advanceMismatches) ImGui::Text("%u ADVANCE MISMATCH", result.advanceMismatches);
+            else if (fabsf(result.baseline) >= 1.0f || result.meanError > sdfMaxMeanError) ImGui::TextUnformatted("TOO FAR");
+            else ImGui::TextUnformatted("close");
+        }
+        ImGui::EndTable();
+    }
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_SDF_FONTS");
+#endif
+}
+
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+namespace {
+    struct BuildFont {
+        const char *label;
+        const char *paths[3];       // nullptr: the default font
+        const ImWchar *(ImFontAtlas::*ranges)();
+        float size;
+    };
+    const BuildFont buildFonts[] = {
+        {"Latin (default font)", {}, &ImFontAtlas::GetGlyphRangesDefault, 13.0f},
+        {"Latin + Cyrillic", {"C:/Windows/Fonts/arial.ttf", "/System/Library/Fonts/Supplemental/Arial.ttf", "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf"}, &ImFontAtlas::GetGlyphRangesCyrillic, 24.0f},
+        {"CJK (2500 common)", {"C:/Windows/Fonts/msyh.ttc", "/System/Library/Fonts/Hiragino Sans GB.ttc", "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc"}, &ImFontAtlas::GetGlyphRangesChineseSimplifiedCommon, 20.0f},
+    };
+}
+#endif
+
+void DemoBench::buildBench() {
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    TRACE_ZONE("DemoBench::buildBench");
+    constexpr int runs = 2;
+    const int workerCounts[] = {0, -1, 1, 2, 4, IM_FONTASYNCGLYPHS_MAX_WORKERS};
+    buildResults.clear();
+    buildMissing.clear();
+
+    for (const BuildFont &source : buildFonts) {
+        std::vector<unsigned char> serialPixels;
+        std::vector<ImFontGlyph> serialGlyphs;
+        for (int workers : workerCounts) {
+            BuildResult result;
+            result.font = source.label;
+            result.workers = workers;
+            result.buildMs = FLT_MAX;
+            bool missing = false;
+            for (int run = 0; run < runs && !missing; ++run) {
+                // a scratch atlas has no renderer using it, so Build() preloads the whole ranges like a legacy backend
+                ImFontAtlas *atlas = IM_NEW(ImFontAtlas)();
+                atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+                ImFontConfig config;
+                config.Flags |= ImFontFlags_NoLoadError;
+                config.GlyphRanges = (atlas->*source.ranges)();
+                ImFont *font = nullptr;
+                if (source.paths[0] == nullptr) {
+                    font = atlas->AddFontDefault(&config);
+                }
+                for (const char *path : source.paths) {
+                    if (font == nullptr && path != nullptr) font = atlas->AddFontFromFileTTF(path, source.size, &config);
+                }
+                if (font == nullptr) {
+                    missing = true;
+                    IM_DELETE(atlas);
+                    break;
+                }
+                ImFontAsyncGlyphs &async = atlas->Builder->AsyncGlyphs;
+                async.ParallelBuildDisabled = workers == 0;
+                async.WorkerCount = workers;
+                const auto start = Clock::now();
+                atlas->Build();
+                const std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+                result.buildMs = std::min(result.buildMs, (float) elapsed.count());
+                result.waitMs = async.LastBuildWaitMs;
+                result.threads = workers == 0 ? 1 : async.LastBuildThreads;
+
+                // golden image: the serial preload
+                const ImTextureData *tex = atlas->TexData;
+                const auto *pixels = (const unsigned char*) tex->Pixels;
+                const ImFontBaked *baked = font->GetFontBaked(font->LegacySize);
+                result.glyphs = baked->Glyphs.Size;
+                if (workers == 0) {
+                    serialPixels.assign(pixels, pixels + tex->GetSizeInBytes());
+                    serialGlyphs.assign(baked->Glyphs.begin(), baked->Glyphs.end());
+                } else {
+                    result.matches &= serialPixels.size() == (size_t) tex->GetSizeInBytes() && memcmp(serialPixels.data(), pixels, serialPixels.size()) == 0;
+                    result.matches &= serialGlyphs.size() == (size_t) baked->Glyphs.Size && memcmp(serialGlyphs.data(), baked->Glyphs.Data, baked->Glyphs.size_in_bytes()) == 0;
+                }
+                IM_DELETE(atlas);
+            }
+            if (missing) {
+                buildMissing.push_back(source.label);
+                break;
+            }
+            buildResults.push_back(result);
+        }
+    }
+#endif
+}
+
+void DemoBench::buildImgui() {
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    if (ImGui::Button("benchmark##build")) buildBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("ImFontAtlas::Build() of whole glyph ranges, serially then on the glyph workers");
+    for (const char *font : buildMissing) ImGui::TextDisabled("%s: no font file found", font);
+    if (buildResults.empty()) return;
+    if (ImGui::BeginTable("build", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("font");
+        ImGui::TableSetupColumn("glyphs");
+        ImGui::TableSetupColumn("threads");
+        ImGui::TableSetupColumn("build ms");
+        ImGui::TableSetupColumn("after packing ms");
+        ImGui::TableSetupColumn("atlas");
+        ImGui::TableHeadersRow();
+        float serialMs = 0.0f;
+        for (const BuildResult &result : buildResults) {
+            if (result.workers == 0) serialMs = result.buildMs;
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.font);
+            ImGui::TableNextColumn(); ImGui::Text("%d", result.glyphs);
+            ImGui::TableNextColumn();
+            if (result.workers == 0) ImGui::TextUnformatted("serial");
+            else ImGui::Text("%d", result.threads);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f (%.2fx)", result.buildMs, serialMs / result.buildMs);
+            ImGui::TableNextColumn();
+            if (result.workers == 0) ImGui::TextDisabled("-");
+            else ImGui::Text("%.1f", result.waitMs);
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(result.workers == 0 ? "reference" : result.matches ? "identical" : "MISMATCH");
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("threads: glyph workers + the calling thread, which packs first");
+#else
+    ImGui::TextDisabled("built without IMGUI_ENABLE_ASYNC_GLYPHS");
+#endif
+}
+
+void DemoBench::uploadBench() {
+    TRACE_ZONE("DemoBench::uploadBench");
+    uploadResults.clear();
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    const int pageHeights[] = {0, 128};
+#else
+    const int pageHeights[] = {0};
+#endif
+    for (int pageHeight : pageHeights) {
+        UploadResult result;
+        result.pageHeight = pageHeight;
+
+        // a scratch atlas without renderer, this loop acknowledges its texture requests like a backend would
+        ImFontAtlas *atlas = IM_NEW(ImFontAtlas)();
+        atlas->TexDesiredFormat = ImTextureFormat_Alpha8;
+        ImFont *font = atlas->AddFontDefault();
+        ImFontAtlasUpdateNewFrame(atlas, 1, true);
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+        atlas->Builder->AsyncGlyphs.Disabled = true;
+#endif
+        ImVector<ImTextureRect> regions;
+        std::vector<unsigned char> dirty;
+        for (int frame = 2, size = 10; size <= 72; ++frame, size += 2) {
+            ImFontAtlasUpdateNewFrame(atlas, frame, true);
+            ImFontBaked *baked = font->GetFontBaked((float) size);
+            for (const char *p = glyphText; *p; ) {
+                unsigned int c = 0;
+                p += ImTextCharFromUtf8(&c, p, nullptr);
+                baked->FindGlyph((ImWchar) c);
+            }
+            for (ImTextureData *tex : atlas->TexList) {
+                if (tex->Status == ImTextureStatus_WantUpdates && tex->Updates.Size > 0) {
+                    ImTextureData update;   // same requests, paged or not
+                    update.Status = tex->Status;
+                    update.Format = tex->Format;
+                    update.Width = tex->Width;
+                    update.Height = tex->Height;
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+                    update.PageHeight = pageHeight;
+#endif
+                    update.BytesPerPixel = tex->BytesPerPixel;
+                    update.UpdateRect = tex->UpdateRect;
+                    update.Updates = tex->Updates;
+                    const ImTextureRect bounds = update.UpdateRect;
+                    result.updates++;
+                    result.rects += (uint32_t) update.Updates.Size;
+                    for (const ImTextureRect &r : update.Updates) result.requestedBytes += (uint64_t) r.w * r.h * update.BytesPerPixel;
+
+                    for (int coalesce = 0; coalesce < 2; ++coalesce) {
+                        const auto start = Clock::now();
+                        ImGui_ImplWGPU_GetTextureUploadRegions(&update, coalesce != 0, &regions);
+                        const std::chrono::duration<double, std::micro> elapsed = Clock::now() - start;
+                        result.regionsUs[coalesce] += (float) elapsed.count();
+                        result.writes[coalesce] += (uint32_t) regions.Size;
+
+                        // every pixel of Updates[] in a region, every region within the bounding box and one page
+                        dirty.assign((size_t) bounds.w * bounds.h, 0);
+                        for (const ImTextureRect &r : update.Updates) {
+                            for (int y = r.y; y < r.y + r.h; ++y) memset(&dirty[(size_t) (y - bounds.y) * bounds.w + (r.x - bounds.x)], 1, r.w);
+                        }
+                        for (const ImTextureRect &r : regions) {
+                            result.uploadBytes[coalesce] += (uint64_t) r.w * r.h * update.BytesPerPixel;
+                            const bool inside = r.x >= bounds.x && r.y >= bounds.y && r.x + r.w <= bounds.x + bounds.w && r.y + r.h <= bounds.y + bounds.h;
+                            const bool onePage = pageHeight == 0 || r.h == 0 || r.y / pageHeight == (r.y + r.h - 1) / pageHeight;
+                            if (!inside || !onePage) {
+                                result.badRegions[coalesce]++;
+                                continue;
+                            }
+                            for (int y = r.y; y < r.y + r.h; ++y) memset(&dirty[(size_t) (y - bounds.y) * bounds.w + (r.x - bounds.x)], 0, r.w);
+                        }
+                        for (unsigned char pixel : dirty) result.uncovered[coalesce] += pixel;
+                    }
+                }
+                if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates) {
+                    tex->SetStatus(ImTextureStatus_OK);
+                }
+            }
+        }
+        for (float &us : result.regionsUs) us /= (float) std::max(result.updates, 1u);
+        uploadResults.push_back(result);
+        IM_DELETE(atlas);
+    }
+}
+
+void DemoBench::uploadImgui() {
+    if (ImGui::Button("check##upload")) uploadBench();
+    ImGui::SameLine();
+    ImGui::TextDisabled("regions the backend writes for the atlas updates of a zoom sweep");
+    if (uploadResults.empty()) return;
+    if (ImGui::BeginTable("upload", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("texture");
+        ImGui::TableSetupColumn("updates");
+        ImGui::TableSetupColumn("regions");
+        ImGui::TableSetupColumn("writes");
+        ImGui::TableSetupColumn("KB written");
+        ImGui::TableSetupColumn("us/update");
+        ImGui::TableSetupColumn("regions");
+        ImGui::TableHeadersRow();
+        for (const UploadResult &result : uploadResults) {
+            for (int coalesce = 0; coalesce < 2; ++coalesce) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                if (result.pageHeight) ImGui::Text("pages of %d rows", result.pageHeight);
+                else ImGui::TextUnformatted("not paged");
+                ImGui::TableNextColumn(); ImGui::Text("%u (%u rects)", result.updates, result.rects);
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(coalesce ? "coalesced" : "bounding box");
+                ImGui::TableNextColumn(); ImGui::Text("%u", result.writes[coalesce]);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f of %.1f", (double) result.uploadBytes[coalesce] / 1024.0, (double) result.requestedBytes / 1024.0);
+                ImGui::TableNextColumn(); ImGui::Text("%.2f", result.regionsUs[coalesce]);
+                ImGui::TableNextColumn();
+                if (result.uncovered[coalesce] || result.badRegions[coalesce]) ImGui::Text("%u UNCOVERED, %u BAD", result.uncovered[coalesce], result.badRegions[coalesce]);
+                else ImGui::TextUnformatted("cover the updates");
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void DemoBench::imgui(WGPU*) {
+    TRACE_ZONE("DemoBench::imgui");
+    char name[64];
+    snprintf(name, sizeof(name), "Bench %d", demoImguiIndex);
+    if (ImGui::Begin(name)) {
+        if (ImGui::CollapsingHeader("ID hashing", ImGuiTreeNodeFlags_DefaultOpen)) {
+            hashImgui();
+        }
+        if (ImGui::CollapsingHeader("ImGuiStorage")) {
+            storageImgui();
+        }
+        if (ImGui::CollapsingHeader("UTF-8")) {
+            utf8Imgui();
+        }
+        if (ImGui::CollapsingHeader("Text size")) {
+            textSizeImgui();
+        }
+        if (ImGui::CollapsingHeader("Glyph runs")) {
+            glyphRunImgui();
+        }
+        if (ImGui::CollapsingHeader("Polyline")) {
+            polylineImgui();
+        }
+        if (ImGui::CollapsingHeader("Polygon fill")) {
+            polygonFillImgui();
+        }
+        if (ImGui::CollapsingHeader("Font zoom")) {
+            fontZoomImgui();
+        }
+        if (ImGui::CollapsingHeader("Atlas budget")) {
+            evictionImgui();
+        }
+        if (ImGui::CollapsingHeader("Glyph loading")) {
+            glyphLoadImgui();
+        }
+        if (ImGui::CollapsingHeader("Atlas packer")) {
+            packerImgui();
+        }
+        if (ImGui::CollapsingHeader("Atlas pages")) {
+            pagesImgui();
+        }
+        if (ImGui::CollapsingHeader("Glyph rasterizer")) {
+            rasterImgui();
+        }
+        if (ImGui::CollapsingHeader("Distance fields")) {
+            sdfImgui();
+        }
+        if (ImGui::CollapsingHeader("Atlas build")) {
+            buildImgui();
+        }
+        if (ImGui::CollapsingHeader("Texture uploads")) {
+            uploadImgui();
+        }
+    }
+    ImGui::End();
+}
+
+ADD_DEMO_WINDOW(bench, createDemoBench)
@@ -1,5 +1,8 @@
 #include "demo.h"
+#include "profiler.h"
+#include "trace.h"
 #include <chrono>
+#include <cmath>
 #include <string>
 
 #ifdef MINIMAL_WGPU_IMGUI
@@ -19,7 +22,10 @@ alias vec4f = vec4<f32>;
 struct BufferInfo {
     size: vec2f,
     time: f32,
-    frame: u32
+    frame: u32,
+    jitter: vec2f,
+    accumulate: u32,
+    scale: f32
 };
 
 @group(0) @binding(0)
@@ -48,6 +54,10 @@ struct DemoFragment : public Demo {
         float height;
         float time;
         uint32_t frameNumber = 0;
+        float jitterX = 0.0f;       // sub-pixel sample offset, only used when accumulating
+        float jitterY = 0.0f;
+        uint32_t accumulate = 0;    // 1 -> shaders take one jittered sample instead of supersampling
+        float scale = 1.0f;         // internal render scale, width/height are already scaled
     };
 
 #ifdef MINIMAL_WGPU_IMGUI
@@ -56,6 +66,8 @@ struct DemoFragment : public Demo {
 
     void rebuild(WGPU*);
     void rebuildDone(WGPU*);
+    bool prepareOffscreen(WGPU*, uint32_t width, uint32_t height);
+    void releaseOffscreen();
 
     WGPUShaderModule fragmentModule = {};
 
@@ -69,8 +81,44 @@ struct DemoFragment : public Demo {
     char fragmentCode[65536];
     BufferInfo bufferInfo = {};
     std::chrono::high_resolution_clock::time_point startTime;
+    bool paused = false;
+    uint32_t outputWidth = 0;
+    uint32_t outputHeight = 0;
+
+    // Internal render scale: the fragment shader can run at a fraction of the output resolution into an
+    // offscreen RGBA16Float texture, an edge-aware upscale pass then writes the final view.
+    static constexpr float renderScales[] = {1.0f, 0.5f, 0.25f};
+    int renderScaleIndex = 0;
+
+    // Progressive accumulation: each frame renders a single jittered sample per pixel that gets
+    // blended (with a 1/n blend constant) into the offscreen texture, which is then presented.
+    // The running count is reset whenever the shader, the size or the time changes.
+    static constexpr uint32_t maxAccumulatedSamples = 256; // after this the image is considered converged
+    bool accumulate = false;
+    uint32_t accumulatedSamples = 0;
+    float accumulationTime = 0.0f;
+    WGPURenderPipeline offscreenPipeline = {};
+    WGPURenderPipeline presentPipeline = {};
+    WGPUBindGroupLayout presentBindGroupLayout = {};
+    WGPUBindGroup presentBindGroup = {};
+    WGPUTexture offscreenTexture = {};
+    WGPUTextureView offscreenView = {};
+    uint32_t offscreenWidth = 0;
+    uint32_t offscreenHeight = 0;
 };
 
+// Low discrepancy sequence used to jitter the accumulated samples
+static float halton(uint32_t index, uint32_t base) {
+    float f = 1.0f;
+    float result = 0.0f;
+    while (index > 0) {
+        f /= (float) base;
+        result += f * (float) (index % base);
+        index /= base;
+    }
+    return result;
+}
+
 std::unique_ptr<Demo> createDemoFragment() {
     return std::make_unique<DemoFragment>();
 }
@@ -163,6 +211,111 @@ void DemoFragment::init(WGPU *wgpu) {
 
     )");
 
+    // Present pipeline, upscales (or just copies at scale 1) the offscreen texture into the frame
+    WGPUBindGroupLayoutEntry presentLayoutEntries[2] = {
+        {
+            .nextInChain = nullptr,
+            .binding = 0,
+            .visibility = WGPUShaderStage_Fragment,
+            .texture = {
+                .nextInChain = nullptr,
+                .sampleType = WGPUTextureSampleType_Float,
+                .viewDimension = WGPUTextureViewDimension_2D,
+                .multisampled = false,
+            }
+        },
+        layoutEntry
+    };
+    presentLayoutEntries[1].binding = 1;
+
+    WGPUBindGroupLayoutDescriptor presentGroupLayoutDescriptor = {
+        .nextInChain = nullptr,
+        .label = WGPU_C_STR("Present BindGroupLayoutDescriptor"),
+        .entryCount = 2,
+        .entries = presentLayoutEntries,
+    };
+    presentBindGroupLayout = wgpuDeviceCreateBindGroupLayout(wgpu->device, &presentGroupLayoutDescriptor);
+
+    // Edge-aware (bilateral) upscale: a bilinear filter over the 4 closest low resolution texels, where each
+    // texel is also weighted by its luminance similarity to the nearest one, so edges stay sharp instead of
+    // being smeared. At scale 1 it degenerates into a plain copy.
+    WGPUShaderModule presentModule = createShaderModule(wgpu,
+    R"(
+        struct BufferInfo {
+            size: vec2<f32>,
+            time: f32,
+            frame: u32,
+            jitter: vec2<f32>,
+            accumulate: u32,
+            scale: f32
+        };
+
+        @group(0) @binding(0)
+        var scene: texture_2d<f32>;
+
+        @group(0) @binding(1)
+        var<uniform> info: BufferInfo;
+
+        fn luma(c: vec3<f32>) -> f32 {
+            return dot(c, vec3<f32>(0.299, 0.587, 0.114));
+        }
+
+        fn load(p: vec2<i32>) -> vec4<f32> {
+            let last = vec2<i32>(textureDimensions(scene)) - 1;
+            return textureLoad(scene, clamp(p, vec2<i32>(0), last), 0);
+        }
+
+        @fragment
+        fn fs_main(@builtin(position) fragCoord: vec4<f32>) -> @location(0) vec4<f32> {
+            // position in the low resolution texture (texel centers at integer coordinates)
+            let src = fragCoord.xy * info.scale - 0.5;
+            let base = vec2<i32>(floor(src));
+            let f = src - floor(src);
+            let reference = luma(load(vec2<i32>(round(src))).rgb);
+
+            var sum = vec4<f32>(0.0);
+            var weights = 0.0;
+            for (var j = 0; j < 2; j++) {
+                for (var i = 0; i < 2; i++) {
+                    let c = load(base + vec2<i32>(i, j));
+                    let spatial = select(1.0 - f.x, f.x, i == 1) * select(1.0 - f.y, f.y, j == 1);
+                    let range = exp(-16.0 * abs(luma(c.rgb) - reference));
+                    sum += c * spatial * range;
+                    weights += spatial * range;
+                }
+            }
+            return sum / max(weights, 1e-5);
+        }
+    )");
+
+    const WGPUPipelineLayoutDescriptor presentPipelineLayoutDescriptor = {
+        .label = WGPU_C_STR("present pipeline layout"),
+        .bindGroupLayoutCount = 1,
+        .bindGroupLayouts = &presentBindGroupLayout
+    };
+    const WGPUPipelineLayout presentPipelineLayout = wgpuDeviceCreatePipelineLayout(wgpu->device, &presentPipelineLayoutDescriptor);
+
+    const WGPUColorTargetState presentColorTargetStates = {
+        .format = wgpu->surfaceFormat, .writeMask = WGPUColorWriteMask_All
+    };
+    const WGPUFragmentState presentFragment = {
+        .module = presentModule,
+        .entryPoint = WGPU_C_STR("fs_main"),
+        .targetCount = 1,
+        .targets = &presentColorTargetStates,
+    };
+    const WGPURenderPipelineDescriptor presentPipelineDescriptor = {
+        .label = WGPU_C_STR("Present Offscreen"),
+        .layout = presentPipelineLayout,
+        .vertex = {.module = vertexShaderModule, .entryPoint = WGPU_C_STR("vs_main")},
+        .primitive = {.topology = WGPUPrimitiveTopology_TriangleList},
+        .multisample = {.count = 1, .mask = 0xFFFFFFFF},
+        .fragment = &presentFragment,
+    };
+    presentPipeline = wgpuDeviceCreateRenderPipeline(wgpu->device, &presentPipelineDescriptor);
+    wgpuShaderModuleRelease(presentModule);
+    wgpuPipelineLayoutRelease(presentPipelineLayout);
+
     #ifdef MINIMAL_WGPU_IMGUI
     replaceShaderCode(initialFragmentCode);
     #else
@@ -220,12 +373,78 @@ void DemoFragment::onError(WGPU *, const char *message) {
 }
 
 void DemoFragment::resize(WGPU *, uint32_t width, uint32_t height, float dpi) {
+    outputWidth = width;
+    outputHeight = height;
     bufferInfo.width = width;
     bufferInfo.height = height;
+    // the offscreen texture will be recreated with the new size on the next frame
+    releaseOffscreen();
+}
+
+bool DemoFragment::prepareOffscreen(WGPU *wgpu, uint32_t width, uint32_t height) {
+    if (!offscreenPipeline || width == 0 || height == 0) return false;
+    if (offscreenTexture && (width == offscreenWidth) && (height == offscreenHeight)) return true;
+    releaseOffscreen();
+
+    WGPUTextureDescriptor descriptor = {};
+    descriptor.label = WGPU_C_STR("Offscreen Texture");
+    descriptor.size.width = width;
+    descriptor.size.height = height;
+    descriptor.size.depthOrArrayLayers = 1;
+    descriptor.mipLevelCount = 1;
+    descriptor.sampleCount = 1;
+    descriptor.dimension = WGPUTextureDimension_2D;
+    descriptor.format = WGPUTextureFormat_RGBA16Float;
+    descriptor.usage = WGPUTextureUsage_RenderAttachment | WGPUTextureUsage_TextureBinding;
+    offscreenTexture = wgpuDeviceCreateTexture(wgpu->device, &descriptor);
+    offscreenView = wgpuTextureCreateView(offscreenTexture, nullptr);
+
+    WGPUBindGroupEntry entries[2] = {
+        {
+            .nextInChain = nullptr,
+            .binding = 0,
+            .textureView = offscreenView,
+        },
+        {
+            .nextInChain = nullptr,
+            .binding = 1,
+            .buffer = gpuBufferInfo,
+            .offset = 0,
+            .size = sizeof(BufferInfo),
+        }
+    };
+    WGPUBindGroupDescriptor groupDescriptor = {
+        .nextInChain = nullptr,
+        .label = WGPU_C_STR("Present Bind Group"),
+        .layout = presentBindGroupLayout,
+        .entryCount = 2,
+        .entries = entries,
+    };
+    presentBindGroup = wgpuDeviceCreateBindGroup(wgpu->device, &groupDescriptor);
+    offscreenWidth = width;
+    offscreenHeight = height;
+    accumulatedSamples = 0;
+    return true;
+}
+
+void DemoFragment::releaseOffscreen() {
+    if (presentBindGroup) wgpuBindGroupRelease(presentBindGroup);
+    if (offscreenView) wgpuTextureViewRelease(offscreenView);
+    if (offscreenTexture) wgpuTextureRelease(offscreenTexture);
+    presentBindGroup = {};
+    offscreenView = {};
+    offscreenTexture = {};
+    offscreenWidth = 0;
+    offscreenHeight = 0;
+    accumulatedSamples = 0;
 }
 
 void DemoFragment::cleanup(WGPU *) {
-    wgpuRenderPipelineRelease(pipeline);
+    releaseOffscreen();
+    if (pipeline) wgpuRenderPipelineRelease(pipeline);
+    if (offscreenPipeline) wgpuRenderPipelineRelease(offscreenPipeline);
+    wgpuRenderPipelineRelease(presentPipeline);
+    wgpuBindGroupLayoutRelease(presentBindGroupLayout);
     wgpuShaderModuleRelease(vertexShaderModule);
     wgpuBufferRelease(gpuBufferInfo);
     wgpuBindGroupRelease(bindGroup);
@@ -233,34 +452,92 @@ void DemoFragment::cleanup(WGPU *) {
 }
 
 void DemoFragment::frame(WGPU *wgpu, WGPUTextureView frame) {
+    TRACE_ZONE("DemoFragment::frame");
     if (pipeline) {
         // update the buffer info
         bufferInfo.frameNumber++;
-        bufferInfo.time = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime).count();
-        wgpuQueueWriteBuffer(wgpu->queue, gpuBufferInfo, 0, &bufferInfo, sizeof(bufferInfo));
+        if (!paused) {
+            bufferInfo.time = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime).count();
+        }
+
+        const float renderScale = renderScales[renderScaleIndex];
+        const uint32_t sceneWidth = std::max(1u, (uint32_t) std::ceil((float) outputWidth * renderScale));
+        const uint32_t sceneHeight = std::max(1u, (uint32_t) std::ceil((float) outputHeight * renderScale));
+        // Render directly into the frame unless we are accumulating or rendering at a lower resolution
+        const bool offscreen = (accumulate || (renderScale != 1.0f)) && prepareOffscreen(wgpu, sceneWidth, sceneHeight);
+        const bool accumulating = accumulate && offscreen;
+        if (accumulating && (bufferInfo.time != accumulationTime)) {
+            // the image changed, start over
+            accumulationTime = bufferInfo.time;
+            accumulatedSamples = 0;
+        }
+        // Once converged there is nothing left to render, just keep presenting the accumulated image
+        const bool renderScene = !accumulating || (accumulatedSamples < maxAccumulatedSamples);
+
+        if (renderScene) {
+            bufferInfo.width = (float) (offscreen ? sceneWidth : outputWidth);
+            bufferInfo.height = (float) (offscreen ? sceneHeight : outputHeight);
+            bufferInfo.scale = offscreen ? renderScale : 1.0f;
+            bufferInfo.accumulate = accumulating ? 1 : 0;
+            bufferInfo.jitterX = accumulating ? halton(accumulatedSamples + 1, 2) - 0.5f : 0.0f;
+            bufferInfo.jitterY = accumulating ? halton(accumulatedSamples + 1, 3) - 0.5f : 0.0f;
+            wgpuQueueWriteBuffer(wgpu->queue, gpuBufferInfo, 0, &bufferInfo, sizeof(bufferInfo));
+        }
 
         // Create the command encoder to do the render pass
         WGPUCommandEncoderDescriptor commandEncoderDescriptor = {.label = WGPU_C_STR("Frame")};
         WGPUCommandEncoder commandEncoder = wgpuDeviceCreateCommandEncoder(wgpu->device, &commandEncoderDescriptor);
 
-        WGPURenderPassColorAttachment renderPassColorAttachment{
-            .view = frame,
-            .depthSlice = WGPU_DEPTH_SLICE_UNDEFINED,
-            .loadOp = WGPULoadOp_Clear,
-            .storeOp = WGPUStoreOp_Store,
-        };
-        WGPURenderPassDescriptor renderPass = {
-            .label = WGPU_C_STR("Main Pass"),
-            .colorAttachmentCount = 1,
-            .colorAttachments = &renderPassColorAttachment,
-        };
+        if (renderScene) {
+            WGPURenderPassColorAttachment renderPassColorAttachment{
+                .view = offscreen ? offscreenView : frame,
+                .depthSlice = WGPU_DEPTH_SLICE_UNDEFINED,
+                .loadOp = accumulating ? WGPULoadOp_Load : WGPULoadOp_Clear,
+                .storeOp = WGPUStoreOp_Store,
+            };
+            WGPURenderPassDescriptor renderPass = {
+                .label = WGPU_C_STR("Main Pass"),
+                .colorAttachmentCount = 1,
+                .colorAttachments = &renderPassColorAttachment,
+            };
+
+            WGPURenderPassEncoder renderPassEncoder = wgpu->profiler->beginRenderPass(commandEncoder, &renderPass);
+            if (offscreen) {
+                // running average: accumulation = accumulation * (1 - 1/n) + sample * 1/n
+                // (without accumulation n is always 1, which just replaces the previous content)
+                const double weight = accumulating ? 1.0 / ++accumulatedSamples : 1.0;
+                const WGPUColor blendConstant = {weight, weight, weight, weight};
+                wgpuRenderPassEncoderSetPipeline(renderPassEncoder, offscreenPipeline);
+                wgpuRenderPassEncoderSetBlendConstant(renderPassEncoder, &blendConstant);
+            } else {
+                wgpuRenderPassEncoderSetPipeline(renderPassEncoder, pipeline);
+            }
+            wgpuRenderPassEncoderSetBindGroup(renderPassEncoder,0, bindGroup, 0, nullptr);
+            wgpuRenderPassEncoderDraw(renderPassEncoder, 3, 1, 0, 0);
+            wgpu->profiler->endRenderPass(renderPassEncoder);
+            wgpuRenderPassEncoderRelease(renderPassEncoder);
+        }
 
-        WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(commandEncoder, &renderPass);
-        wgpuRenderPassEncoderSetPipeline(renderPassEncoder, pipeline);
-        wgpuRenderPassEncoderSetBindGroup(renderPassEncoder,0, bindGroup, 0, nullptr);
-        wgpuRenderPassEncoderDraw(renderPassEncoder, 3, 1, 0, 0);
-        wgpuRenderPassEncoderEnd(renderPassEncoder);
-        wgpuRenderPassEncoderRelease(renderPassEncoder);
+        if (offscreen) {
+            WGPURenderPassColorAttachment presentColorAttachment{
+                .view = frame,
+                .depthSlice = WGPU_DEPTH_SLICE_UNDEFINED,
+                .loadOp = WGPULoadOp_Clear,
+                .storeOp = WGPUStoreOp_Store,
+            };
+            WGPURenderPassDescriptor presentPass = {
+                .label = WGPU_C_STR("Upscale Pass"),
+                .colorAttachmentCount = 1,
+                .colorAttachments = &presentColorAttachment,
+            };
+
+            WGPURenderPassEncoder presentPassEncoder = wgpu->profiler->beginRenderPass(commandEncoder, &presentPass);
+            wgpuRenderPassEncoderSetPipeline(presentPassEncoder, presentPipeline);
+            wgpuRenderPassEncoderSetBindGroup(presentPassEncoder, 0, presentBindGroup, 0, nullptr);
+            wgpuRenderPassEncoderDraw(presentPassEncoder, 3, 1, 0, 0);
+            wgpu->profiler->endRenderPass(presentPassEncoder);
+            wgpuRenderPassEncoderRelease(presentPassEncoder);
+        }
 
         WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(commandEncoder, nullptr);
         wgpuQueueSubmit(wgpu->queue, 1, &commandBuffer);
@@ -281,6 +558,9 @@ void DemoFragment::frame(WGPU *wgpu, WGPUTextureView frame) {
         if (pipeline) {
             wgpuRenderPipelineRelease(pipeline);
         }
+        if (offscreenPipeline) {
+            wgpuRenderPipelineRelease(offscreenPipeline);
+        }
 
         const WGPUPipelineLayoutDescriptor pipelineLayoutDescriptor = {
             .label = WGPU_C_STR("pipeline layout"),
@@ -311,6 +591,32 @@ void DemoFragment::frame(WGPU *wgpu, WGPUTextureView frame) {
         };
 
         pipeline = wgpuDeviceCreateRenderPipeline(wgpu->device, &pipelineDescriptor);
+
+        // Same shader, rendering into the accumulation texture blending with the running average
+        const WGPUBlendComponent accumulateBlendComponent = {
+            .operation = WGPUBlendOperation_Add,
+            .srcFactor = WGPUBlendFactor_Constant,
+            .dstFactor = WGPUBlendFactor_OneMinusConstant,
+        };
+        const WGPUBlendState accumulateBlend = {
+            .color = accumulateBlendComponent,
+            .alpha = accumulateBlendComponent,
+        };
+        const WGPUColorTargetState accumulateColorTargetStates = {
+            .format = WGPUTextureFormat_RGBA16Float, .blend = &accumulateBlend, .writeMask = WGPUColorWriteMask_All
+        };
+        const WGPUFragmentState accumulateFragment = {
+            .module = fragmentModule,
+            .entryPoint = WGPU_C_STR("fs_main"),
+            .targetCount = 1,
+            .targets = &accumulateColorTargetStates,
+        };
+        WGPURenderPipelineDescriptor offscreenPipelineDescriptor = pipelineDescriptor;
+        offscreenPipelineDescriptor.label = WGPU_C_STR("Render Fragment (accumulate)");
+        offscreenPipelineDescriptor.fragment = &accumulateFragment;
+        offscreenPipeline = wgpuDeviceCreateRenderPipeline(wgpu->device, &offscreenPipelineDescriptor);
+        accumulatedSamples = 0;
+
         wgpuShaderModuleRelease(fragmentModule);
         wgpuPipelineLayoutRelease(pipelineLayout);
         fragmentModule = {};
@@ -320,6 +626,7 @@ void DemoFragment::frame(WGPU *wgpu, WGPUTextureView frame) {
 
 #ifdef MINIMAL_WGPU_IMGUI
 void DemoFragment::imgui(WGPU *wgpu) {
+    TRACE_ZONE("DemoFragment::imgui");
     char name[64];
     snprintf(name, sizeof(name), "Demo %d", demoImguiIndex);
     if (ImGui::Begin(name)) {
@@ -339,6 +646,25 @@ void DemoFragment::imgui(WGPU *wgpu) {
             replaceShaderCode(rickShader);
             rebuild(wgpu);
         }
+        ImGui::Checkbox("accumulate", &accumulate);
+        ImGui::SameLine();
+        if (ImGui::Checkbox("pause", &paused) && !paused) {
+            // resume the animation from where it was paused
+            startTime = std::chrono::high_resolution_clock::now() -
+                std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::duration<float>(bufferInfo.time));
+        }
+        if (accumulate) {
+            ImGui::SameLine();
+            ImGui::Text("samples: %u/%u", accumulatedSamples, maxAccumulatedSamples);
+        }
+        ImGui::SetNextItemWidth(96);
+        ImGui::Combo("render scale", &renderScaleIndex, "1/1\0" "1/2\0" "1/4\0");
+        if (wgpu->profiler->hasGpuTimestamps()) {
+            const Profiler::PassTiming *mainPass = wgpu->profiler->find("Main Pass");
+            const Profiler::PassTiming *upscalePass = wgpu->profiler->find("Upscale Pass");
+            ImGui::SameLine();
+            ImGui::Text("GPU main: %.3f ms, upscale: %.3f ms", mainPass ? mainPass->gpuMs : 0.0f, upscalePass ? upscalePass->gpuMs : 0.0f);
+        }
         const float width = ImGui::GetContentRegionAvail().x;
         ImGui::InputTextMultiline("###FragmentCode", fragmentCode, sizeof(fragmentCode), {width, 256});
         if (!lastError.empty()) {
@@ -361,7 +687,10 @@ alias vec4f = vec4<f32>;
 struct BufferInfo {
     size: vec2f,
     time: f32,
-    frame: u32
+    frame: u32,
+    jitter: vec2f,
+    accumulate: u32,
+    scale: f32
 };
 
 @group(0) @binding(0)
@@ -426,6 +755,10 @@ fn supersample(pos: vec2f, zoom: f32) -> vec3f {
    var px = .25/zoom;
    var py = .25/zoom;
    var posz = pos/zoom;
+   if (info.accumulate != 0u) {
+      // Progressive mode: one jittered sample per frame, the host averages them over time
+      return color(posz + info.jitter/zoom);
+   }
    var c =
       color(posz + vec2f(-px,-py)) +
       color(posz + vec2f(-px, py)) +
@@ -438,7 +771,7 @@ fn supersample(pos: vec2f, zoom: f32) -> vec3f {
 fn fs_main(@builtin(position) fragCoord: vec4f) -> @location(0) vec4f {
   var px = (fragCoord.x - info.size.x/2);
   var py = -1.0*(fragCoord.y - info.size.y/2); // inverted Y compared to original GLSL code
-  var zoom = 300.0;
+  var zoom = 300.0 * info.scale; // zoom is in pixels, follow the internal render scale
   return vec4f(supersample(vec2f(px,py), zoom), 1.0);
 }
 )";
@@ -453,7 +786,10 @@ alias vec2i = vec2<i32>;
 struct BufferInfo {
     size: vec2f,
     time: f32,
-    frame: u32
+    frame: u32,
+    jitter: vec2f,
+    accumulate: u32,
+    scale: f32
 };
 
 @group(0) @binding(0)
@@ -697,6 +1033,10 @@ fn supersample(pos: vec2f, zoom: f32) -> vec3f {
    var px = .25/zoom;
    var py = .25/zoom;
    var posz = pos/zoom;
+   if (info.accumulate != 0u) {
+      // Progressive mode: one jittered sample per frame, the host averages them over time
+      return color(posz + info.jitter/zoom);
+   }
    var c =
       color(posz + vec2f(-px,-py)) +
       color(posz + vec2f(-px, py)) +
@@ -709,7 +1049,7 @@ fn supersample(pos: vec2f, zoom: f32) -> vec3f {
 fn fs_main(@builtin(position) fragCoord: vec4f) -> @location(0) vec4f {
   var px = (fragCoord.x - info.size.x/2);
   var py = -1.0*(fragCoord.y - info.size.y/2); // inverted Y compared to original GLSL code
-  var zoom = 250.0;
+  var zoom = 250.0 * info.scale; // zoom is in pixels, follow the internal render scale
   return vec4f(supersample(vec2f(px,py), zoom), 1.0);
 }
 )";
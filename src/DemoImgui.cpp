@@ -1,9 +1,16 @@
 #include <vector>
 #include "demo.h"
+#include "allocator.h"
+#include "perf.h"
+#include "profiler.h"
+#include "trace.h"
 #include "sokol_app.h"
 
 #ifndef __EMSCRIPTEN__
 #define IMGUI_IMPL_WEBGPU_BACKEND_WGPU
+#define WGPU_C_STR(value) { value, WGPU_STRLEN }
+#else
+#define WGPU_C_STR(value) value
 #endif
 
 #include <iostream>
@@ -41,9 +48,17 @@ struct DemoImgui : public Demo {
         }
     }
 
+    void recordFrameStats(WGPU*, const float (&phaseMs)[PerfPhase_Count]);
+
     DemoWindow *currentDemoWindow = nullptr;
 
     std::vector<DemoWindow> windows;
+    PerfOverlay perfOverlay;
+    uint64_t lastUploadBytes = 0;
+    uint64_t lastTextureUploadBytes = 0;
+    uint64_t lastTextureUpdateBytes = 0;
+    uint64_t lastTextureWrites = 0;
+    std::chrono::high_resolution_clock::time_point initTime;
 };
 
 static DemoImgui *imgui = nullptr;
@@ -57,12 +72,34 @@ std::unique_ptr<Demo> createDemoImgui() {
 
 
 void DemoImgui::init(WGPU *wgpu) {
+    initTime = std::chrono::high_resolution_clock::now();
+    // Must be set before creating the context, everything allocated by imgui goes through the host allocator
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void*) { return allocator::alloc(size); },
+        [](void *ptr, void*) { allocator::free(ptr); });
     ImGui::CreateContext();
+    // the font atlas only holds coverage, R8Unorm is a quarter of the memory and upload bandwidth of RGBA8
+    ImGui::GetIO().Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+#if defined(IMGUI_ENABLE_GLYPH_DISK_CACHE) && !defined(__EMSCRIPTEN__)
+    // glyphs rasterized by previous runs are copied into the atlas instead (the web build has no persistent files)
+    ImGui::GetIO().Fonts->GlyphCacheFilename = "imgui_glyphs.bin";
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    // one distance field bake of the default font can serve every size and DPI scale, off by default as it blurs
+    // the pixel font (toggled in the perf overlay)
+    ImFontConfig fontConfig;
+    fontConfig.Flags |= ImFontFlags_DistanceField;
+    ImGui::GetIO().Fonts->AddFontDefault(&fontConfig);
+    ImGui::GetIO().Fonts->Builder->Sdf.Disabled = true;
+#endif
     ImGui_ImplWGPU_InitInfo init_info = {};
     init_info.Device = wgpu->device;
     init_info.NumFramesInFlight = 3;
     init_info.RenderTargetFormat = wgpu->surfaceFormat;
     init_info.DepthStencilFormat = WGPUTextureFormat_Undefined;
+    init_info.CompactVertices = true;
+    // staging rows of partial texture uploads, released by allocator::beginFrame
+    init_info.TransientAllocFunc = [](size_t size, void*) { return allocator::frameAlloc(size); };
     ImGui_ImplWGPU_Init(&init_info);
 
     WGPU wgpuCopy = *wgpu;
@@ -81,6 +118,10 @@ void DemoImgui::cleanup(WGPU *wgpu) {
         w.window->cleanup(wgpu);
     }
     currentDemoWindow = nullptr;
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    // the context is never destroyed, which would save it too
+    ImFontAtlasGlyphCacheSave(ImGui::GetIO().Fonts);
+#endif
     ImGui_ImplWGPU_Shutdown();
 }
 
@@ -368,6 +409,7 @@ void Demo::imguiShowFrame(WGPU *wgpu, ImVec2 size) {
 
 
 void DemoImgui::imgui(WGPU *wgpu) {
+    TRACE_ZONE("DemoImgui::imgui");
     WGPU wgpuCopy = *wgpu;
     wgpuCopy.surfaceFormat = WGPUTextureFormat_RGBA8Unorm;
 
@@ -382,8 +424,13 @@ void DemoImgui::imgui(WGPU *wgpu) {
                 windows.push_back(std::move(window));
             }
         }
+        ImGui::Separator();
+        ImGui::Checkbox("Performance (F1)", &perfOverlay.open);
+        ImGui::Checkbox("Compact vertices", &ImGui_ImplWGPU_GetBackendData()->initInfo.CompactVertices);
+        ImGui::Checkbox("Coalesce texture uploads", &ImGui_ImplWGPU_GetBackendData()->initInfo.CoalesceTextureUploads);
         ImGui::End();
     }
+    perfOverlay.imgui(wgpu);
 
     for(auto &&w: windows) {
         currentDemoWindow = &w;
@@ -399,10 +446,24 @@ void DemoImgui::imgui(WGPU *wgpu) {
 
 
 void DemoImgui::frame(WGPU *wgpu, WGPUTextureView frame) {
-    ImGui_ImplWGPU_NewFrame();
-    ImGui::NewFrame();
-    imgui(wgpu);
-    ImGui::Render();
+    TRACE_ZONE("DemoImgui::frame");
+    float phaseMs[PerfPhase_Count] = {};
+    {
+        PerfScope scope(phaseMs[PerfPhase_NewFrame]);
+        TRACE_ZONE("ImGui::NewFrame");
+        ImGui_ImplWGPU_NewFrame();
+        ImGui::NewFrame();
+    }
+    {
+        PerfScope scope(phaseMs[PerfPhase_Demos]);
+        imgui(wgpu);
+    }
+    {
+        PerfScope scope(phaseMs[PerfPhase_Render]);
+        TRACE_ZONE("ImGui::Render");
+        ImGui::Render();
+    }
+    PerfScope renderDrawDataScope(phaseMs[PerfPhase_RenderDrawData]);
 
     WGPURenderPassColorAttachment color_attachments = {};
     color_attachments.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
@@ -413,6 +474,7 @@ void DemoImgui::frame(WGPU *wgpu, WGPUTextureView frame) {
     color_attachments.view = frame;
 
     WGPURenderPassDescriptor render_pass_desc = {};
+    render_pass_desc.label = WGPU_C_STR("ImGui Pass");
     render_pass_desc.colorAttachmentCount = 1;
     render_pass_desc.colorAttachments = &color_attachments;
     render_pass_desc.depthStencilAttachment = nullptr;
@@ -420,9 +482,23 @@ void DemoImgui::frame(WGPU *wgpu, WGPUTextureView frame) {
     WGPUCommandEncoderDescriptor enc_desc = {};
     WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(wgpu->device, &enc_desc);
 
-    WGPURenderPassEncoder pass = wgpuCommandEncoderBeginRenderPass(encoder, &render_pass_desc);
-    ImGui_ImplWGPU_RenderDrawData(ImGui::GetDrawData(), pass);
-    wgpuRenderPassEncoderEnd(pass);
+    ImDrawData *drawData = ImGui::GetDrawData();
+    if (drawData->Textures) {
+        // RenderDrawData would do this too, done here to have the uploads in their own zone
+        TRACE_ZONE("Texture Upload");
+        for (ImTextureData *tex : *drawData->Textures) {
+            if (tex->Status != ImTextureStatus_OK) {
+                ImGui_ImplWGPU_UpdateTexture(tex);
+            }
+        }
+    }
+
+    WGPURenderPassEncoder pass = wgpu->profiler->beginRenderPass(encoder, &render_pass_desc);
+    {
+        TRACE_ZONE("ImGui_ImplWGPU_RenderDrawData");
+        ImGui_ImplWGPU_RenderDrawData(drawData, pass);
+    }
+    wgpu->profiler->endRenderPass(pass);
     wgpuRenderPassEncoderRelease(pass);
 
     WGPUCommandBufferDescriptor cmd_buffer_desc = {};
@@ -432,6 +508,71 @@ void DemoImgui::frame(WGPU *wgpu, WGPUTextureView frame) {
 
     wgpuCommandBufferRelease(cmd_buffer);
     wgpuCommandEncoderRelease(encoder);
+    renderDrawDataScope.stop();
+
+    recordFrameStats(wgpu, phaseMs);
+}
+
+void DemoImgui::recordFrameStats(WGPU *wgpu, const float (&phaseMs)[PerfPhase_Count]) {
+    FrameStats stats = {};
+    const ImGuiIO &io = ImGui::GetIO();
+    stats.frameMs = io.DeltaTime * 1000.0f;
+    stats.cpuMs = wgpu->profiler->frame().cpuMs;
+    std::copy(std::begin(phaseMs), std::end(phaseMs), stats.phaseMs);
+    stats.gpuMs = wgpu->profiler->frame().gpuMs;
+    const auto &passes = wgpu->profiler->passes();
+    for (size_t i = 0; i < passes.size() && i < FrameStats::maxPasses; ++i) {
+        stats.passGpuMs[i] = passes[i].gpuMs;
+    }
+
+    const ImDrawData *drawData = ImGui::GetDrawData();
+    for (const ImDrawList *drawList : drawData->CmdLists) {
+        stats.drawCalls += drawList->CmdBuffer.Size;
+    }
+    stats.vertices = drawData->TotalVtxCount;
+    stats.indices = drawData->TotalIdxCount;
+
+    const uint64_t uploadBytes = ImGui_ImplWGPU_GetBackendData()->uploadBytes;
+    stats.uploadBytes = uploadBytes - lastUploadBytes;
+    lastUploadBytes = uploadBytes;
+    stats.compactVertices = (uint32_t) ImGui_ImplWGPU_GetBackendData()->compactVtxCount;
+    const ImGui_ImplWGPU_Data *backendData = ImGui_ImplWGPU_GetBackendData();
+    stats.textureUploadBytes = backendData->textureUploadBytes - lastTextureUploadBytes;
+    stats.textureUpdateBytes = backendData->textureUpdateBytes - lastTextureUpdateBytes;
+    stats.textureWrites = (uint32_t) (backendData->textureWriteCount - lastTextureWrites);
+    lastTextureUploadBytes = backendData->textureUploadBytes;
+    lastTextureUpdateBytes = backendData->textureUpdateBytes;
+    lastTextureWrites = backendData->textureWriteCount;
+    const allocator::Stats &allocations = allocator::lastFrame();
+    stats.allocations = (uint32_t) allocations.allocations;
+    stats.allocationBytes = allocations.bytes;
+    stats.systemAllocations = (uint32_t) allocations.systemAllocations;
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    if (const ImFontAtlasBuilder *builder = io.Fonts->Builder) {
+        stats.glyphRunHits = (uint32_t) builder->GlyphRuns.LastFrameHits;
+        stats.glyphRunMisses = (uint32_t) builder->GlyphRuns.LastFrameMisses;
+        stats.glyphRunBytes = (uint32_t) builder->GlyphRuns.GetResidentBytes();
+    }
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    if (const ImFontAtlasBuilder *builder = io.Fonts->Builder) {
+        stats.textSizeHits = (uint32_t) builder->TextSizes.LastFrameHits;
+        stats.textSizeMisses = (uint32_t) builder->TextSizes.LastFrameMisses;
+        stats.textSizeBytes = (uint32_t) builder->TextSizes.GetResidentBytes();
+    }
+#endif
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    if (const ImFontAtlasBuilder *builder = io.Fonts->Builder) {
+        stats.asyncGlyphRequests = (uint32_t) builder->AsyncGlyphs.LastFrameRequests;
+        stats.asyncGlyphsApplied = (uint32_t) builder->AsyncGlyphs.LastFrameApplied;
+        stats.asyncGlyphsPending = (uint32_t) builder->AsyncGlyphs.PendingCount;
+        stats.asyncGlyphMs = builder->AsyncGlyphs.LastFrameMs;
+    }
+#endif
+    if (perfOverlay.firstFrameMs == 0.0f && stats.asyncGlyphsPending == 0) {
+        perfOverlay.firstFrameMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - initTime).count();
+    }
+    perfOverlay.record(stats);
 }
 
 ADD_DEMO_WINDOW(imgui, createDemoImgui)
@@ -1,4 +1,6 @@
 #include "demo.h"
+#include "profiler.h"
+#include "trace.h"
 
 #ifdef MINIMAL_WGPU_IMGUI
 #include "imgui.h"
@@ -96,6 +98,7 @@ void DemoTriangle::cleanup(WGPU *) {
 }
 
 void DemoTriangle::frame(WGPU *wgpu, WGPUTextureView frame) {
+    TRACE_ZONE("DemoTriangle::frame");
     WGPUCommandEncoderDescriptor commandEncoderDescriptor = {.label = WGPU_C_STR("Frame")};
     WGPUCommandEncoder commandEncoder = wgpuDeviceCreateCommandEncoder(wgpu->device, &commandEncoderDescriptor);
 
@@ -113,10 +116,10 @@ void DemoTriangle::frame(WGPU *wgpu, WGPUTextureView frame) {
             .colorAttachments = &renderPassColorAttachment,
     };
 
-    WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(commandEncoder, &renderPass);
+    WGPURenderPassEncoder renderPassEncoder = wgpu->profiler->beginRenderPass(commandEncoder, &renderPass);
     wgpuRenderPassEncoderSetPipeline(renderPassEncoder, pipeline);
     wgpuRenderPassEncoderDraw(renderPassEncoder, 3, 1, 0, 0);
-    wgpuRenderPassEncoderEnd(renderPassEncoder);
+    wgpu->profiler->endRenderPass(renderPassEncoder);
     wgpuRenderPassEncoderRelease(renderPassEncoder);
 
     WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(commandEncoder, nullptr);
@@ -130,6 +133,7 @@ void DemoTriangle::frame(WGPU *wgpu, WGPUTextureView frame) {
 
 #ifdef MINIMAL_WGPU_IMGUI
 void DemoTriangle::imgui(WGPU *wgpu) {
+    TRACE_ZONE("DemoTriangle::imgui");
     char name[64];
     snprintf(name, sizeof(name), "Demo %d", demoImguiIndex);
     if (ImGui::Begin(name)) {
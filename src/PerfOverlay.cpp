@@ -0,0 +1,276 @@
+#include "demo.h"
+#include "allocator.h"
+#include "perf.h"
+#include "profiler.h"
+#if defined(IMGUI_ENABLE_GLYPH_RUN_CACHE) || defined(IMGUI_ENABLE_TEXT_SIZE_CACHE) || defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_PAGED_ATLAS) || defined(IMGUI_ENABLE_ATLAS_BUDGET) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE) || defined(IMGUI_ENABLE_SDF_FONTS) || defined(IMGUI_ENABLE_SHELF_PACKER) || defined(IMGUI_ENABLE_STB_TRUETYPE_SIMD)
+#include <imgui_internal.h>
+#endif
+
+static const char *phaseNames[PerfPhase_Count] = {
+    "NewFrame",
+    "Demos",
+    "Render",
+    "RenderDrawData",
+};
+
+namespace {
+    // Adapts the ring to the ImGui::PlotLines/PlotHistogram getter
+    struct PlotSource {
+        const PerfRing<FrameStats, PerfOverlay::historySize> *history;
+        float (*value)(const FrameStats&, int arg);
+        int arg = 0;
+
+        static float get(void *data, int i) {
+            auto source = static_cast<const PlotSource*>(data);
+            return source->value(source->history->at(i), source->arg);
+        }
+    };
+}
+
+void PerfOverlay::imgui(WGPU *wgpu) {
+    if (ImGui::IsKeyPressed(ImGuiKey_F1, false)) {
+        open = !open;
+    }
+    if (!open) return;
+
+    PerfScope overlayScope(overlayMs);
+    const uint32_t count = history.size();
+    if (!ImGui::Begin("Performance (F1)", &open) || count == 0) {
+        ImGui::End();
+        return;
+    }
+
+    const FrameStats &last = history.latest();
+    const float plotWidth = ImGui::GetContentRegionAvail().x;
+
+    auto plot = [&](const char *label, float (*value)(const FrameStats&, int), int arg, const char *format, float scale, bool histogram) {
+        PlotSource source = {&history, value, arg};
+        float average = 0.0f;
+        float maximum = 0.0f;
+        for (uint32_t i = 0; i < count; ++i) {
+            const float v = PlotSource::get(&source, (int) i);
+            average += v;
+            maximum = std::max(maximum, v);
+        }
+        average /= (float) count;
+        char overlay[64];
+        snprintf(overlay, sizeof(overlay), format, PlotSource::get(&source, (int) count - 1) * scale, average * scale, maximum * scale);
+        const ImVec2 size = {plotWidth, 40.0f};
+        if (histogram) {
+            ImGui::PlotHistogram(label, &PlotSource::get, &source, (int) count, 0, overlay, 0.0f, maximum * 1.1f, size);
+        } else {
+            ImGui::PlotLines(label, &PlotSource::get, &source, (int) count, 0, overlay, 0.0f, maximum * 1.1f, size);
+        }
+    };
+
+    ImGui::Text("%.2f ms (%.1f fps), cpu %.2f ms, gpu %.2f ms", last.frameMs, last.frameMs > 0.0f ? 1000.0f / last.frameMs : 0.0f, last.cpuMs, last.gpuMs);
+    plot("##frame", [](const FrameStats &s, int) { return s.frameMs; }, 0, "frame %.2f ms (avg %.2f, max %.2f)", 1.0f, false);
+    plot("##cpu", [](const FrameStats &s, int) { return s.cpuMs; }, 0, "cpu %.2f ms (avg %.2f, max %.2f)", 1.0f, false);
+
+    if (ImGui::CollapsingHeader("Host phases", ImGuiTreeNodeFlags_DefaultOpen)) {
+        for (int phase = 0; phase < PerfPhase_Count; ++phase) {
+            char format[64];
+            snprintf(format, sizeof(format), "%s %%.3f ms (avg %%.3f, max %%.3f)", phaseNames[phase]);
+            ImGui::PushID(phase);
+            plot("##phase", [](const FrameStats &s, int p) { return s.phaseMs[p]; }, phase, format, 1.0f, false);
+            ImGui::PopID();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("GPU passes", ImGuiTreeNodeFlags_DefaultOpen)) {
+        if (!wgpu->profiler->hasGpuTimestamps()) {
+            ImGui::TextDisabled("timestamp queries not available");
+        }
+        const auto &passes = wgpu->profiler->passes();
+        for (int pass = 0; pass < (int) passes.size() && pass < FrameStats::maxPasses; ++pass) {
+            char format[96];
+            snprintf(format, sizeof(format), "%s x%u %%.3f ms (avg %%.3f, max %%.3f)", passes[pass].label.c_str(), passes[pass].count);
+            ImGui::PushID(pass);
+            plot("##pass", [](const FrameStats &s, int p) { return s.passGpuMs[p]; }, pass, format, 1.0f, false);
+            ImGui::PopID();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Draw data", ImGuiTreeNodeFlags_DefaultOpen)) {
+        plot("##drawCalls", [](const FrameStats &s, int) { return (float) s.drawCalls; }, 0, "draw calls %.0f (avg %.0f, max %.0f)", 1.0f, true);
+        plot("##vertices", [](const FrameStats &s, int) { return (float) s.vertices; }, 0, "vertices %.0f (avg %.0f, max %.0f)", 1.0f, true);
+        plot("##upload", [](const FrameStats &s, int) { return (float) s.uploadBytes; }, 0, "upload %.1f KB (avg %.1f, max %.1f)", 1.0f / 1024.0f, true);
+        ImGui::Text("%u of %u vertices compact (12 bytes)", last.compactVertices, last.vertices);
+        plot("##textureUpload", [](const FrameStats &s, int) { return (float) s.textureUploadBytes; }, 0, "texture upload %.1f KB (avg %.1f, max %.1f)", 1.0f / 1024.0f, true);
+        ImGui::Text("%u texture writes, %.1f KB of %.1f KB requested", last.textureWrites, (double) last.textureUploadBytes / 1024.0, (double) last.textureUpdateBytes / 1024.0);
+    }
+
+    if (ImGui::CollapsingHeader("Allocations", ImGuiTreeNodeFlags_DefaultOpen)) {
+        plot("##allocations", [](const FrameStats &s, int) { return (float) s.allocations; }, 0, "allocations %.0f (avg %.0f, max %.0f)", 1.0f, false);
+        plot("##allocationBytes", [](const FrameStats &s, int) { return (float) s.allocationBytes; }, 0, "allocated %.1f KB (avg %.1f, max %.1f)", 1.0f / 1024.0f, true);
+        plot("##systemAllocations", [](const FrameStats &s, int) { return (float) s.systemAllocations; }, 0, "malloc %.0f (avg %.0f, max %.0f)", 1.0f, true);
+        const allocator::Stats total = allocator::total();
+        ImGui::Text("total: %llu allocations, %llu frees (%llu cross-thread), %llu malloc, pools %.1f KB",
+                    (unsigned long long) total.allocations, (unsigned long long) total.frees, (unsigned long long) total.remoteFrees,
+                    (unsigned long long) total.systemAllocations, (double) allocator::pooledBytes() / 1024.0);
+        ImGui::Text("frame arena: %.1f KB last frame, %.1f KB total",
+                    (double) allocator::lastFrame().arenaBytes / 1024.0, (double) total.arenaBytes / 1024.0);
+    }
+
+#if defined(IMGUI_ENABLE_GLYPH_RUN_CACHE) || defined(IMGUI_ENABLE_TEXT_SIZE_CACHE) || defined(IMGUI_ENABLE_ASYNC_GLYPHS) || defined(IMGUI_ENABLE_PAGED_ATLAS) || defined(IMGUI_ENABLE_ATLAS_BUDGET) || defined(IMGUI_ENABLE_GLYPH_DISK_CACHE) || defined(IMGUI_ENABLE_SDF_FONTS) || defined(IMGUI_ENABLE_SHELF_PACKER) || defined(IMGUI_ENABLE_STB_TRUETYPE_SIMD)
+    // the runtime switches of the font extensions, for A/B comparisons: on is the extension, off is what it replaces
+    if (ImGui::CollapsingHeader("Features", ImGuiTreeNodeFlags_DefaultOpen) && ImGui::BeginTable("features", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit)) {
+        ImGui::TableSetupColumn("feature");
+        ImGui::TableSetupColumn("off");
+        ImGui::TableHeadersRow();
+        auto feature = [](const char *name, bool enabled, const char *fallback) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::Checkbox(name, &enabled);
+            ImGui::TableNextColumn();
+            ImGui::TextDisabled("%s", fallback);
+            return enabled;
+        };
+        ImFontAtlasBuilder *builder = ImGui::GetIO().Fonts->Builder;
+        if (builder) {
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+            builder->GlyphRuns.Disabled = !feature("glyph run cache", !builder->GlyphRuns.Disabled, "RenderText() every frame");
+#endif
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+            builder->TextSizes.Disabled = !feature("text size cache", !builder->TextSizes.Disabled, "CalcTextSizeA() every call");
+#endif
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+            builder->AsyncGlyphs.Disabled = !feature("async glyphs", !builder->AsyncGlyphs.Disabled, "rasterize when the glyph is requested");
+            builder->AsyncGlyphs.ParallelBuildDisabled = !feature("parallel Build()", !builder->AsyncGlyphs.ParallelBuildDisabled, "preload glyph ranges serially");
+#endif
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+            builder->Pages.Disabled = !feature("atlas pages", !builder->Pages.Disabled, "grow and repack into one page");
+#endif
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+            builder->Budget.Disabled = !feature("atlas budget", !builder->Budget.Disabled, "discard unused bakes when the texture is full");
+#endif
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+            builder->GlyphCache.Disabled = !feature("glyph disk cache", !builder->GlyphCache.Disabled, "rasterize every glyph");
+#endif
+#ifdef IMGUI_ENABLE_SDF_FONTS
+            builder->Sdf.Disabled = !feature("distance field fonts", !builder->Sdf.Disabled, "bake each size");
+#endif
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+            builder->ShelfPacker.Disabled = !feature("shelf packer", !builder->ShelfPacker.Disabled, "stb_rectpack, from the next repack");
+#endif
+        }
+#ifdef IMGUI_ENABLE_STB_TRUETYPE_SIMD
+        GImFontRasterizeScalar = !feature("SIMD rasterizer", !GImFontRasterizeScalar, "stb_truetype code");
+#endif
+        ImGui::EndTable();
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_GLYPH_RUN_CACHE
+    if (ImGui::CollapsingHeader("Glyph runs", ImGuiTreeNodeFlags_DefaultOpen)) {
+        plot("##glyphRunHitRate", [](const FrameStats &s, int) {
+            const uint32_t calls = s.glyphRunHits + s.glyphRunMisses;
+            return calls ? (float) s.glyphRunHits / (float) calls : 0.0f;
+        }, 0, "hit rate %.1f%% (avg %.1f, max %.1f)", 100.0f, false);
+        plot("##glyphRunBytes", [](const FrameStats &s, int) { return (float) s.glyphRunBytes; }, 0, "resident %.1f KB (avg %.1f, max %.1f)", 1.0f / 1024.0f, false);
+        ImFontAtlasBuilder *builder = ImGui::GetIO().Fonts->Builder;
+        if (builder) {
+            ImGui::Text("%u hits, %u misses, %d runs, %d clears", last.glyphRunHits, last.glyphRunMisses, builder->GlyphRuns.Runs.Size, builder->GlyphRuns.ClearCount);
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_TEXT_SIZE_CACHE
+    if (ImGui::CollapsingHeader("Text sizes", ImGuiTreeNodeFlags_DefaultOpen)) {
+        plot("##textSizeHitRate", [](const FrameStats &s, int) {
+            const uint32_t calls = s.textSizeHits + s.textSizeMisses;
+            return calls ? (float) s.textSizeHits / (float) calls : 0.0f;
+        }, 0, "hit rate %.1f%% (avg %.1f, max %.1f)", 100.0f, false);
+        plot("##textSizeBytes", [](const FrameStats &s, int) { return (float) s.textSizeBytes; }, 0, "resident %.1f KB (avg %.1f, max %.1f)", 1.0f / 1024.0f, false);
+        ImFontAtlasBuilder *builder = ImGui::GetIO().Fonts->Builder;
+        if (builder) {
+            const ImFontTextSizeCache &cache = builder->TextSizes;
+            ImGui::Text("%u hits, %u misses, %d entries, %d evicted, %d clears", last.textSizeHits, last.textSizeMisses, cache.Entries.Size, cache.EvictedCount, cache.ClearCount);
+            ImGui::Checkbox("Verify", &builder->TextSizes.Verify);
+            if (cache.Verify || cache.VerifyFailures) {
+                ImGui::SameLine();
+                ImGui::Text("%d failures", cache.VerifyFailures);
+            }
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_ASYNC_GLYPHS
+    if (ImGui::CollapsingHeader("Glyph rasterization", ImGuiTreeNodeFlags_DefaultOpen)) {
+        plot("##asyncGlyphsPending", [](const FrameStats &s, int) { return (float) s.asyncGlyphsPending; }, 0, "pending %.0f (avg %.0f, max %.0f)", 1.0f, true);
+        plot("##asyncGlyphMs", [](const FrameStats &s, int) { return s.asyncGlyphMs; }, 0, "apply %.3f ms (avg %.3f, max %.3f)", 1.0f, false);
+        ImFontAtlasBuilder *builder = ImGui::GetIO().Fonts->Builder;
+        if (builder) {
+            ImGui::Text("%u requested, %u applied, %d dropped", last.asyncGlyphRequests, last.asyncGlyphsApplied, builder->AsyncGlyphs.LastFrameDropped);
+            if (builder->AsyncGlyphs.LastBuildThreads > 0) {
+                ImGui::Text("last Build(): %d glyphs on %d threads, %.1f ms after packing", builder->AsyncGlyphs.LastBuildGlyphs, builder->AsyncGlyphs.LastBuildThreads, builder->AsyncGlyphs.LastBuildWaitMs);
+            }
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_PAGED_ATLAS
+    if (ImGui::CollapsingHeader("Font atlas", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        if (atlas->Builder && atlas->TexData) {
+            const ImTextureData *tex = atlas->TexData;
+            ImGui::Text("%dx%d, %d page(s) of %d rows, %.1f KB", tex->Width, tex->Height, tex->Height / tex->PageHeight, tex->PageHeight, (double) tex->GetSizeInBytes() / 1024.0);
+            ImGui::Text("%d pages appended, %d grow/repacks", atlas->Builder->Pages.AppendCount, atlas->Builder->Pages.RepackCount);
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_ATLAS_BUDGET
+    if (ImGui::CollapsingHeader("Atlas budget", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        if (atlas->Builder && atlas->TexData) {
+            const ImFontAtlasBudget &budget = atlas->Builder->Budget;
+            ImGui::Text("texture %.1f KB, glyphs %.1f KB, budget %.1f KB", (double) atlas->TexData->GetSizeInBytes() / 1024.0,
+                        (double) ImFontAtlasBudgetGetLiveBytes(atlas) / 1024.0, (double) ImFontAtlasBudgetGetMaxBytes(atlas) / 1024.0);
+            ImGui::Text("evicted %d bakes, %d glyphs, %d rasterized again", budget.EvictedBakes, budget.EvictedGlyphs, budget.Rerasterized);
+            ImGui::Text("%d defrag repacks, %d over budget", budget.DefragCount, budget.OverBudgetCount);
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_GLYPH_DISK_CACHE
+    if (ImGui::CollapsingHeader("Glyph cache", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        ImGui::Text("first complete frame %.1f ms after init", firstFrameMs);
+        if (atlas->Builder && atlas->GlyphCacheFilename) {
+            const ImFontGlyphCache &cache = atlas->Builder->GlyphCache;
+            ImGui::Text("%s: %d entries (%d loaded), %.1f KB", atlas->GlyphCacheFilename, cache.EntryCount, cache.LoadedCount, (double) cache.Data.Size / 1024.0);
+            ImGui::Text("%d hits, %d misses, %d saves", cache.Hits, cache.Misses, cache.SaveCount);
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_SDF_FONTS
+    if (ImGui::CollapsingHeader("Distance field fonts", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        if (atlas->Builder && atlas->TexData) {
+            const ImFontAtlasSdf &sdf = atlas->Builder->Sdf;
+            ImGui::Text("%s, %d bakes in the atlas", sdf.Enabled ? "enabled" : "disabled", atlas->Builder->BakedPool.Size);
+            ImGui::Text("%d glyphs rasterized, %.1f KB", sdf.GlyphCount, (double) sdf.GlyphSurface * atlas->TexData->BytesPerPixel / 1024.0);
+        }
+    }
+#endif
+
+#ifdef IMGUI_ENABLE_SHELF_PACKER
+    if (ImGui::CollapsingHeader("Atlas packer", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        if (atlas->Builder) {
+            const ImFontAtlasShelfPacker &packer = atlas->Builder->ShelfPacker;
+            if (packer.Active) {
+                ImGui::Text("%d shelves (%d free), %d free spans, %d free row ranges", packer.Shelves.Size, packer.ShelvesFree.Size, packer.Spans.Size - packer.SpansFree.Size, packer.Rows.Size - packer.RowsFree.Size);
+            } else {
+                ImGui::Text("stb_rectpack");
+            }
+            ImGui::Text("%d inserts, %d grow/repacks, %d shelves released", packer.InsertCount, packer.MakeSpaceCount, packer.ReleasedShelfCount);
+        }
+    }
+#endif
+
+    ImGui::TextDisabled("overlay: %.3f ms", overlayMs);
+    ImGui::End();
+}
@@ -0,0 +1,278 @@
+#include "allocator.h"
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace allocator {
+    namespace {
+        struct Pools;
+
+        // Every block starts with a header, this keeps the returned pointers 16 bytes aligned
+        struct Header {
+            Pools *owner;           // nullptr: allocated with malloc
+            uint32_t sizeClass;
+            uint32_t unused;
+        };
+        static_assert(sizeof(Header) == 16);
+
+        constexpr uint32_t sizeClassCount = 9;      // blocks of 32 .. 8192 bytes (header included)
+        constexpr size_t minBlockSize = 32;
+        constexpr size_t maxBlockSize = minBlockSize << (sizeClassCount - 1);
+        constexpr size_t chunkSize = 64 * 1024;     // pools are refilled in chunks of this size
+
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        struct Pools {
+            FreeBlock *freeLists[sizeClassCount] = {};                  // owner thread only
+            std::atomic<FreeBlock*> remoteFrees[sizeClassCount] = {};   // pushed by the other threads
+            Pools *nextOrphan = nullptr;
+        };
+
+        // Pools are never destroyed, other threads may still free blocks into them. The pools of an exited
+        // thread are reused by the next new thread.
+        std::mutex orphansMutex;
+        Pools *orphans = nullptr;
+
+        // Trivially destructible, so they can still be read after the thread_local destructors of the thread ran
+        // (late frees while it exits)
+        thread_local Pools *threadPools = nullptr;
+        thread_local bool threadExited = false;
+
+        // Orphans the pools of the thread when it exits. Another thread may adopt them right away, so from then on
+        // this thread must not touch their free lists.
+        struct ThreadExit {
+            bool armed = false;
+
+            ~ThreadExit() {
+                threadExited = true;
+                if (!threadPools) return;
+                std::lock_guard lock(orphansMutex);
+                threadPools->nextOrphan = orphans;
+                orphans = threadPools;
+                threadPools = nullptr;
+            }
+        };
+        thread_local ThreadExit threadExit;
+
+        // nullptr once the thread is exiting: its allocations go to malloc and its frees to the owners' remote lists
+        Pools *getThreadPools() {
+            if (!threadPools && !threadExited) {
+                threadExit.armed = true;    // first use constructs it, which registers its destructor
+                std::lock_guard lock(orphansMutex);
+                if (orphans) {
+                    threadPools = orphans;
+                    orphans = orphans->nextOrphan;
+                } else {
+                    threadPools = new (std::malloc(sizeof(Pools))) Pools();
+                }
+            }
+            return threadPools;
+        }
+
+        struct Counters {
+            std::atomic<uint64_t> allocations = 0;
+            std::atomic<uint64_t> frees = 0;
+            std::atomic<uint64_t> bytes = 0;
+            std::atomic<uint64_t> systemAllocations = 0;
+            std::atomic<uint64_t> remoteFrees = 0;
+            std::atomic<uint64_t> arenaBytes = 0;
+            std::atomic<uint64_t> newCalls = 0;
+
+            Stats take() {
+                return {
+                    .allocations = allocations.exchange(0, std::memory_order_relaxed),
+                    .frees = frees.exchange(0, std::memory_order_relaxed),
+                    .bytes = bytes.exchange(0, std::memory_order_relaxed),
+                    .systemAllocations = systemAllocations.exchange(0, std::memory_order_relaxed),
+                    .remoteFrees = remoteFrees.exchange(0, std::memory_order_relaxed),
+                    .arenaBytes = arenaBytes.exchange(0, std::memory_order_relaxed),
+                    .newCalls = newCalls.exchange(0, std::memory_order_relaxed),
+                };
+            }
+        };
+        Counters counters;  // current frame
+        Stats lastFrameStats;
+        Stats totalStats;   // of all the completed frames
+        std::atomic<size_t> pooled = 0;
+
+        // Overflow blocks are malloc'ed when the arena is full, they are released by beginFrame and the
+        // arena grows to fit the whole frame.
+        struct OverflowBlock {
+            OverflowBlock *next;
+            uint64_t unused;
+        };
+        static_assert(sizeof(OverflowBlock) == 16);
+
+        struct Arena {
+            char *memory = nullptr;
+            size_t capacity = 0;
+            std::atomic<size_t> offset = 0;
+            std::mutex overflowMutex;
+            OverflowBlock *overflow = nullptr;
+        };
+        Arena arena;
+
+        uint32_t sizeClassOf(size_t blockSize) {
+            return (uint32_t) std::bit_width((blockSize - 1) / minBlockSize);
+        }
+
+        bool refill(Pools *pools, uint32_t sizeClass) {
+            // blocks other threads gave back first
+            FreeBlock *&freeList = pools->freeLists[sizeClass];
+            freeList = pools->remoteFrees[sizeClass].exchange(nullptr, std::memory_order_acquire);
+            if (freeList) return true;
+
+            const size_t blockSize = minBlockSize << sizeClass;
+            auto chunk = static_cast<char*>(std::malloc(chunkSize));
+            if (!chunk) return false;
+            counters.systemAllocations.fetch_add(1, std::memory_order_relaxed);
+            pooled.fetch_add(chunkSize, std::memory_order_relaxed);
+            // pushed backwards so the blocks are handed out in address order
+            for (size_t i = chunkSize / blockSize; i-- > 0;) {
+                auto block = reinterpret_cast<FreeBlock*>(chunk + i * blockSize);
+                block->next = freeList;
+                freeList = block;
+            }
+            return true;
+        }
+    }
+
+    void *alloc(size_t size) {
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+
+        const size_t blockSize = size + sizeof(Header);
+        Pools *pools = blockSize <= maxBlockSize ? getThreadPools() : nullptr;
+        Header *header;
+        if (pools) {
+            const uint32_t sizeClass = sizeClassOf(blockSize);
+            FreeBlock *&freeList = pools->freeLists[sizeClass];
+            if (!freeList && !refill(pools, sizeClass)) return nullptr;
+            FreeBlock *block = freeList;
+            freeList = block->next;
+            header = reinterpret_cast<Header*>(block);
+            header->owner = pools;
+            header->sizeClass = sizeClass;
+        } else {
+            header = static_cast<Header*>(std::malloc(blockSize));
+            if (!header) return nullptr;
+            counters.systemAllocations.fetch_add(1, std::memory_order_relaxed);
+            header->owner = nullptr;
+        }
+        return header + 1;
+    }
+
+    void free(void *ptr) {
+        if (!ptr) return;
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+
+        Header *header = static_cast<Header*>(ptr) - 1;
+        Pools *owner = header->owner;
+        if (!owner) {
+            std::free(header);
+            return;
+        }
+        const uint32_t sizeClass = header->sizeClass;
+        auto block = reinterpret_cast<FreeBlock*>(header);
+        if (owner == threadPools) {
+            block->next = owner->freeLists[sizeClass];
+            owner->freeLists[sizeClass] = block;
+            return;
+        }
+        // lock-free push, the owner takes the whole list at once (no pop, so no ABA)
+        counters.remoteFrees.fetch_add(1, std::memory_order_relaxed);
+        std::atomic<FreeBlock*> &remote = owner->remoteFrees[sizeClass];
+        block->next = remote.load(std::memory_order_relaxed);
+        while (!remote.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    void *frameAlloc(size_t size, size_t alignment) {
+        counters.arenaBytes.fetch_add(size, std::memory_order_relaxed);
+
+        // reserve enough to align the pointer, keeps the bump a single atomic add
+        const size_t reserved = size + alignment - 1;
+        const size_t offset = arena.offset.fetch_add(reserved, std::memory_order_relaxed);
+        if (offset + reserved <= arena.capacity) {
+            const uintptr_t address = reinterpret_cast<uintptr_t>(arena.memory + offset);
+            return reinterpret_cast<void*>((address + alignment - 1) & ~(uintptr_t) (alignment - 1));
+        }
+
+        auto block = static_cast<OverflowBlock*>(std::malloc(sizeof(OverflowBlock) + reserved));
+        if (!block) return nullptr;
+        counters.systemAllocations.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(arena.overflowMutex);
+            block->next = arena.overflow;
+            arena.overflow = block;
+        }
+        const uintptr_t address = reinterpret_cast<uintptr_t>(block + 1);
+        return reinterpret_cast<void*>((address + alignment - 1) & ~(uintptr_t) (alignment - 1));
+    }
+
+    void beginFrame() {
+        lastFrameStats = counters.take();
+        totalStats.allocations += lastFrameStats.allocations;
+        totalStats.frees += lastFrameStats.frees;
+        totalStats.bytes += lastFrameStats.bytes;
+        totalStats.systemAllocations += lastFrameStats.systemAllocations;
+        totalStats.remoteFrees += lastFrameStats.remoteFrees;
+        totalStats.arenaBytes += lastFrameStats.arenaBytes;
+        totalStats.newCalls += lastFrameStats.newCalls;
+
+        // Release the arena, if the last frame didn't fit grow it for the next one
+        const size_t used = arena.offset.exchange(0, std::memory_order_relaxed);
+        while (arena.overflow) {
+            OverflowBlock *next = arena.overflow->next;
+            std::free(arena.overflow);
+            arena.overflow = next;
+        }
+        if (used > arena.capacity) {
+            std::free(arena.memory);
+            arena.capacity = std::bit_ceil(used);
+            arena.memory = static_cast<char*>(std::malloc(arena.capacity));
+            if (!arena.memory) arena.capacity = 0;
+        }
+    }
+
+    const Stats& lastFrame() {
+        return lastFrameStats;
+    }
+
+    Stats total() {
+        return {
+            .allocations = totalStats.allocations + counters.allocations.load(std::memory_order_relaxed),
+            .frees = totalStats.frees + counters.frees.load(std::memory_order_relaxed),
+            .bytes = totalStats.bytes + counters.bytes.load(std::memory_order_relaxed),
+            .systemAllocations = totalStats.systemAllocations + counters.systemAllocations.load(std::memory_order_relaxed),
+            .remoteFrees = totalStats.remoteFrees + counters.remoteFrees.load(std::memory_order_relaxed),
+            .arenaBytes = totalStats.arenaBytes + counters.arenaBytes.load(std::memory_order_relaxed),
+            .newCalls = totalStats.newCalls + counters.newCalls.load(std::memory_order_relaxed),
+        };
+    }
+
+    size_t pooledBytes() {
+        return pooled.load(std::memory_order_relaxed);
+    }
+}
+
+#ifdef MINIMAL_WGPU_ALLOC_CHECK
+// Counting replacements of the global operator new/delete, the nothrow and array versions end up here too.
+// Aligned new is left alone, it has its own allocation functions.
+static void *countedNew(size_t size) {
+    allocator::counters.newCalls.fetch_add(1, std::memory_order_relaxed);
+    void *ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new(size_t size) { return countedNew(size); }
+void *operator new[](size_t size) { return countedNew(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+#endif
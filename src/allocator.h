@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Host allocator, used by imgui (ImGui::SetAllocatorFunctions in DemoImgui::init)
+//
+// - Small blocks come from thread-local size-class pools. A block freed by another thread goes back to
+//   the pool it came from, through a lock-free list the owner drains when its free list is empty (e.g.
+//   glyph bitmaps rasterized on imgui worker threads and freed on the main thread).
+// - Pool memory is kept for the lifetime of the process, the pools of a thread that exits are taken
+//   over by the next thread that allocates. Allocations made while a thread exits (other thread_local
+//   destructors) go to malloc, its frees go back to the owners like any cross-thread free.
+// - Bigger blocks go straight to malloc.
+// - frameAlloc is a bump arena for transient data, everything in it is released by beginFrame (e.g. the
+//   rows the imgui backend repacks before a partial texture upload).
+//
+// Every call is counted, once the pools and the arena are warmed up a frame should not reach malloc
+// (Stats::systemAllocations == 0). Building with MINIMAL_WGPU_ALLOC_CHECK also replaces the global
+// operator new/delete to count them, main.cpp --alloc-check uses this to fail on per-frame allocations.
+namespace allocator {
+    struct Stats {
+        uint64_t allocations = 0;       // alloc() calls
+        uint64_t frees = 0;
+        uint64_t bytes = 0;             // requested by alloc()
+        uint64_t systemAllocations = 0; // malloc calls: big blocks, pool refills and arena overflow
+        uint64_t remoteFrees = 0;       // blocks freed by another thread than the one that allocated them
+        uint64_t arenaBytes = 0;        // frameAlloc() bytes
+        uint64_t newCalls = 0;          // global operator new calls, only counted with MINIMAL_WGPU_ALLOC_CHECK
+    };
+
+    void *alloc(size_t size);
+    void free(void *ptr);
+
+    // valid until the next beginFrame
+    void *frameAlloc(size_t size, size_t alignment = 16);
+
+    // called by the host at the beginning of each frame (main.cpp)
+    void beginFrame();
+
+    const Stats& lastFrame();       // counters of the last complete frame
+    Stats total();                  // since the start of the process
+    size_t pooledBytes();           // memory owned by the pools (all threads)
+}
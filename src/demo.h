@@ -5,6 +5,7 @@
 #include <memory>
 #include <ostream>
 #include <vector>
+#include "trace.h"
 
 #ifdef MINIMAL_WGPU_IMGUI
 #include <cstdio>
@@ -13,6 +14,7 @@
 #endif
 
 struct WGPUPlatform;
+struct Profiler; // profiler.h
 
 struct WGPU {
     WGPUTextureFormat surfaceFormat;
@@ -20,6 +22,7 @@ struct WGPU {
     uint32_t requestedDeviceIndex; // index of the requested device, represents the quality/performance tier
     WGPUQueue queue = nullptr;
     WGPUPlatform *platform = nullptr;
+    Profiler *profiler = nullptr;    // per render pass timings, see profiler.h
 };
 
 struct sapp_event; // defined in sokol_app.h
@@ -33,6 +36,7 @@ struct Demo {
 #ifdef MINIMAL_WGPU_IMGUI
     uint32_t demoImguiIndex = 0; // assigned when we add the window (addDemoWindow)
     virtual void imgui(WGPU *wgpu) {
+        TRACE_ZONE("Demo::imgui");
         char name[64];
         snprintf(name, sizeof(name), "Demo %d", demoImguiIndex);
         if (ImGui::Begin(name)) {
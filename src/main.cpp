@@ -2,6 +2,9 @@
 #include <thread>
 
 #include "demo.h"
+#include "allocator.h"
+#include "profiler.h"
+#include "trace.h"
 #include <webgpu/webgpu.h>
 
 #ifndef __EMSCRIPTEN__
@@ -43,6 +46,65 @@ void onDevice(WGPU *wgpu);
 
 std::unique_ptr<Demo> demo;
 
+// --alloc-check: runs a fixed number of frames and fails (exit code 1) if any frame after the warm-up
+// allocates through the host allocator or operator new. Needs a build with MINIMAL_WGPU_ALLOC_CHECK (counts
+// operator new) and can't be combined with --trace.
+// The process exits from the cleanup callback, sapp_run() doesn't return on every platform (macOS).
+static struct {
+    bool enabled = false;
+    uint32_t warmupFrames = 120;
+    uint32_t checkedFrames = 240;
+    uint32_t frame = 0;
+    uint32_t failedFrames = 0;
+    int exitCode = 1;   // until all the frames are checked
+} allocCheck;
+
+// Chrome trace of the CPU zones (TRACE_ZONE), F2 starts/stops the capture, also written at exit
+// Start with --trace to capture from the first frame.
+static const char *traceFile = "trace.json";
+
+void event(WGPU *wgpu, const sapp_event *e) {
+    // no capture during --alloc-check, the trace buffers allocate
+    if ((e->type == SAPP_EVENTTYPE_KEY_DOWN) && (e->key_code == SAPP_KEYCODE_F2) && !e->key_repeat && !allocCheck.enabled) {
+        if (trace::enabled()) {
+            trace::stop(traceFile);
+        } else {
+            trace::start();
+            fprintf(stderr, "Trace: capturing, press F2 again to write %s\n", traceFile);
+        }
+    }
+    demo->event(wgpu, e);
+}
+
+// called after allocator::beginFrame, checks the frame that just finished
+static void allocCheckFrame() {
+    if (!allocCheck.enabled) return;
+    const uint32_t frame = allocCheck.frame++;
+    if (frame <= allocCheck.warmupFrames) return;
+
+    const allocator::Stats &stats = allocator::lastFrame();
+    if (stats.allocations || stats.newCalls) {
+        fprintf(stderr, "alloc-check: frame %u: %llu allocations (%llu bytes), %llu operator new\n", frame - 1,
+                (unsigned long long) stats.allocations, (unsigned long long) stats.bytes, (unsigned long long) stats.newCalls);
+        allocCheck.failedFrames++;
+    }
+    if (frame == allocCheck.warmupFrames + allocCheck.checkedFrames) {
+        fprintf(stderr, "alloc-check: %s, %u of %u frames allocated\n", allocCheck.failedFrames ? "FAILED" : "OK",
+                allocCheck.failedFrames, allocCheck.checkedFrames);
+        allocCheck.exitCode = allocCheck.failedFrames ? 1 : 0;
+        sapp_quit();
+    }
+}
+
+// called at the end of cleanup, once everything is released
+static void allocCheckExit() {
+    if (!allocCheck.enabled) return;
+    if (allocCheck.frame <= allocCheck.warmupFrames + allocCheck.checkedFrames) {
+        fprintf(stderr, "alloc-check: FAILED, closed before the check finished (%u frames)\n", allocCheck.frame);
+    }
+    exit(allocCheck.exitCode);
+}
+
 #ifndef __EMSCRIPTEN__
 void init(WGPU *wgpu) {
 
@@ -117,6 +179,7 @@ void onDevice(WGPU *wgpu) {
 
     wgpu->surfaceFormat = config.viewFormats[0];
 
+    wgpu->profiler->init(wgpu);
     demo->init(wgpu);
 }
 
@@ -133,6 +196,17 @@ void requestDevice(WGPU *wgpu) {
             fprintf(stderr, "Could not find a capable device after %d tries\n", wgpu->requestedDeviceIndex+1);
             exit(-1);
     }
+    // Optional features, demos check for them with wgpuDeviceHasFeature
+    static const WGPUFeatureName optionalFeatures[] = { WGPUFeatureName_TimestampQuery };
+    static WGPUFeatureName requiredFeatures[std::size(optionalFeatures)];
+    size_t requiredFeatureCount = 0;
+    for (WGPUFeatureName feature : optionalFeatures) {
+        if (wgpuAdapterHasFeature(wgpu->platform->adapter, feature)) {
+            requiredFeatures[requiredFeatureCount++] = feature;
+        }
+    }
+    deviceDescriptor.requiredFeatureCount = requiredFeatureCount;
+    deviceDescriptor.requiredFeatures = requiredFeatures;
     deviceDescriptor.uncapturedErrorCallbackInfo.userdata1 = wgpu;
     deviceDescriptor.uncapturedErrorCallbackInfo.callback =
             [](WGPUDevice const * device, WGPUErrorType type, WGPUStringView message, WGPU_NULLABLE void* userdata1, WGPU_NULLABLE void* userdata2) {
@@ -158,14 +232,20 @@ void requestDevice(WGPU *wgpu) {
 }
 
 void cleanup(WGPU *wgpu) {
+    trace::stop(traceFile);
     demo->cleanup(wgpu);
+    wgpu->profiler->cleanup();
     wgpuDeviceRelease(wgpu->device);
     wgpuAdapterRelease(wgpu->platform->adapter);
     wgpuSurfaceRelease(wgpu->platform->surface.object);
+    allocCheckExit();
 }
 
 void frame(WGPU *wgpu) {
     if (!wgpu->queue) return; /* Wait for the queue to be created */
+    TRACE_ZONE("frame");
+    allocator::beginFrame();
+    allocCheckFrame();
 
     auto reconfigureSurface = [wgpu]() -> bool {
         const uint32_t width = sapp_width();
@@ -212,8 +292,13 @@ void frame(WGPU *wgpu) {
     WGPUTextureView frame =
             wgpuTextureCreateView(surfaceTexture.texture, NULL);
 
+    wgpu->profiler->beginFrame();
     demo->frame(wgpu, frame);
-    wgpuSurfacePresent(wgpu->platform->surface.object);
+    wgpu->profiler->endFrame();
+    {
+        TRACE_ZONE("wgpuSurfacePresent");
+        wgpuSurfacePresent(wgpu->platform->surface.object);
+    }
 
     wgpuTextureViewRelease(frame);
     wgpuTextureRelease(surfaceTexture.texture);
@@ -226,14 +311,21 @@ void init(WGPU *wgpu) {
     wgpu->device = (WGPUDevice) sapp_wgpu_get_device();
     wgpu->queue = wgpuDeviceGetQueue(wgpu->device);
     wgpu->surfaceFormat = _sapp.wgpu.render_format;
+    wgpu->profiler->init(wgpu);
     demo->init(wgpu);
 }
 
 void cleanup(WGPU *wgpu) {
+    trace::stop(traceFile);
     demo->cleanup(wgpu);
+    wgpu->profiler->cleanup();
+    allocCheckExit();
 }
 
 void frame(WGPU *wgpu) {
+    TRACE_ZONE("frame");
+    allocator::beginFrame();
+    allocCheckFrame();
     auto reconfigureSurface = [wgpu]() -> bool {
         static uint32_t width = 0;
         uint32_t newWidth = sapp_width();
@@ -251,7 +343,9 @@ void frame(WGPU *wgpu) {
     };
 
    if (reconfigureSurface()) return;
+   wgpu->profiler->beginFrame();
    demo->frame(wgpu, (WGPUTextureView)(const_cast<void*>(sapp_wgpu_get_render_view())));
+   wgpu->profiler->endFrame();
 }
 
 #endif
@@ -260,7 +354,8 @@ void frame(WGPU *wgpu) {
 // This needs to be static for EMSCRIPTEN (main doesn't work like a native app)
 namespace {
     WGPUPlatform platform = {};
-    WGPU wgpu = {.platform = &platform};
+    Profiler profiler;
+    WGPU wgpu = {.platform = &platform, .profiler = &profiler};
 }
 
 std::vector<DemoBuilder> demo_builders;
@@ -282,12 +377,28 @@ int main(int argc, char* argv[]) {
         return -1;
     }
 
+    trace::setThreadName("main");
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--trace") == 0) trace::start();
+        if (strcmp(argv[i], "--alloc-check") == 0) allocCheck.enabled = true;
+    }
+    if (allocCheck.enabled) {
+#ifndef MINIMAL_WGPU_ALLOC_CHECK
+        std::cerr << "--alloc-check needs a build with -DMINIMAL_WGPU_ALLOC_CHECK=ON" << std::endl;
+        return 1;
+#endif
+        if (trace::enabled()) {
+            std::cerr << "--alloc-check can't be combined with --trace" << std::endl;
+            return 1;
+        }
+    }
+
     sapp_desc sokolConfig = {
             .user_data = &wgpu,
             .init_userdata_cb = [](void *ptr){ init(static_cast<WGPU*>(ptr)); },
             .frame_userdata_cb = [](void *ptr){ frame(static_cast<WGPU*>(ptr)); },
             .cleanup_userdata_cb = [](void *ptr){ cleanup(static_cast<WGPU*>(ptr)); },
-            .event_userdata_cb = [](const sapp_event *e, void *ptr){ demo->event(static_cast<WGPU*>(ptr), e); },
+            .event_userdata_cb = [](const sapp_event *e, void *ptr){ event(static_cast<WGPU*>(ptr), e); },
             .width = 1024,
             .height = 768,
             .high_dpi = true,
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+struct WGPU;
+
+// Host side phases of an imgui frame (DemoImgui::frame)
+enum PerfPhase {
+    PerfPhase_NewFrame,         // ImGui_ImplWGPU_NewFrame + ImGui::NewFrame
+    PerfPhase_Demos,            // DemoImgui::imgui, includes the frame() of every demo window
+    PerfPhase_Render,           // ImGui::Render
+    PerfPhase_RenderDrawData,   // ImGui pass: ImGui_ImplWGPU_RenderDrawData + submit
+    PerfPhase_Count
+};
+
+struct FrameStats {
+    static constexpr int maxPasses = 8; // GPU pass timings, indexed like Profiler::passes()
+
+    float frameMs = 0.0f;               // time between frames (io.DeltaTime)
+    float cpuMs = 0.0f;                 // CPU time of the previous frame (Profiler "Frame")
+    float phaseMs[PerfPhase_Count] = {};
+    float gpuMs = 0.0f;                 // sum of all the passes of the frame
+    float passGpuMs[maxPasses] = {};
+    uint32_t drawCalls = 0;             // ImDrawCmd count
+    uint32_t vertices = 0;
+    uint32_t indices = 0;
+    uint64_t uploadBytes = 0;           // bytes written with wgpuQueueWrite* by the imgui backend
+    uint32_t compactVertices = 0;       // uploaded as 12 bytes vertices (ImGui_ImplWGPU_InitInfo::CompactVertices)
+    uint64_t textureUploadBytes = 0;    // part of uploadBytes written to textures
+    uint64_t textureUpdateBytes = 0;    // texture bytes requested by ImTextureData::Updates[] (or created)
+    uint32_t textureWrites = 0;         // wgpuQueueWriteTexture calls (ImGui_ImplWGPU_InitInfo::CoalesceTextureUploads)
+    // previous frame, from the host allocator (allocator.h)
+    uint32_t allocations = 0;
+    uint64_t allocationBytes = 0;
+    uint32_t systemAllocations = 0;     // allocations that reached malloc, should be 0 after warm-up
+    // previous frame, imgui glyph-run cache (IMGUI_ENABLE_GLYPH_RUN_CACHE)
+    uint32_t glyphRunHits = 0;
+    uint32_t glyphRunMisses = 0;
+    uint32_t glyphRunBytes = 0;         // resident vertices, indices and keys
+    // previous frame, imgui text size cache (IMGUI_ENABLE_TEXT_SIZE_CACHE)
+    uint32_t textSizeHits = 0;
+    uint32_t textSizeMisses = 0;
+    uint32_t textSizeBytes = 0;
+    // previous frame, imgui background glyph rasterization (IMGUI_ENABLE_ASYNC_GLYPHS)
+    uint32_t asyncGlyphRequests = 0;
+    uint32_t asyncGlyphsApplied = 0;
+    uint32_t asyncGlyphsPending = 0;
+    float asyncGlyphMs = 0.0f;          // main thread time applying them
+};
+
+// Fixed size ring with a single writer. The writer fills the next slot and then publishes it by
+// advancing `head`, readers only look at slots behind `head` so no locks are needed.
+template<class T, uint32_t N>
+struct PerfRing {
+    static_assert((N & (N - 1)) == 0, "N must be a power of two");
+
+    void push(const T &value) {
+        const uint32_t index = head.load(std::memory_order_relaxed);
+        items[index & (N - 1)] = value;
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    uint32_t size() const {
+        const uint32_t count = head.load(std::memory_order_acquire);
+        return count < N ? count : N;
+    }
+
+    // 0 is the oldest element, size()-1 the latest
+    const T& at(uint32_t i) const {
+        const uint32_t count = head.load(std::memory_order_acquire);
+        return items[(count - size() + i) & (N - 1)];
+    }
+
+    const T& latest() const { return at(size() - 1); }
+
+private:
+    std::atomic<uint32_t> head = 0;
+    T items[N] = {};
+};
+
+// Measures the time between construction and stop() (or destruction) into `ms`
+struct PerfScope {
+    explicit PerfScope(float &ms) : ms(&ms), start(std::chrono::high_resolution_clock::now()) {}
+    ~PerfScope() { stop(); }
+    void stop() {
+        if (!ms) return;
+        *ms = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        ms = nullptr;
+    }
+
+private:
+    float *ms;
+    std::chrono::high_resolution_clock::time_point start;
+};
+
+// Window with the rolling frame stats, toggled with F1 or from the "Demos" window
+struct PerfOverlay {
+    static constexpr uint32_t historySize = 256;
+
+    void record(const FrameStats &stats) { history.push(stats); }
+    void imgui(WGPU*);
+
+    bool open = false;
+    float firstFrameMs = 0.0f; // from DemoImgui::init to the first frame without glyphs left to rasterize
+
+private:
+    PerfRing<FrameStats, historySize> history;
+    float overlayMs = 0.0f; // cost of drawing the overlay itself (previous frame)
+};
@@ -0,0 +1,220 @@
+#include "profiler.h"
+#include "demo.h"
+#include <cstring>
+
+#ifndef __EMSCRIPTEN__
+#include "wgpu.h"
+#define WGPU_C_STR(value) { value, WGPU_STRLEN }
+#else
+#define WGPU_C_STR(value) value
+#endif
+
+using Clock = std::chrono::high_resolution_clock;
+
+static float elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+
+#ifndef __EMSCRIPTEN__
+static std::string_view toStringView(WGPUStringView label) {
+    if (!label.data) return {};
+    return {label.data, (label.length == WGPU_STRLEN) ? strlen(label.data) : label.length};
+}
+#else
+static std::string_view toStringView(const char *label) {
+    return label ? std::string_view(label) : std::string_view();
+}
+#endif
+
+void Profiler::init(WGPU *wgpu) {
+    device = wgpu->device;
+    queue = wgpu->queue;
+    timings.reserve(16);
+    openPasses.reserve(8);
+    framePassLabels.reserve(maxQueries / 2);
+
+    if (!wgpuDeviceHasFeature(device, WGPUFeatureName_TimestampQuery)) {
+        std::cerr << "Profiler: timestamp queries not supported, only CPU timings available" << std::endl;
+        return;
+    }
+
+    const WGPUQuerySetDescriptor querySetDescriptor = {
+        .nextInChain = nullptr,
+        .label = WGPU_C_STR("Profiler Timestamps"),
+        .type = WGPUQueryType_Timestamp,
+        .count = maxQueries,
+    };
+    querySet = wgpuDeviceCreateQuerySet(device, &querySetDescriptor);
+
+    const WGPUBufferDescriptor resolveDescriptor = {
+        .nextInChain = nullptr,
+        .label = WGPU_C_STR("Profiler Resolve"),
+        .usage = WGPUBufferUsage_QueryResolve | WGPUBufferUsage_CopySrc,
+        .size = maxQueries * sizeof(uint64_t),
+        .mappedAtCreation = false,
+    };
+    resolveBuffer = wgpuDeviceCreateBuffer(device, &resolveDescriptor);
+
+    for (Readback &readback : readbacks) {
+        const WGPUBufferDescriptor readbackDescriptor = {
+            .nextInChain = nullptr,
+            .label = WGPU_C_STR("Profiler Readback"),
+            .usage = WGPUBufferUsage_MapRead | WGPUBufferUsage_CopyDst,
+            .size = maxQueries * sizeof(uint64_t),
+            .mappedAtCreation = false,
+        };
+        readback.profiler = this;
+        readback.buffer = wgpuDeviceCreateBuffer(device, &readbackDescriptor);
+        readback.passLabels.reserve(maxQueries / 2);
+    }
+}
+
+void Profiler::cleanup() {
+    if (!querySet) return;
+    for (Readback &readback : readbacks) {
+        wgpuBufferRelease(readback.buffer);
+        readback.buffer = {};
+    }
+    wgpuBufferRelease(resolveBuffer);
+    wgpuQuerySetRelease(querySet);
+    resolveBuffer = {};
+    querySet = {};
+}
+
+int Profiler::labelIndex(std::string_view label) {
+    if (label.empty()) label = "(unlabeled)";
+    for (size_t i = 0; i < timings.size(); ++i) {
+        if (timings[i].label == label) return (int) i;
+    }
+    timings.push_back({.label = std::string(label)});
+    return (int) timings.size() - 1;
+}
+
+const Profiler::PassTiming* Profiler::find(std::string_view label) const {
+    for (const PassTiming &timing : timings) {
+        if (timing.label == label) return &timing;
+    }
+    return nullptr;
+}
+
+void Profiler::beginFrame() {
+#ifndef __EMSCRIPTEN__
+    // wgpu-native only fires the buffer map callbacks when polled
+    if (querySet) {
+        wgpuDevicePoll(device, false, nullptr);
+    }
+#endif
+    frameStart = Clock::now();
+    queryCount = 0;
+    framePassLabels.clear();
+}
+
+WGPURenderPassEncoder Profiler::beginRenderPass(WGPUCommandEncoder encoder, const WGPURenderPassDescriptor *descriptor) {
+    const int label = labelIndex(toStringView(descriptor->label));
+
+    WGPURenderPassDescriptor timedDescriptor = *descriptor;
+    PassTimestampWrites timestampWrites = {};
+    // Only when the readback buffer of this frame is free, and the pass doesn't write its own timestamps
+    const bool timestamps = querySet && !descriptor->timestampWrites &&
+        !readbacks[currentReadback].pending && (queryCount + 2 <= maxQueries);
+    if (timestamps) {
+        timestampWrites.querySet = querySet;
+        timestampWrites.beginningOfPassWriteIndex = queryCount;
+        timestampWrites.endOfPassWriteIndex = queryCount + 1;
+        timedDescriptor.timestampWrites = &timestampWrites;
+        queryCount += 2;
+        framePassLabels.push_back(label);
+    }
+
+    WGPURenderPassEncoder pass = wgpuCommandEncoderBeginRenderPass(encoder, &timedDescriptor);
+    openPasses.push_back({pass, label, Clock::now()});
+    return pass;
+}
+
+void Profiler::endRenderPass(WGPURenderPassEncoder pass) {
+    wgpuRenderPassEncoderEnd(pass);
+    for (size_t i = 0; i < openPasses.size(); ++i) {
+        if (openPasses[i].encoder != pass) continue;
+        PassTiming &timing = timings[openPasses[i].label];
+        timing.cpuAccumMs += elapsedMs(openPasses[i].start);
+        timing.countAccum++;
+        openPasses.erase(openPasses.begin() + i);
+        break;
+    }
+}
+
+void Profiler::endFrame() {
+    frameTiming.cpuMs = elapsedMs(frameStart);
+    frameTiming.count = 0;
+    for (PassTiming &timing : timings) {
+        timing.cpuMs = timing.cpuAccumMs;
+        timing.count = timing.countAccum;
+        timing.cpuAccumMs = 0.0f;
+        timing.countAccum = 0;
+        frameTiming.count += timing.count;
+    }
+
+    if (queryCount == 0) return;
+
+    // Resolve all the queries of the frame, and copy them into this frame's readback buffer
+    Readback &readback = readbacks[currentReadback];
+    WGPUCommandEncoderDescriptor commandEncoderDescriptor = {.label = WGPU_C_STR("Profiler Resolve")};
+    WGPUCommandEncoder commandEncoder = wgpuDeviceCreateCommandEncoder(device, &commandEncoderDescriptor);
+    wgpuCommandEncoderResolveQuerySet(commandEncoder, querySet, 0, queryCount, resolveBuffer, 0);
+    wgpuCommandEncoderCopyBufferToBuffer(commandEncoder, resolveBuffer, 0, readback.buffer, 0, queryCount * sizeof(uint64_t));
+    WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(commandEncoder, nullptr);
+    wgpuQueueSubmit(queue, 1, &commandBuffer);
+    wgpuCommandBufferRelease(commandBuffer);
+    wgpuCommandEncoderRelease(commandEncoder);
+
+    readback.queryCount = queryCount;
+    readback.passLabels.swap(framePassLabels);
+    mapReadback(readback);
+    currentReadback = (currentReadback + 1) % readbackCount;
+}
+
+void Profiler::mapReadback(Readback &readback) {
+    readback.pending = true;
+    const size_t size = readback.queryCount * sizeof(uint64_t);
+#ifdef __EMSCRIPTEN__
+    wgpuBufferMapAsync(readback.buffer, WGPUMapMode_Read, 0, size, [](WGPUBufferMapAsyncStatus status, void *userdata) {
+        auto readback = static_cast<Readback*>(userdata);
+        readback->profiler->readbackDone(*readback, status == WGPUBufferMapAsyncStatus_Success);
+    }, &readback);
+#else
+    WGPUBufferMapCallbackInfo callback = {};
+    callback.mode = WGPUCallbackMode_AllowProcessEvents;
+    callback.userdata1 = &readback;
+    callback.callback = [](WGPUMapAsyncStatus status, WGPUStringView, void *userdata1, void *) {
+        auto readback = static_cast<Readback*>(userdata1);
+        readback->profiler->readbackDone(*readback, status == WGPUMapAsyncStatus_Success);
+    };
+    wgpuBufferMapAsync(readback.buffer, WGPUMapMode_Read, 0, size, callback);
+#endif
+}
+
+void Profiler::readbackDone(Readback &readback, bool success) {
+    readback.pending = false;
+    if (!success || !readback.buffer) return;
+
+    const size_t size = readback.queryCount * sizeof(uint64_t);
+    auto ticks = static_cast<const uint64_t*>(wgpuBufferGetConstMappedRange(readback.buffer, 0, size));
+    if (!ticks) {
+        // still unmapped, or the next map of this buffer fails
+        wgpuBufferUnmap(readback.buffer);
+        return;
+    }
+    for (PassTiming &timing : timings) {
+        timing.gpuMs = 0.0f;
+    }
+    frameTiming.gpuMs = 0.0f;
+    for (size_t i = 0; i < readback.passLabels.size(); ++i) {
+        const uint64_t begin = ticks[i * 2];
+        const uint64_t end = ticks[i * 2 + 1];
+        // timestamps are in nanoseconds
+        const float ms = (end > begin) ? (float) (end - begin) * 1e-6f : 0.0f;
+        timings[readback.passLabels[i]].gpuMs += ms;
+        frameTiming.gpuMs += ms;
+    }
+    wgpuBufferUnmap(readback.buffer);
+}
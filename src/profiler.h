@@ -0,0 +1,81 @@
+#pragma once
+
+#include <webgpu/webgpu.h>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+struct WGPU;
+
+// webgpu.h renamed WGPURenderPassTimestampWrites to WGPUPassTimestampWrites, use whatever the descriptor expects
+using PassTimestampWrites = std::remove_cv_t<std::remove_pointer_t<decltype(WGPURenderPassDescriptor::timestampWrites)>>;
+
+// Per render pass timings, grouped by the label of the pass ("Main Pass", "ImGui Pass", ...)
+//
+// Passes have to be started/ended with beginRenderPass/endRenderPass instead of the wgpu functions, this
+// injects begin/end timestamp writes into every pass, the queries are resolved at the end of the frame and
+// read back asynchronously (results arrive a couple of frames later).
+// If the device doesn't have WGPUFeatureName_TimestampQuery only the CPU timings are available.
+struct Profiler {
+    struct PassTiming {
+        std::string label;
+        float gpuMs = 0.0f;     // GPU time of all the passes with this label (0 without timestamp queries)
+        float cpuMs = 0.0f;     // CPU time spent between beginRenderPass/endRenderPass
+        uint32_t count = 0;     // number of passes with this label in the last frame
+        float cpuAccumMs = 0.0f;
+        uint32_t countAccum = 0;
+    };
+
+    void init(WGPU*);
+    void cleanup();
+
+    // Called by the host around each frame (main.cpp)
+    void beginFrame();
+    void endFrame();
+
+    WGPURenderPassEncoder beginRenderPass(WGPUCommandEncoder, const WGPURenderPassDescriptor*);
+    void endRenderPass(WGPURenderPassEncoder);
+
+    bool hasGpuTimestamps() const { return querySet != nullptr; }
+    const std::vector<PassTiming>& passes() const { return timings; }
+    const PassTiming* find(std::string_view label) const;
+    // whole frame: CPU time between beginFrame/endFrame, GPU time is the sum of all passes
+    const PassTiming& frame() const { return frameTiming; }
+
+private:
+    static constexpr uint32_t maxQueries = 64;  // per frame, two per pass
+    static constexpr uint32_t readbackCount = 3;
+
+    struct Readback {
+        Profiler *profiler = nullptr;
+        WGPUBuffer buffer = {};
+        bool pending = false;           // waiting for the map callback
+        uint32_t queryCount = 0;
+        std::vector<int> passLabels;    // label of each pass, queries 2*i and 2*i+1
+    };
+
+    struct OpenPass {
+        WGPURenderPassEncoder encoder;
+        int label;
+        std::chrono::high_resolution_clock::time_point start;
+    };
+
+    int labelIndex(std::string_view label);
+    void mapReadback(Readback&);
+    void readbackDone(Readback&, bool success);
+
+    WGPUDevice device = {};
+    WGPUQueue queue = {};
+    WGPUQuerySet querySet = {};
+    WGPUBuffer resolveBuffer = {};
+    Readback readbacks[readbackCount];
+    uint32_t currentReadback = 0;
+    uint32_t queryCount = 0;
+    std::vector<int> framePassLabels;
+    std::vector<OpenPass> openPasses;
+    std::vector<PassTiming> timings;
+    PassTiming frameTiming = {.label = "Frame"};
+    std::chrono::high_resolution_clock::time_point frameStart;
+};
@@ -0,0 +1,122 @@
+#include "trace.h"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace trace {
+    std::atomic<bool> capturing = false;
+
+    namespace {
+        constexpr size_t maxEventsPerThread = 1 << 20; // ~24MB per thread, newer events are dropped
+
+        struct Event {
+            const char *name;
+            int64_t begin; // ns, steady_clock
+            int64_t end;
+        };
+
+        struct ThreadBuffer {
+            std::mutex mutex; // only contended while exporting
+            std::vector<Event> events;
+            std::string name;
+            uint32_t id = 0;
+            size_t dropped = 0;
+        };
+
+        std::mutex registryMutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> registry; // buffers outlive their threads
+        std::chrono::steady_clock::time_point captureStart;
+
+        ThreadBuffer& threadBuffer() {
+            thread_local ThreadBuffer *buffer = nullptr;
+            if (!buffer) {
+                std::lock_guard lock(registryMutex);
+                registry.push_back(std::make_unique<ThreadBuffer>());
+                buffer = registry.back().get();
+                buffer->id = (uint32_t) registry.size();
+                buffer->name = "thread " + std::to_string(buffer->id);
+            }
+            return *buffer;
+        }
+
+        int64_t toNs(std::chrono::steady_clock::time_point t) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        }
+
+        // Names are string literals from our own code, only escape what would break the JSON
+        void writeEscaped(FILE *file, const char *text) {
+            for (const char *c = text; *c; ++c) {
+                if (*c == '"' || *c == '\\') fputc('\\', file);
+                fputc(*c, file);
+            }
+        }
+    }
+
+    void start() {
+        std::lock_guard lock(registryMutex);
+        for (auto &buffer : registry) {
+            std::lock_guard bufferLock(buffer->mutex);
+            buffer->events.clear();
+            buffer->dropped = 0;
+        }
+        captureStart = std::chrono::steady_clock::now();
+        capturing.store(true, std::memory_order_relaxed);
+    }
+
+    bool stop(const char *path) {
+        if (!capturing.exchange(false)) return false;
+
+        FILE *file = fopen(path, "w");
+        if (!file) {
+            fprintf(stderr, "Trace: could not write %s\n", path);
+            return false;
+        }
+
+        std::lock_guard lock(registryMutex);
+        const int64_t origin = toNs(captureStart);
+        size_t eventCount = 0;
+        bool first = true;
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        for (auto &buffer : registry) {
+            std::lock_guard bufferLock(buffer->mutex);
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", first ? "" : ",\n", buffer->id);
+            writeEscaped(file, buffer->name.c_str());
+            fprintf(file, "\"}}");
+            first = false;
+            for (const Event &event : buffer->events) {
+                // complete events, timestamps in microseconds
+                fprintf(file, ",\n{\"name\":\"");
+                writeEscaped(file, event.name);
+                fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                        buffer->id, (double) (event.begin - origin) * 1e-3, (double) (event.end - event.begin) * 1e-3);
+            }
+            eventCount += buffer->events.size();
+            if (buffer->dropped) {
+                fprintf(stderr, "Trace: %s dropped %zu events\n", buffer->name.c_str(), buffer->dropped);
+            }
+            buffer->events.clear();
+        }
+        fprintf(file, "\n]}\n");
+        fclose(file);
+        fprintf(stderr, "Trace: %zu events written to %s\n", eventCount, path);
+        return true;
+    }
+
+    void setThreadName(const char *name) {
+        ThreadBuffer &buffer = threadBuffer();
+        std::lock_guard lock(buffer.mutex);
+        buffer.name = name;
+    }
+
+    void record(const char *name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) {
+        ThreadBuffer &buffer = threadBuffer();
+        std::lock_guard lock(buffer.mutex);
+        if (buffer.events.size() >= maxEventsPerThread) {
+            buffer.dropped++;
+            return;
+        }
+        buffer.events.push_back({name, toNs(begin), toNs(end)});
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Scoped CPU zones, exported as Chrome Trace Event JSON (load it in chrome://tracing or ui.perfetto.dev)
+//
+//     void Demo::frame(...) {
+//         TRACE_ZONE("Demo::frame");
+//         ...
+//     }
+//
+// Zones are recorded into a thread-local buffer only while a capture is running, otherwise each zone
+// costs a single branch on a relaxed atomic load. Define MINIMAL_WGPU_NO_TRACE to compile them out.
+namespace trace {
+    extern std::atomic<bool> capturing;
+
+    inline bool enabled() { return capturing.load(std::memory_order_relaxed); }
+
+    void start();                       // discards the previous events
+    bool stop(const char *path);        // writes the captured events to path (JSON)
+    void setThreadName(const char *name);
+
+    // name must outlive the capture (string literals)
+    void record(const char *name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+
+    struct Zone {
+        explicit Zone(const char *name) : name(enabled() ? name : nullptr) {
+            if (this->name) begin = std::chrono::steady_clock::now();
+        }
+        ~Zone() {
+            if (name) record(name, begin, std::chrono::steady_clock::now());
+        }
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+
+    private:
+        const char *name;
+        std::chrono::steady_clock::time_point begin;
+    };
+}
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#ifndef MINIMAL_WGPU_NO_TRACE
+#define TRACE_ZONE(name) trace::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#else
+#define TRACE_ZONE(name) do {} while (false)
+#endif